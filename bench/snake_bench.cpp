@@ -0,0 +1,666 @@
+// 마이크로벤치마크 모음 (snake_bench)
+// 맵 생성, 스테이지 재시작, 틱 진행, 충돌 검사, 아이템 / 게이트 배치, 보드 렌더링, 스크립트 게임, 아레나 틱을 측정하고
+// 결과를 JSON으로 저장하거나 저장된 기준 결과와 비교한다. 전역 operator new를 바꿔 op당 힙 할당 수도 함께 센다.
+#include "simulation.h"
+#include "headless.h"
+#include "arena.h"
+#include "board_renderer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <ncurses.h>
+
+using namespace std;
+
+// 프로세스 전체의 힙 할당 횟수 (아래 operator new에서 증가)
+static atomic<long> allocationCount(0);
+
+void* operator new(size_t size)
+{
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    free(p);
+}
+
+namespace {
+
+struct BenchResult {
+    string name;
+    double nsPerOp = 0;
+    double allocsPerOp = 0;
+    long iterations = 0;
+};
+
+struct BenchOptions {
+    string command;      // 실행 명령줄 (JSON에 함께 기록)
+    string filter;
+    string jsonPath;
+    string comparePath;
+    double thresholdPercent = 10.0;
+    double minSeconds = 0.2;
+    bool listOnly = false;
+};
+
+// 최적화를 막기 위한 결과 누적
+volatile long benchSink = 0;
+
+class BenchRunner
+{
+public:
+    explicit BenchRunner(const BenchOptions& options) : options(options) {}
+
+    bool enabled(const string& name) const {
+        return options.filter.empty() || name.find(options.filter) != string::npos;
+    }
+
+    // body를 여러 번 묶어 실행해 ns/op 중앙값을 기록 (5회 반복 중 중앙값)
+    template <typename Body>
+    void run(const string& name, Body body) {
+        if (!enabled(name)) return;
+        if (options.listOnly) {
+            cout << name << "\n";
+            return;
+        }
+        const int kSamples = 5;
+        double batchSeconds = options.minSeconds / kSamples;
+
+        // 배치 크기 보정: 한 배치가 batchSeconds 이상 걸릴 때까지 두 배씩 늘림
+        long batch = 1;
+        while (true) {
+            double elapsed = timeBatch(body, batch);
+            if (elapsed >= batchSeconds || batch >= (1L << 30)) break;
+            long scaled = elapsed > 0 ? static_cast<long>(batch * batchSeconds / elapsed * 1.2) : batch * 10;
+            batch = max(batch * 2, min(scaled, batch * 100));
+        }
+
+        // 할당 수는 보정 단계(준비 실행) 이후의 측정 배치에서만 셈
+        vector<double> samples;
+        samples.reserve(kSamples);
+        long allocationsBefore = allocationCount.load(memory_order_relaxed);
+        for (int i = 0; i < kSamples; ++i) {
+            samples.push_back(timeBatch(body, batch) * 1e9 / batch);
+        }
+        long allocations = allocationCount.load(memory_order_relaxed) - allocationsBefore;
+        sort(samples.begin(), samples.end());
+
+        BenchResult result;
+        result.name = name;
+        result.nsPerOp = samples[kSamples / 2];
+        result.iterations = batch * kSamples;
+        result.allocsPerOp = static_cast<double>(allocations) / result.iterations;
+        results.push_back(result);
+        printf("%-40s %14.1f ns/op %10.2f allocs/op %12ld iters\n", name.c_str(), result.nsPerOp,
+               result.allocsPerOp, result.iterations);
+        fflush(stdout);
+    }
+
+    const vector<BenchResult>& getResults() const { return results; }
+
+private:
+    const BenchOptions& options;
+    vector<BenchResult> results;
+
+    template <typename Body>
+    static double timeBatch(Body& body, long count) {
+        auto begin = chrono::steady_clock::now();
+        for (long i = 0; i < count; ++i) body();
+        return chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+    }
+};
+
+// ---- 시나리오 준비 -------------------------------------------------------
+
+// 21x41 기본 맵 내부(2..19행, 2..40열)를 한 바퀴 도는 해밀턴 순환 경로 (702칸)
+// 2행을 오른쪽으로 → 3..19행 지그재그 → 2열을 따라 위로 복귀
+vector<Coord> buildCyclePath()
+{
+    vector<Coord> path;
+    for (int col = 2; col <= 40; ++col) path.push_back({2, col});
+    for (int row = 3; row <= 19; ++row) {
+        if ((row - 3) % 2 == 0) {
+            for (int col = 40; col >= 3; --col) path.push_back({row, col});
+        } else {
+            for (int col = 3; col <= 40; ++col) path.push_back({row, col});
+        }
+    }
+    for (int row = 19; row >= 3; --row) path.push_back({row, 2});
+    return path;
+}
+
+int directionTo(const Coord& from, const Coord& to)
+{
+    if (to.row < from.row) return 1;
+    if (to.col < from.col) return 2;
+    if (to.col > from.col) return 3;
+    return 4;
+}
+
+// 순환 경로 위에 몸통 length칸짜리 스네이크를 놓은 1스테이지 상태
+SimulationState cycleState(const vector<Coord>& path, int length, uint64_t seed)
+{
+    Simulation sim(seed);
+    SimulationState state;
+    sim.saveState(state);
+    size_t headIndex = static_cast<size_t>(length);
+    state.head = path[headIndex];
+    state.direction = directionTo(path[headIndex - 1], path[headIndex]);
+    state.body.clear();
+    for (int i = 1; i <= length; ++i) {
+        state.body.push_back(path[headIndex - static_cast<size_t>(i)]);
+    }
+    return state;
+}
+
+// 순환 경로를 따라가는 스크립트 입력기 (몸통이 경로를 따라오므로 충돌하지 않음)
+class CycleDriver
+{
+public:
+    CycleDriver(const vector<Coord>& path, int rows, int cols)
+        : path(path), cols(cols), order(static_cast<size_t>(rows) * cols, -1) {
+        for (size_t i = 0; i < path.size(); ++i) {
+            order[static_cast<size_t>(path[i].row) * cols + path[i].col] = static_cast<int>(i);
+        }
+    }
+
+    int nextDirection(const Simulation& sim) const {
+        const Coord& head = sim.getMap().snakeHeadObject.coord;
+        int index = order[static_cast<size_t>(head.row) * cols + head.col];
+        if (index < 0) return 0;
+        return directionTo(head, path[(static_cast<size_t>(index) + 1) % path.size()]);
+    }
+
+private:
+    const vector<Coord>& path;
+    int cols;
+    vector<int> order;
+};
+
+// 내부 셀을 free개만 남기고 전부 몸통으로 덮은 상태 (몸통 연결성은 검사 대상이 아님)
+SimulationState nearlyFullState(int freeCells, uint64_t seed)
+{
+    Simulation sim(seed);
+    SimulationState state;
+    sim.saveState(state);
+    vector<Coord> cells;
+    for (int row = 2; row <= state.mapHeight - 1; ++row) {
+        for (int col = 2; col <= state.mapWidth - 1; ++col) {
+            if (!(Coord{row, col} == state.head)) cells.push_back({row, col});
+        }
+    }
+    // 고정된 간격으로 빈 칸을 남겨 추출 위치가 한쪽에 몰리지 않게 함
+    size_t stride = cells.size() / static_cast<size_t>(freeCells);
+    state.body.clear();
+    for (size_t i = 0; i < cells.size(); ++i) {
+        if (i % stride == 0 && static_cast<int>(i / stride) < freeCells) continue;
+        state.body.push_back(cells[i]);
+    }
+    return state;
+}
+
+// ---- 벤치마크 ------------------------------------------------------------
+
+void benchMapConstruction(BenchRunner& runner)
+{
+    const struct { const char* name; MapType type; int stage; } maps[] = {
+        {"basic", MapType::BASIC, 1},
+        {"maze", MapType::MAZE, 2},
+        {"islands", MapType::ISLANDS, 3},
+        {"cross", MapType::CROSS, 4},
+        {"procedural", MapType::PROCEDURAL, 1},   // 시드 0, 기본 밀도 (생성 + 연결 보정 포함)
+    };
+    for (const auto& entry : maps) {
+        MapType type = entry.type;
+        int stage = entry.stage;
+        runner.run(string("map_construct/") + entry.name, [=]() {
+            Map map(21, 41, 0, type, stage);
+            benchSink += static_cast<long>(map.freeCellCount());
+        });
+    }
+}
+
+// 같은 시뮬레이션에서 현재 스테이지를 반복해서 다시 시작 (맵 저장 공간을 재사용하므로 준비 이후 allocs/op = 0)
+void benchStageReset(BenchRunner& runner)
+{
+    const char* names[] = {"basic", "maze", "islands", "cross"};
+    for (int stage = 1; stage <= Simulation::kFinalStage; ++stage) {
+        string name = string("stage_reset/") + names[stage - 1];
+        if (!runner.enabled(name)) continue;
+        Simulation sim(1);
+        sim.jumpToStage(stage);
+        runner.run(name, [&]() {
+            sim.resetCurrentStage();
+            benchSink += static_cast<long>(sim.getMap().freeCellCount());
+        });
+    }
+    if (runner.enabled("stage_reset/grow_basic")) {
+        // 스테이지 원본 복사로 다시 시작한 뒤 몸통을 초기 버퍼(64칸)보다 길게 늘림
+        // (첫 성장에서 늘린 몸통 버퍼를 다시 시작해도 유지하므로 준비 이후 allocs/op = 0)
+        const int kGrownLength = 200;
+        Map map(21, 41, 0, MapType::BASIC, 1);
+        runner.run("stage_reset/grow_basic", [&]() {
+            map.reset(21, 41, MapType::BASIC, 1);
+            for (int i = 0; i < kGrownLength; ++i) map.appendSnakeBody({2 + i / 38, 2 + i % 38});
+            benchSink += static_cast<long>(map.snakeHeadObject.snakeBodySegments.size());
+        });
+    }
+    if (runner.enabled("stage_reset/procedural")) {
+        // 스테이지마다 시드가 바뀌어 벽 수가 달라짐 (벽 목록이 가장 큰 배치만큼 자란 뒤로는 할당 없음)
+        Simulation sim(1);
+        sim.setProceduralStages(Map::kDefaultWallDensity);
+        runner.run("stage_reset/procedural", [&]() {
+            sim.resetCurrentStage();
+            benchSink += static_cast<long>(sim.getMap().freeCellCount());
+        });
+    }
+    if (runner.enabled("stage_reset/maze_512")) {
+        // 표가 없는 크기: 벽 생성 + 격자 / 빈 칸 / 게이트 후보 계산을 제자리에서 다시 수행
+        Simulation sim(1, 512, 512);
+        sim.jumpToStage(2);
+        runner.run("stage_reset/maze_512", [&]() {
+            sim.resetCurrentStage();
+            benchSink += static_cast<long>(sim.getMap().freeCellCount());
+        });
+    }
+}
+
+void benchTick(BenchRunner& runner, const vector<Coord>& path)
+{
+    // 아이템을 먹으면 길이가 변하므로 일정 틱마다 시작 상태로 되돌림 (복원 비용 포함)
+    const int kTicksPerRestore = 256;
+    for (int length : {3, 50, 200, 600}) {
+        string name = "tick/len" + to_string(length);
+        if (!runner.enabled(name)) continue;
+        SimulationState start = cycleState(path, length, 1);
+        Simulation sim(1);
+        sim.loadState(start);
+        CycleDriver driver(path, start.mapHeight + 2, start.mapWidth + 2);
+        int ticks = 0;
+        runner.run(name, [&]() {
+            sim.applyDirection(driver.nextDirection(sim));
+            StepStatus status = sim.tick();
+            if (status != StepStatus::RUNNING || ++ticks == kTicksPerRestore) {
+                sim.loadState(start);
+                ticks = 0;
+            }
+        });
+    }
+}
+
+void benchIsValid(BenchRunner& runner, const vector<Coord>& path)
+{
+    for (int length : {3, 600}) {
+        string name = "is_valid/len" + to_string(length);
+        if (!runner.enabled(name)) continue;
+        Simulation sim(1);
+        sim.loadState(cycleState(path, length, 1));
+        runner.run(name, [&]() {
+            benchSink += sim.isValid(0);
+        });
+    }
+}
+
+void benchRandCoord(BenchRunner& runner)
+{
+    for (int freeCells : {700, 32, 4}) {
+        string name = "generate_rand_coord/free" + to_string(freeCells);
+        if (!runner.enabled(name)) continue;
+        Simulation sim(1);
+        sim.loadState(nearlyFullState(freeCells, 1));
+        runner.run(name, [&]() {
+            int row = 0, col = 0;
+            benchSink += sim.generateRandCoord(row, col) ? row + col : 0;
+        });
+    }
+}
+
+void benchGenerateGate(BenchRunner& runner)
+{
+    const char* names[] = {"basic", "maze", "islands", "cross"};
+    for (int stage = 1; stage <= Simulation::kFinalStage; ++stage) {
+        string name = string("generate_gate/") + names[stage - 1];
+        if (!runner.enabled(name)) continue;
+        Simulation sim(1);
+        sim.jumpToStage(stage);
+        runner.run(name, [&]() {
+            sim.generateGate();
+            benchSink += sim.getMap().gameGates[0].coord.row;
+        });
+    }
+}
+
+// /dev/null에 연결한 curses 터미널에 보드를 그림 (doupdate까지 포함)
+void benchDrawBoard(BenchRunner& runner, const vector<Coord>& path)
+{
+    if (!runner.enabled("draw_board/")) return;
+    FILE* out = fopen("/dev/null", "w");
+    FILE* in = fopen("/dev/null", "r");
+    if (!out || !in) {
+        cerr << "draw_board: cannot open /dev/null, skipped\n";
+        if (out) fclose(out);
+        if (in) fclose(in);
+        return;
+    }
+    const char* term = getenv("TERM");
+    SCREEN* screen = newterm(term && *term && string(term) != "dumb" ? term : "xterm", out, in);
+    if (!screen) {
+        cerr << "draw_board: newterm failed, skipped\n";
+        fclose(out);
+        fclose(in);
+        return;
+    }
+    set_term(screen);
+    resizeterm(40, 120);
+    if (has_colors()) start_color();
+
+    SimulationState start = cycleState(path, 200, 1);
+    Simulation sim(1);
+    sim.loadState(start);
+    WINDOW* board = newwin(start.mapHeight + 2, start.mapWidth + 2, 0, 0);
+    BoardRenderer renderer;
+
+    runner.run("draw_board/full", [&]() {
+        renderer.invalidate();
+        benchSink += renderer.draw(board, sim);
+        wnoutrefresh(board);
+        doupdate();
+    });
+
+    // 틱 + 증분 렌더링 (틱 비용은 tick/len200 참고)
+    CycleDriver driver(path, start.mapHeight + 2, start.mapWidth + 2);
+    int ticks = 0;
+    runner.run("draw_board/tick_incremental", [&]() {
+        sim.applyDirection(driver.nextDirection(sim));
+        if (sim.tick() != StepStatus::RUNNING || ++ticks == 256) {
+            sim.loadState(start);
+            renderer.invalidate();
+            ticks = 0;
+        }
+        benchSink += renderer.draw(board, sim);
+        wnoutrefresh(board);
+        doupdate();
+    });
+
+    // 8192x8192 보드를 80x24 터미널 크기의 뷰포트로 (그리기 비용이 창 크기에만 비례하는지 확인)
+    Simulation large(1, 8192, 8192);
+    WINDOW* viewport = newwin(24, 52, 0, 0);
+    BoardRenderer viewportRenderer;
+    runner.run("draw_board/viewport_8192", [&]() {
+        large.applyDirection(greedyDirection(large));
+        if (large.tick() != StepStatus::RUNNING) {
+            large.resetCurrentStage();
+        }
+        benchSink += viewportRenderer.draw(viewport, large);
+        wnoutrefresh(viewport);
+        doupdate();
+    });
+
+    delwin(viewport);
+    delwin(board);
+    endwin();
+    delscreen(screen);
+    fclose(out);
+    fclose(in);
+}
+
+// 기본 봇으로 한 게임 전체를 진행 (1 op = 게임 1회, 최대 5000틱)
+void benchScriptedGames(BenchRunner& runner)
+{
+    for (uint64_t seed : {1ULL, 2ULL, 3ULL}) {
+        string name = "scripted_game/seed" + to_string(seed);
+        if (!runner.enabled(name)) continue;
+        HeadlessOptions options;
+        options.maxTicksPerGame = 5000;
+        runner.run(name, [&]() {
+            Simulation sim(seed);
+            HeadlessStats stats;
+            runHeadlessGame(sim, options, stats);
+            benchSink += stats.ticks;
+        });
+    }
+}
+
+// 아레나 한 틱 (기본 봇 행동 계산 + 동시 이동 / 충돌 판정, 1 op = 모든 스네이크 1틱)
+// 스네이크당 칸 수를 같게 두고 스네이크 수를 늘리므로 ns/op가 스네이크 수에 비례하면 선형
+void benchArena(BenchRunner& runner)
+{
+    const struct { int snakes; int side; } cases[] = {{16, 64}, {256, 256}, {2048, 724}};
+    for (const auto& entry : cases) {
+        string name = "arena_tick/snakes" + to_string(entry.snakes);
+        if (!runner.enabled(name)) continue;
+        ArenaOptions options;
+        options.snakeCount = entry.snakes;
+        options.boardHeight = entry.side;
+        options.boardWidth = entry.side;
+        options.seed = 1;
+        Arena arena(options);
+        vector<int> actions(arena.size());
+        runner.run(name, [&]() {
+            arena.greedyActions(actions.data());
+            arena.step(actions.data());
+            benchSink += arena.aliveCount();
+        });
+    }
+}
+
+// ---- 결과 저장 / 비교 ------------------------------------------------------
+
+bool isOptimizedBuild()
+{
+#ifdef __OPTIMIZE__
+    return true;
+#else
+    return false;
+#endif
+}
+
+// JSON 문자열 값으로 쓸 수 있게 따옴표와 역슬래시만 이스케이프
+string jsonEscape(const string& text)
+{
+    string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+void writeJson(const string& path, const string& command, const vector<BenchResult>& results)
+{
+    ofstream out(path);
+    if (!out) {
+        throw runtime_error("Cannot write benchmark results: " + path);
+    }
+    out << "{\n  \"command\": \"" << jsonEscape(command) << "\",\n";
+    out << "  \"optimized\": " << (isOptimizedBuild() ? "true" : "false") << ",\n";
+    out << "  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        out << "    {\"name\": \"" << results[i].name << "\", \"ns_per_op\": " << results[i].nsPerOp
+            << ", \"allocs_per_op\": " << results[i].allocsPerOp << ", \"iterations\": " << results[i].iterations << "}" << (i + 1 < results.size() ? "," : "")
+            << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+// writeJson이 만든 형식만 읽는 최소 파서 ("name" 다음의 "ns_per_op" / "allocs_per_op" 값을 짝지음)
+vector<BenchResult> readJson(const string& path)
+{
+    ifstream in(path);
+    if (!in) {
+        throw runtime_error("Cannot read benchmark baseline: " + path);
+    }
+    stringstream buffer;
+    buffer << in.rdbuf();
+    string text = buffer.str();
+
+    vector<BenchResult> results;
+    const string nameKey = "\"name\": \"";
+    const string valueKey = "\"ns_per_op\": ";
+    const string allocsKey = "\"allocs_per_op\": ";
+    size_t pos = 0;
+    while ((pos = text.find(nameKey, pos)) != string::npos) {
+        pos += nameKey.size();
+        size_t end = text.find('"', pos);
+        size_t value = text.find(valueKey, end);
+        if (end == string::npos || value == string::npos) break;
+        BenchResult result;
+        result.name = text.substr(pos, end - pos);
+        result.nsPerOp = strtod(text.c_str() + value + valueKey.size(), nullptr);
+        // 할당 수가 없는 예전 기준 파일은 -1 (할당 비교 생략)
+        size_t allocs = text.find(allocsKey, value);
+        size_t next = text.find(nameKey, value);
+        result.allocsPerOp = allocs != string::npos && allocs < next ?
+            strtod(text.c_str() + allocs + allocsKey.size(), nullptr) : -1;
+        results.push_back(result);
+        pos = value;
+    }
+    return results;
+}
+
+// 기준보다 threshold% 이상 느려졌거나 op당 할당이 kAllocTolerance 넘게 늘어난 항목이 있으면 false.
+// 기준에는 있는데 이번 실행(필터 적용 후)에 없는 항목도 missing으로 보고한다 (이름이 바뀌었거나 빠진 벤치마크).
+bool compareWithBaseline(const BenchRunner& runner, const string& baselinePath, double thresholdPercent)
+{
+    // 할당 수는 거의 결정적이지만 배치 크기에 따라 한 번뿐인 준비 할당이 op당 조금씩 나뉘어 보일 수 있음
+    const double kAllocTolerance = 0.05;
+    const vector<BenchResult>& current = runner.getResults();
+    vector<BenchResult> baseline = readJson(baselinePath);
+    int regressions = 0;
+    int missing = 0;
+    printf("\n%-40s %12s %12s %9s %10s %10s\n", "benchmark", "baseline", "current", "change", "allocs", "was");
+    for (const BenchResult& result : current) {
+        auto it = find_if(baseline.begin(), baseline.end(),
+            [&](const BenchResult& base) { return base.name == result.name; });
+        if (it == baseline.end() || it->nsPerOp <= 0) {
+            printf("%-40s %12s %12.1f %9s %10.2f %10s\n", result.name.c_str(), "-", result.nsPerOp, "new",
+                   result.allocsPerOp, "-");
+            continue;
+        }
+        double change = (result.nsPerOp / it->nsPerOp - 1.0) * 100.0;
+        const char* mark = "";
+        if (it->allocsPerOp >= 0 && result.allocsPerOp > it->allocsPerOp + kAllocTolerance) {
+            mark = "  REGRESSION (allocs)";
+            regressions++;
+        } else if (change > thresholdPercent) {
+            mark = "  REGRESSION";
+            regressions++;
+        } else if (change < -thresholdPercent) {
+            mark = "  faster";
+        }
+        char was[16] = "-";
+        if (it->allocsPerOp >= 0) snprintf(was, sizeof(was), "%.2f", it->allocsPerOp);
+        printf("%-40s %12.1f %12.1f %+8.1f%% %10.2f %10s%s\n", result.name.c_str(), it->nsPerOp, result.nsPerOp,
+               change, result.allocsPerOp, was, mark);
+    }
+    for (const BenchResult& base : baseline) {
+        if (!runner.enabled(base.name)) continue;
+        auto it = find_if(current.begin(), current.end(),
+            [&](const BenchResult& result) { return result.name == base.name; });
+        if (it != current.end()) continue;
+        printf("%-40s %12.1f %12s %9s\n", base.name.c_str(), base.nsPerOp, "-", "missing");
+        missing++;
+    }
+    printf("\n%d regression(s) over %.1f%% or %.2f allocs/op, %d missing\n", regressions, thresholdPercent,
+           kAllocTolerance, missing);
+    return regressions == 0;
+}
+
+void printUsage(const char* program)
+{
+    cout << "Usage: " << program << " [options]\n"
+         << "  --filter TEXT       이름에 TEXT가 들어간 벤치마크만 실행\n"
+         << "  --list              벤치마크 이름만 출력\n"
+         << "  --json FILE         결과를 JSON으로 저장\n"
+         << "  --compare FILE      저장된 기준 결과와 비교 (느려졌거나 할당이 늘어난 항목이 있으면 종료 코드 1)\n"
+         << "  --threshold PCT     회귀로 판단할 변화율 (기본 10)\n"
+         << "  --min-time SEC      벤치마크당 최소 측정 시간 (기본 0.2)\n"
+         << "  --help              도움말 출력\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    BenchOptions options;
+    options.command = "snake_bench";
+    for (int i = 1; i < argc; ++i) options.command += string(" ") + argv[i];
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        auto nextValue = [&](const string& flag) -> string {
+            if (i + 1 >= argc) {
+                cerr << "Missing value for " << flag << "\n";
+                exit(1);
+            }
+            return argv[++i];
+        };
+        if (arg == "--filter") options.filter = nextValue(arg);
+        else if (arg == "--list") options.listOnly = true;
+        else if (arg == "--json") options.jsonPath = nextValue(arg);
+        else if (arg == "--compare") options.comparePath = nextValue(arg);
+        else if (arg == "--threshold") options.thresholdPercent = atof(nextValue(arg).c_str());
+        else if (arg == "--min-time") options.minSeconds = atof(nextValue(arg).c_str());
+        else if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            cerr << "Unknown option: " << arg << "\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (options.minSeconds <= 0) options.minSeconds = 0.2;
+
+    if (!isOptimizedBuild() && !options.listOnly) {
+        cerr << "warning: snake_bench was built without optimization; results are not representative\n";
+    }
+
+    try {
+        BenchRunner runner(options);
+        vector<Coord> path = buildCyclePath();
+        benchMapConstruction(runner);
+        benchStageReset(runner);
+        benchTick(runner, path);
+        benchIsValid(runner, path);
+        benchRandCoord(runner);
+        benchGenerateGate(runner);
+        benchDrawBoard(runner, path);
+        benchScriptedGames(runner);
+        benchArena(runner);
+        if (options.listOnly) return 0;
+
+        if (!options.jsonPath.empty()) {
+            writeJson(options.jsonPath, options.command, runner.getResults());
+        }
+        if (!options.comparePath.empty() &&
+            !compareWithBaseline(runner, options.comparePath, options.thresholdPercent)) {
+            return 1;
+        }
+    } catch (const exception& e) {
+        cerr << "Benchmark error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,694 @@
+#include "arena.h"
+#include "simulation.h"
+#include <chrono>
+#include <cstdlib>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+const int kDeltaRow[5] = {0, -1, 0, 0, 1};
+const int kDeltaCol[5] = {0, 0, -1, 1, 0};
+
+MapType arenaMapType(const ArenaOptions& options)
+{
+    if (options.wallDensity > 0) return MapType::PROCEDURAL;
+    switch (options.stage) {
+        case 2: return MapType::MAZE;
+        case 3: return MapType::ISLANDS;
+        case 4: return MapType::CROSS;
+        default: return MapType::BASIC;
+    }
+}
+
+Coord stepFrom(const Coord& pos, int direction, int distance = 1)
+{
+    return {pos.row + kDeltaRow[direction] * distance, pos.col + kDeltaCol[direction] * distance};
+}
+
+} // namespace
+
+const char* arenaDeathName(ArenaDeath death)
+{
+    switch (death) {
+        case ArenaDeath::HEAD_ON: return "head-on";
+        case ArenaDeath::BODY: return "body";
+        case ArenaDeath::WALL: return "wall";
+        case ArenaDeath::POISON: return "poison";
+        default: return "none";
+    }
+}
+
+void Arena::validateOptions(const ArenaOptions& options)
+{
+    // 명령행(main / snake_server)과 같은 범위: 보드 각 변은 Simulation과 같은 한도
+    if (options.snakeCount < 1 || options.snakeCount > kMaxSnakes) {
+        throw invalid_argument("Arena snake count must be between 1 and " + to_string(kMaxSnakes));
+    }
+    if (options.boardHeight < Simulation::kMinBoardSize || options.boardWidth < Simulation::kMinBoardSize ||
+        options.boardHeight > Simulation::kMaxBoardSize || options.boardWidth > Simulation::kMaxBoardSize) {
+        throw invalid_argument("Board size must be between " + to_string(Simulation::kMinBoardSize) +
+                               " and " + to_string(Simulation::kMaxBoardSize));
+    }
+    if (options.stage < 1 || options.stage > Simulation::kFinalStage) {
+        throw invalid_argument("Stage must be between 1 and " + to_string(Simulation::kFinalStage));
+    }
+    if (options.wallDensity < 0 || options.wallDensity > Map::kMaxWallDensity) {
+        throw invalid_argument("Wall density must be between 1 and " + to_string(Map::kMaxWallDensity));
+    }
+}
+
+Arena::Arena(const ArenaOptions& arenaOptions)
+    : options(arenaOptions)
+    , rng(arenaOptions.seed)
+{
+    validateOptions(options);
+    uint64_t layoutSeed = rng.next64();
+    map.reset(options.boardHeight, options.boardWidth, arenaMapType(options), options.stage,
+              layoutSeed, options.wallDensity > 0 ? options.wallDensity : Map::kDefaultWallDensity);
+    // 맵 자체의 스네이크 / 아이템은 쓰지 않는다 (스네이크와 아이템은 아레나가 관리)
+    map.restoreSnake(Map::parkedCoord(), -1, {});
+    map.growthItemObject = GrowthItem(0, 0);
+    map.poisonItemObject = PoisonItem(0, 0);
+    map.timeItemObject = TimeItem(0, 0);
+    generateGates();
+
+    int gridRows = map.mapSize.height + 2;
+    int gridCols = map.mapSize.width + 2;
+    headGrid.reset(gridRows, gridCols, 0);
+    itemGrid.reset(gridRows, gridCols, 0);
+
+    size_t maxLength = static_cast<size_t>(gridRows) * gridCols;
+    snakes.resize(options.snakeCount);
+    for (ArenaSnake& snake : snakes) snake.body.reset(maxLength);
+    gateBlocked.assign(snakes.size(), 0);
+    dyingMark.assign(snakes.size(), 0);
+    dying.reserve(snakes.size());
+    for (int i = 0; i < size(); ++i) {
+        spawnSnake(i);
+    }
+
+    itemsPerKind = options.itemsPerKind > 0 ? options.itemsPerKind : max(1, options.snakeCount / 16);
+    items.resize(static_cast<size_t>(itemsPerKind) * 3);
+    for (size_t i = 0; i < items.size(); ++i) {
+        items[i].kind = static_cast<ArenaItemKind>(i / itemsPerKind);
+        placeItem(static_cast<int>(i));
+    }
+}
+
+void Arena::generateGates()
+{
+    int wallIndex1, wallIndex2;
+    if (!map.pickGateWalls(rng, wallIndex1, wallIndex2)) {
+        map.gameGates.clear(); // 벽이 모자라면 게이트 없이 진행
+        return;
+    }
+    map.gameGates[0] = Gate(map.regularWalls[wallIndex1]);
+    map.gameGates[1] = Gate(map.regularWalls[wallIndex2]);
+}
+
+int Arena::headAt(const Coord& pos) const
+{
+    return static_cast<int>(headCell(pos)) - 1;
+}
+
+void Arena::step(const int* actions)
+{
+    stats.ticks++;
+    if (speedBoostTimer > 0 && --speedBoostTimer == 0) speedMultiplier = 1;
+
+    // 1~2. 모든 스네이크를 먼저 움직인 뒤 (머리 격자에서 이전 머리를 뺌) 한꺼번에 판정
+    for (int i = 0; i < size(); ++i) {
+        if (snakes[i].alive) moveSnake(i, actions ? actions[i] : 0);
+    }
+    resolveCollisions();
+
+    // 3. 아이템: 오래된 아이템을 옮긴 뒤 살아남은 머리 아래의 아이템을 먹음
+    refreshItems();
+    for (int i = 0; i < size(); ++i) {
+        if (!snakes[i].alive || dyingMark[i]) continue;
+        uint32_t item = itemCell(snakes[i].head);
+        if (item) eatItem(i, static_cast<int>(item) - 1);
+    }
+
+    // 4. 탈락한 스네이크를 치우고 대기가 끝난 스네이크를 다시 놓음
+    removeDead();
+    respawnWaiting();
+}
+
+void Arena::moveSnake(int index, int action)
+{
+    ArenaSnake& snake = snakes[index];
+    if (action >= 1 && action <= 4 && action + snake.direction != 5) {
+        snake.direction = action;
+    }
+    headGrid.set(snake.head.row, snake.head.col, 0);
+    if (!snake.body.empty()) {
+        map.vacateCell(snake.body.back());
+        snake.body.popBack();
+    }
+    snake.body.pushFront(snake.head);
+    map.occupyCell(snake.head);
+    snake.head = stepFrom(snake.head, snake.direction);
+    stats.snakeMoves++;
+
+    gateBlocked[index] = 0;
+    for (size_t g = 0; g < map.gameGates.size(); ++g) {
+        if (snake.head == map.gameGates[g].coord) {
+            Coord exitPosition;
+            int exitDirection;
+            if (!map.findGateExit(map.gameGates[1 - g], snake.direction, exitPosition, exitDirection)) {
+                gateBlocked[index] = 1;
+            }
+            snake.head = exitPosition;
+            snake.direction = exitDirection;
+            stats.gatesUsed++;
+            break;
+        }
+    }
+}
+
+void Arena::resolveCollisions()
+{
+    // 머리끼리: 먼저 도착한 머리가 칸을 차지하고, 이미 차지된 칸에 온 머리는 그 주인과 함께 탈락
+    for (int i = 0; i < size(); ++i) {
+        ArenaSnake& snake = snakes[i];
+        if (!snake.alive) continue;
+        if (!inGrid(snake.head)) {
+            kill(i, ArenaDeath::WALL);
+            continue;
+        }
+        uint32_t owner = headGrid.get(snake.head.row, snake.head.col);
+        if (owner == 0) {
+            headGrid.set(snake.head.row, snake.head.col, static_cast<uint32_t>(i) + 1);
+        } else {
+            kill(i, ArenaDeath::HEAD_ON);
+            kill(static_cast<int>(owner) - 1, ArenaDeath::HEAD_ON);
+        }
+    }
+    // 머리와 벽 / 몸통: 모든 스네이크가 움직인 뒤의 타일 한 번 읽기로 판정
+    for (int i = 0; i < size(); ++i) {
+        const ArenaSnake& snake = snakes[i];
+        if (!snake.alive || dyingMark[i]) continue;
+        if (!gateBlocked[i] && map.isWall(snake.head)) kill(i, ArenaDeath::WALL);
+        else if (map.bodyCountAt(snake.head) > 0) kill(i, ArenaDeath::BODY);
+    }
+}
+
+void Arena::eatItem(int index, int itemIndex)
+{
+    ArenaSnake& snake = snakes[index];
+    snake.itemsEaten++;
+    stats.itemsEaten++;
+    switch (items[itemIndex].kind) {
+        case ArenaItemKind::GROWTH:
+            growTail(snake);
+            break;
+        case ArenaItemKind::POISON:
+            if (snake.body.size() <= static_cast<size_t>(kInitialLength)) {
+                kill(index, ArenaDeath::POISON);
+            } else {
+                map.vacateCell(snake.body.back());
+                snake.body.popBack();
+            }
+            break;
+        case ArenaItemKind::TIME:
+            speedMultiplier = 1.5;
+            speedBoostTimer = kSpeedBoostTicks;
+            break;
+    }
+    int length = static_cast<int>(snake.body.size());
+    if (length > snake.maxLength) snake.maxLength = length;
+    if (length > stats.bestLength) stats.bestLength = length;
+    placeItem(itemIndex);
+}
+
+Coord Arena::grownCell(const ArenaSnake& snake)
+{
+    // 꼬리 방향으로 한 칸 더
+    const Coord& tail = snake.body.back();
+    const Coord& prev = snake.body.size() >= 2 ? snake.body[snake.body.size() - 2] : snake.head;
+    return {tail.row + (tail.row - prev.row), tail.col + (tail.col - prev.col)};
+}
+
+void Arena::growTail(ArenaSnake& snake)
+{
+    // 늘어날 칸이 벽이거나 다른 머리가 있으면 늘리지 않음
+    Coord grown = grownCell(snake);
+    if (inGrid(grown) && !map.isWall(grown) && !headCell(grown) && snake.body.pushBack(grown)) {
+        map.occupyCell(grown);
+    }
+}
+
+void Arena::kill(int index, ArenaDeath reason)
+{
+    if (dyingMark[index]) return;
+    dyingMark[index] = 1;
+    dying.push_back(index);
+    snakes[index].lastDeath = reason;
+    switch (reason) {
+        case ArenaDeath::HEAD_ON: stats.headOnDeaths++; break;
+        case ArenaDeath::BODY: stats.bodyDeaths++; break;
+        case ArenaDeath::WALL: stats.wallDeaths++; break;
+        case ArenaDeath::POISON: stats.poisonDeaths++; break;
+        default: break;
+    }
+}
+
+void Arena::removeDead()
+{
+    for (int index : dying) {
+        ArenaSnake& snake = snakes[index];
+        if (headCell(snake.head) == static_cast<uint32_t>(index) + 1) {
+            headGrid.set(snake.head.row, snake.head.col, 0);
+        }
+        for (const Coord& segment : snake.body) {
+            map.vacateCell(segment);
+        }
+        snake.body.clear();
+        snake.alive = false;
+        snake.deaths++;
+        snake.respawnTimer = options.respawnDelay;
+        aliveSnakes--;
+        dyingMark[index] = 0;
+    }
+    dying.clear();
+}
+
+void Arena::respawnWaiting()
+{
+    if (options.respawnDelay < 0 || aliveSnakes == size()) return;
+    for (int i = 0; i < size(); ++i) {
+        ArenaSnake& snake = snakes[i];
+        if (snake.alive) continue;
+        if (snake.respawnTimer > 0) {
+            snake.respawnTimer--;
+        } else if (spawnSnake(i)) {
+            stats.respawns++;
+        }
+    }
+}
+
+bool Arena::spawnSnake(int index)
+{
+    // 빈 칸에 머리를 두고, 머리 앞 칸과 뒤로 이어질 몸통 칸이 모두 비어 있는 방향을 고름 (실패하면 다음 틱에 재시도)
+    for (int attempt = 0; attempt < kSpawnAttempts; ++attempt) {
+        Coord head;
+        if (!map.pickFreeCell(rng, head, nullptr, 0)) return false;
+        int direction = rng.range(1, 4);
+        if (headCell(head) || itemCell(head)) continue;
+
+        bool clear = true;
+        for (int k = -1; k <= kInitialLength && clear; ++k) {
+            if (k == 0) continue;
+            Coord cell = stepFrom(head, direction, -k);
+            clear = inGrid(cell) && !map.isWall(cell) && map.bodyCountAt(cell) == 0 && !headCell(cell);
+        }
+        if (!clear) continue;
+
+        ArenaSnake& snake = snakes[index];
+        snake.head = head;
+        snake.direction = direction;
+        layInitialBody(index);
+        snake.lastDeath = ArenaDeath::NONE;
+        if (stats.bestLength < kInitialLength) stats.bestLength = kInitialLength;
+        return true;
+    }
+    return false;
+}
+
+void Arena::layInitialBody(int index)
+{
+    // 머리 뒤로 방향 반대쪽에 몸통을 곧게 놓음 (복제본도 머리와 방향만으로 같은 몸통을 만듦)
+    ArenaSnake& snake = snakes[index];
+    snake.body.clear();
+    for (int k = 1; k <= kInitialLength; ++k) {
+        Coord cell = stepFrom(snake.head, snake.direction, -k);
+        snake.body.pushBack(cell);
+        map.occupyCell(cell);
+    }
+    headGrid.set(snake.head.row, snake.head.col, static_cast<uint32_t>(index) + 1);
+    snake.alive = true;
+    snake.spawnTick = stats.ticks;
+    if (snake.maxLength < kInitialLength) snake.maxLength = kInitialLength;
+    aliveSnakes++;
+}
+
+void Arena::placeItem(int itemIndex)
+{
+    items[itemIndex].placedTick = stats.ticks;
+    moveItem(itemIndex, Map::parkedCoord());
+    // 빈 칸 중 머리 / 다른 아이템이 없는 칸 (몇 번 실패하면 다음 주기까지 보드 밖에 둠)
+    for (int attempt = 0; attempt < kSpawnAttempts; ++attempt) {
+        Coord pos;
+        if (!map.pickFreeCell(rng, pos, nullptr, 0)) return;
+        if (headCell(pos) || itemCell(pos)) continue;
+        moveItem(itemIndex, pos);
+        return;
+    }
+}
+
+void Arena::moveItem(int itemIndex, const Coord& coord)
+{
+    ArenaItem& item = items[itemIndex];
+    uint32_t tag = static_cast<uint32_t>(itemIndex) + 1;
+    if (Map::isPlaced(item.coord) && itemCell(item.coord) == tag) itemGrid.set(item.coord.row, item.coord.col, 0);
+    item.coord = coord;
+    if (Map::isPlaced(coord)) itemGrid.set(coord.row, coord.col, tag);
+}
+
+void Arena::refreshItems()
+{
+    for (size_t i = 0; i < items.size(); ++i) {
+        if (stats.ticks - items[i].placedTick >= kItemRespawnTicks) placeItem(static_cast<int>(i));
+    }
+}
+
+int Arena::greedyDirection(int index) const
+{
+    const ArenaSnake& snake = snakes[index];
+    if (!snake.alive) return 0;
+    // 스네이크마다 성장 / 시간 아이템 중 하나를 고정으로 목표로 삼아 모두가 한 아이템으로 몰리지 않게 함
+    size_t targetSlot = static_cast<size_t>(index) % (static_cast<size_t>(itemsPerKind) * 2);
+    if (targetSlot >= static_cast<size_t>(itemsPerKind)) targetSlot += itemsPerKind; // 독 아이템 건너뜀
+    const Coord& target = items[targetSlot].coord;
+    bool hasTarget = Map::isPlaced(target);
+
+    int bestDir = 0;
+    int bestScore = 0;
+    for (int k = 0; k < 4; ++k) {
+        // 동점일 때 모두 같은 방향을 고르지 않도록 시작 방향을 스네이크마다 다르게 함
+        int d = (index + k) % 4 + 1;
+        if (d + snake.direction == 5) continue;
+        Coord next = stepFrom(snake.head, d);
+        bool isGate = false;
+        for (const auto& gate : map.gameGates) {
+            if (gate.coord == next) isGate = true;
+        }
+        if (map.isWall(next) && !isGate) continue;
+        if (map.bodyCountAt(next) > 0 || headCell(next)) continue;
+        uint32_t item = itemCell(next);
+        if (item && items[item - 1].kind == ArenaItemKind::POISON) continue;
+
+        int score = 100000;
+        if (hasTarget) score -= abs(next.row - target.row) + abs(next.col - target.col);
+        // 다른 머리가 같은 칸으로 올 수 있으면 정면 충돌 위험
+        for (int n = 1; n <= 4; ++n) {
+            uint32_t owner = headCell(stepFrom(next, n));
+            if (owner && owner != static_cast<uint32_t>(index) + 1) score -= 1000;
+        }
+        if (bestDir == 0 || score > bestScore) {
+            bestScore = score;
+            bestDir = d;
+        }
+    }
+    return bestDir;
+}
+
+void Arena::greedyActions(int* actions) const
+{
+    for (int i = 0; i < size(); ++i) {
+        actions[i] = greedyDirection(i);
+    }
+}
+
+// ---- 네트워크 복제 ----------------------------------------------------------
+
+namespace {
+
+const uint8_t kRecordAlive = 0x01;
+const uint8_t kRecordSpawned = 0x02;   // 이번 틱에 (다시) 나타남: 몸통을 처음부터 놓음
+const int kRecordDeathShift = 4;
+
+void writeStats(ByteWriter& w, const ArenaStats& stats)
+{
+    w.u64(static_cast<uint64_t>(stats.ticks));
+    w.u64(static_cast<uint64_t>(stats.snakeMoves));
+    w.u32(static_cast<uint32_t>(stats.headOnDeaths));
+    w.u32(static_cast<uint32_t>(stats.bodyDeaths));
+    w.u32(static_cast<uint32_t>(stats.wallDeaths));
+    w.u32(static_cast<uint32_t>(stats.poisonDeaths));
+    w.u32(static_cast<uint32_t>(stats.respawns));
+    w.u32(static_cast<uint32_t>(stats.itemsEaten));
+    w.u32(static_cast<uint32_t>(stats.gatesUsed));
+    w.i32(stats.bestLength);
+}
+
+void readStats(ByteReader& r, ArenaStats& stats)
+{
+    stats.ticks = static_cast<long>(r.u64());
+    stats.snakeMoves = static_cast<long>(r.u64());
+    stats.headOnDeaths = r.u32();
+    stats.bodyDeaths = r.u32();
+    stats.wallDeaths = r.u32();
+    stats.poisonDeaths = r.u32();
+    stats.respawns = r.u32();
+    stats.itemsEaten = r.u32();
+    stats.gatesUsed = r.u32();
+    stats.bestLength = r.i32();
+}
+
+// 틱 변화분의 좌표는 보드 한 변이 16384 이하이므로 16비트로 충분
+void writeCell(ByteWriter& w, const Coord& c)
+{
+    w.u16(static_cast<uint16_t>(c.row));
+    w.u16(static_cast<uint16_t>(c.col));
+}
+
+Coord readCell(ByteReader& r)
+{
+    Coord c;
+    c.row = r.u16();
+    c.col = r.u16();
+    return c;
+}
+
+} // namespace
+
+void Arena::encodeKeyframe(ByteWriter& w) const
+{
+    writeStats(w, stats);
+    w.f32(speedMultiplier);
+    w.i32(speedBoostTimer);
+    w.u32(static_cast<uint32_t>(snakes.size()));
+    for (const ArenaSnake& snake : snakes) {
+        w.u8(snake.alive ? kRecordAlive : 0);
+        w.coord(snake.head);
+        w.i32(snake.direction);
+        w.i32(snake.respawnTimer);
+        w.i32(snake.itemsEaten);
+        w.i32(snake.deaths);
+        w.i32(snake.maxLength);
+        w.u8(static_cast<uint8_t>(snake.lastDeath));
+        w.u64(static_cast<uint64_t>(snake.spawnTick));
+        w.u32(static_cast<uint32_t>(snake.body.size()));
+        for (const Coord& segment : snake.body) writeCell(w, segment);
+    }
+    w.u32(static_cast<uint32_t>(items.size()));
+    for (const ArenaItem& item : items) {
+        writeCell(w, item.coord);
+        w.u64(static_cast<uint64_t>(item.placedTick));
+    }
+}
+
+void Arena::clearReplica()
+{
+    for (ArenaSnake& snake : snakes) {
+        if (!snake.alive) continue;
+        headGrid.set(snake.head.row, snake.head.col, 0);
+        for (const Coord& segment : snake.body) map.vacateCell(segment);
+        snake.body.clear();
+        snake.alive = false;
+    }
+    aliveSnakes = 0;
+    for (size_t i = 0; i < items.size(); ++i) moveItem(static_cast<int>(i), Map::parkedCoord());
+}
+
+void Arena::applyKeyframe(ByteReader& r)
+{
+    clearReplica();
+    readStats(r, stats);
+    speedMultiplier = r.f32();
+    speedBoostTimer = r.i32();
+    if (r.u32() != snakes.size()) throw runtime_error("Arena keyframe has a different snake count");
+    for (int i = 0; i < size(); ++i) {
+        ArenaSnake& snake = snakes[i];
+        bool alive = (r.u8() & kRecordAlive) != 0;
+        snake.head = r.coord();
+        snake.direction = r.i32();
+        snake.respawnTimer = r.i32();
+        snake.itemsEaten = r.i32();
+        snake.deaths = r.i32();
+        snake.maxLength = r.i32();
+        snake.lastDeath = static_cast<ArenaDeath>(r.u8());
+        snake.spawnTick = static_cast<long>(r.u64());
+        uint32_t length = r.u32();
+        for (uint32_t k = 0; k < length; ++k) {
+            Coord segment = readCell(r);
+            if (!snake.body.pushBack(segment)) throw runtime_error("Arena keyframe body is too long");
+            map.occupyCell(segment);
+        }
+        if (alive) {
+            if (!inGrid(snake.head)) throw runtime_error("Arena keyframe head is off the board");
+            headGrid.set(snake.head.row, snake.head.col, static_cast<uint32_t>(i) + 1);
+            snake.alive = true;
+            aliveSnakes++;
+        }
+    }
+    if (r.u32() != items.size()) throw runtime_error("Arena keyframe has a different item count");
+    for (size_t i = 0; i < items.size(); ++i) {
+        moveItem(static_cast<int>(i), readCell(r));
+        items[i].placedTick = static_cast<long>(r.u64());
+    }
+}
+
+void Arena::encodeTick(ByteWriter& w) const
+{
+    writeStats(w, stats);
+    w.f32(speedMultiplier);
+    for (const ArenaSnake& snake : snakes) {
+        uint8_t flags = static_cast<uint8_t>(static_cast<uint8_t>(snake.lastDeath) << kRecordDeathShift);
+        if (snake.alive) flags |= kRecordAlive;
+        if (snake.alive && snake.spawnTick == stats.ticks) flags |= kRecordSpawned;
+        w.u8(flags);
+        if (!snake.alive) {
+            w.u16(static_cast<uint16_t>(min(snake.respawnTimer, 0xFFFF)));
+            continue;
+        }
+        writeCell(w, snake.head);
+        w.u8(static_cast<uint8_t>(snake.direction));
+        w.u32(static_cast<uint32_t>(snake.body.size()));
+        w.u32(static_cast<uint32_t>(snake.itemsEaten));
+    }
+    for (const ArenaItem& item : items) writeCell(w, item.coord);
+}
+
+void Arena::applyTick(ByteReader& r)
+{
+    readStats(r, stats);
+    speedMultiplier = r.f32();
+    // 이전 머리를 모두 뺀 뒤 새 머리를 놓음 (스네이크 순서와 무관)
+    for (const ArenaSnake& snake : snakes) {
+        if (snake.alive) headGrid.set(snake.head.row, snake.head.col, 0);
+    }
+    for (int i = 0; i < size(); ++i) {
+        ArenaSnake& snake = snakes[i];
+        uint8_t flags = r.u8();
+        bool alive = (flags & kRecordAlive) != 0;
+        bool spawned = (flags & kRecordSpawned) != 0;
+        snake.lastDeath = static_cast<ArenaDeath>(flags >> kRecordDeathShift);
+        if (snake.alive && (!alive || spawned)) {
+            for (const Coord& segment : snake.body) map.vacateCell(segment);
+            snake.body.clear();
+            snake.alive = false;
+            snake.deaths++;
+            aliveSnakes--;
+        }
+        if (!alive) {
+            snake.respawnTimer = r.u16();
+            continue;
+        }
+        Coord head = readCell(r);
+        int direction = r.u8();
+        size_t length = r.u32();
+        snake.itemsEaten = static_cast<int>(r.u32());
+        if (!inGrid(head) || direction < 1 || direction > 4) throw runtime_error("Arena update has an invalid head");
+        if (!snake.alive) {
+            snake.head = head;
+            snake.direction = direction;
+            layInitialBody(i);
+        } else {
+            // 서버와 같은 순서: 꼬리 비우기 → 이전 머리를 목으로 → 아이템에 따른 길이 맞춤
+            if (!snake.body.empty()) {
+                map.vacateCell(snake.body.back());
+                snake.body.popBack();
+            }
+            snake.body.pushFront(snake.head);
+            map.occupyCell(snake.head);
+            snake.head = head;
+            snake.direction = direction;
+            headGrid.set(head.row, head.col, static_cast<uint32_t>(i) + 1);
+            // 늘어났으면 서버가 판정을 마친 칸이므로 그대로 붙임 (복제본의 머리 격자는 아직 갱신 중)
+            if (length > snake.body.size() && !snake.body.empty()) {
+                Coord grown = grownCell(snake);
+                if (snake.body.pushBack(grown)) map.occupyCell(grown);
+            }
+            while (snake.body.size() > length && !snake.body.empty()) {
+                map.vacateCell(snake.body.back());
+                snake.body.popBack();
+            }
+        }
+        int current = static_cast<int>(snake.body.size());
+        if (current > snake.maxLength) snake.maxLength = current;
+    }
+    for (size_t i = 0; i < items.size(); ++i) {
+        moveItem(static_cast<int>(i), readCell(r));
+    }
+}
+
+uint32_t Arena::stateChecksum() const
+{
+    // FNV-1a (32비트)
+    uint32_t hash = 2166136261u;
+    auto mix = [&hash](uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            hash ^= (value >> (8 * i)) & 0xFFu;
+            hash *= 16777619u;
+        }
+    };
+    mix(static_cast<uint32_t>(stats.ticks));
+    mix(static_cast<uint32_t>(aliveSnakes));
+    for (const ArenaSnake& snake : snakes) {
+        mix(snake.alive ? 1u : 0u);
+        if (!snake.alive) continue;
+        mix(static_cast<uint32_t>(snake.head.row));
+        mix(static_cast<uint32_t>(snake.head.col));
+        mix(static_cast<uint32_t>(snake.direction));
+        mix(static_cast<uint32_t>(snake.body.size()));
+        if (snake.body.empty()) continue;
+        mix(static_cast<uint32_t>(snake.body.front().row));
+        mix(static_cast<uint32_t>(snake.body.front().col));
+        mix(static_cast<uint32_t>(snake.body.back().row));
+        mix(static_cast<uint32_t>(snake.body.back().col));
+    }
+    for (const ArenaItem& item : items) {
+        mix(static_cast<uint32_t>(item.coord.row));
+        mix(static_cast<uint32_t>(item.coord.col));
+    }
+    return hash;
+}
+
+ArenaStats runArenaHeadless(const ArenaOptions& options, long maxTicks)
+{
+    auto begin = chrono::steady_clock::now();
+    Arena arena(options);
+    vector<int> actions(arena.size());
+    for (long t = 0; t < maxTicks; ++t) {
+        arena.greedyActions(actions.data());
+        arena.step(actions.data());
+    }
+    ArenaStats stats = arena.getStats();
+    stats.elapsedSeconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+    return stats;
+}
+
+void printArenaStats(const ArenaStats& stats, int snakeCount, ostream& out)
+{
+    out << "snakes: " << snakeCount << "\n"
+        << "ticks: " << stats.ticks << "\n"
+        << "snake moves: " << stats.snakeMoves << "\n"
+        << "head-on deaths: " << stats.headOnDeaths << "\n"
+        << "body deaths: " << stats.bodyDeaths << "\n"
+        << "wall deaths: " << stats.wallDeaths << "\n"
+        << "poison deaths: " << stats.poisonDeaths << "\n"
+        << "respawns: " << stats.respawns << "\n"
+        << "items eaten: " << stats.itemsEaten << "\n"
+        << "gates used: " << stats.gatesUsed << "\n"
+        << "best length: " << stats.bestLength << "\n"
+        << "elapsed: " << stats.elapsedSeconds << " s\n";
+    if (stats.elapsedSeconds > 0) {
+        out << "ticks/s: " << static_cast<long>(stats.ticks / stats.elapsedSeconds) << "\n"
+            << "snake moves/s: " << static_cast<long>(stats.snakeMoves / stats.elapsedSeconds) << "\n";
+    }
+}
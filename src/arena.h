@@ -0,0 +1,182 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "map.h"
+#include "rng.h"
+#include "chunked_grid.h"
+#include "byte_io.h"
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+// 아레나 모드: 여러 스네이크가 하나의 맵(벽 / 게이트 / 아이템)을 함께 쓰는 시뮬레이션 (ncurses 비의존)
+// 한 틱의 이동은 모든 스네이크에 대해 동시에 처리한다.
+//   1. 각 스네이크가 꼬리를 비우고 이전 머리를 목으로 옮긴다 (몸통 수는 맵 타일에 모두 합산)
+//   2. 새 머리 위치를 계산한다 (게이트에 들어가면 짝 게이트의 출구로)
+//   3. 같은 칸에 도착한 머리는 모두 탈락(정면 충돌), 벽이나 몸통(자기 것 포함) 칸에 도착한 머리도 탈락
+//   4. 살아남은 스네이크가 아이템을 먹고, 탈락한 스네이크의 몸통을 치운다
+// 머리끼리는 칸별 머리 격자로, 머리와 몸통은 맵 타일의 몸통 수로 판정하므로 스네이크 쌍을 비교하지 않고
+// 틱 비용이 스네이크 수에 비례한다. 서로 머리 자리를 맞바꾸는 경우는 상대의 목에 부딪힌 몸통 충돌이 된다.
+// 단일 플레이 규칙(Simulation)과 달리 미션 / 스테이지 진행은 없고, 역방향 입력은 무시하며,
+// 탈락한 스네이크는 respawnDelay 틱 뒤 빈 자리에 다시 나타난다.
+
+enum class ArenaDeath : unsigned char {
+    NONE = 0,
+    HEAD_ON,    // 다른 머리와 같은 칸에 도착
+    BODY,       // 몸통 칸에 도착
+    WALL,       // 벽 / 무적벽 칸에 도착
+    POISON      // 독 아이템으로 길이가 3 미만이 됨
+};
+
+const char* arenaDeathName(ArenaDeath death);
+
+struct ArenaOptions {
+    int snakeCount = 16;
+    int boardHeight = 21;
+    int boardWidth = 41;
+    int stage = 1;            // 내장 스테이지 벽 배치 (1~4)
+    int wallDensity = 0;      // 0보다 크면 이 벽 밀도(%)의 절차적 맵
+    uint64_t seed = 0;
+    int itemsPerKind = 0;     // 종류별 아이템 수 (0이면 스네이크 16마리당 1개, 최소 1개)
+    int respawnDelay = 20;    // 탈락 후 다시 나타날 때까지의 틱 (음수면 부활 없음)
+};
+
+struct ArenaSnake {
+    Coord head{0, 0};
+    int direction = -1;
+    SnakeBodyRing body;
+    bool alive = false;
+    int respawnTimer = 0;     // 부활까지 남은 틱
+    int itemsEaten = 0;
+    int deaths = 0;
+    int maxLength = 0;        // 지금까지의 최대 길이 (머리 제외 몸통 수)
+    long spawnTick = -1;      // 마지막으로 나타난 틱
+    ArenaDeath lastDeath = ArenaDeath::NONE;
+};
+
+enum class ArenaItemKind : unsigned char {
+    GROWTH = 0,
+    POISON = 1,
+    TIME = 2
+};
+
+struct ArenaItem {
+    Coord coord{0, 0};        // 놓을 곳이 없으면 Map::parkedCoord()
+    ArenaItemKind kind = ArenaItemKind::GROWTH;
+    long placedTick = 0;      // 50틱이 지나면 다른 자리로 옮김
+};
+
+// 아레나 실행 누적 결과
+struct ArenaStats {
+    long ticks = 0;
+    long snakeMoves = 0;      // 살아 있는 스네이크의 이동 수 합계
+    long headOnDeaths = 0;
+    long bodyDeaths = 0;
+    long wallDeaths = 0;
+    long poisonDeaths = 0;
+    long respawns = 0;
+    long itemsEaten = 0;
+    long gatesUsed = 0;
+    int bestLength = 0;
+    double elapsedSeconds = 0;
+};
+
+class Arena
+{
+public:
+    // 명령행에서 받는 최대 스네이크 수
+    static const int kMaxSnakes = 1 << 16;
+    // 스네이크 수(1~kMaxSnakes) / 보드 크기(Simulation과 같은 범위) / 스테이지 / 벽 밀도 검사 (벗어나면 invalid_argument)
+    static void validateOptions(const ArenaOptions& options);
+    // 스폰 시 몸통 길이 (머리 제외)
+    static const int kInitialLength = 3;
+
+    explicit Arena(const ArenaOptions& options);
+
+    // actions[i]: 0 = 입력 없음(현재 방향 유지), 1~4 = 위 / 왼쪽 / 오른쪽 / 아래.
+    // size()개를 넘기며 nullptr이면 모두 입력 없음.
+    void step(const int* actions);
+    // 기본 봇: 벽 / 몸통 / 다른 머리 근처를 피해 가장 가까운 성장 / 시간 아이템 쪽으로 가는 방향 (스네이크당 O(1))
+    int greedyDirection(int index) const;
+    // 모든 스네이크의 기본 봇 행동 (사람이 조종하는 스네이크는 호출자가 덮어씀)
+    void greedyActions(int* actions) const;
+
+    int size() const { return static_cast<int>(snakes.size()); }
+    const ArenaSnake& snake(int index) const { return snakes[index]; }
+    const Map& getMap() const { return map; }
+    const vector<ArenaItem>& getItems() const { return items; }
+    // pos에 있는 살아 있는 머리의 스네이크 번호 (없으면 -1)
+    int headAt(const Coord& pos) const;
+    // pos에 놓인 아이템의 getItems() 번호 (없으면 -1)
+    int itemAt(const Coord& pos) const { return static_cast<int>(itemCell(pos)) - 1; }
+    int aliveCount() const { return aliveSnakes; }
+    long getTickCount() const { return stats.ticks; }
+    const ArenaStats& getStats() const { return stats; }
+    const ArenaOptions& getOptions() const { return options; }
+    float getSpeedMultiplier() const { return speedMultiplier; }
+    double getTickPeriodMs() const { return kBaseTickMs / static_cast<double>(speedMultiplier); }
+
+    // 네트워크 복제 (tick_server.h): 서버는 접속한 클라이언트에 키프레임을, 매 틱 모든 클라이언트에 변화분을 보내고
+    // 클라이언트는 같은 옵션으로 만든 Arena에 적용한다 (복제본에서는 step을 호출하지 않음).
+    // 틱 변화분은 스네이크당 머리 / 방향 / 길이만 담고, 몸통은 서버와 같은 규칙(꼬리 비우기 → 목 채우기 → 길이 맞춤)으로 다시 만든다.
+    void encodeKeyframe(ByteWriter& w) const;
+    void applyKeyframe(ByteReader& r);
+    void encodeTick(ByteWriter& w) const;
+    void applyTick(ByteReader& r);
+    // 복제 검증용 상태 요약값 (틱 / 머리 / 방향 / 몸통 길이와 양 끝 / 아이템 위치)
+    uint32_t stateChecksum() const;
+
+private:
+    static const int kItemRespawnTicks = 50;
+    static const int kSpeedBoostTicks = 40;
+    static const int kBaseTickMs = 200;   // 단일 플레이 1스테이지와 같은 틱 간격
+    static const int kSpawnAttempts = 16;
+
+    ArenaOptions options;
+    Rng rng;
+    Map map;
+    vector<ArenaSnake> snakes;
+    vector<unsigned char> gateBlocked; // 이번 틱에 출구가 막혀 게이트 위에 머문 스네이크 (벽 판정 제외)
+    vector<int> dying;                 // 이번 틱에 탈락한 스네이크 번호 (중복 없음)
+    vector<unsigned char> dyingMark;
+    // 칸별 살아 있는 머리 (스네이크 번호 + 1, 0 = 없음) / 아이템 (items 번호 + 1, 0 = 없음)
+    ChunkedGrid<uint32_t> headGrid;
+    ChunkedGrid<uint32_t> itemGrid;
+    vector<ArenaItem> items;             // 종류별로 itemsPerKind개씩 (성장 → 독 → 시간 순)
+    int itemsPerKind = 1;
+    int aliveSnakes = 0;
+    float speedMultiplier = 1;
+    int speedBoostTimer = 0;
+    ArenaStats stats;
+
+    bool inGrid(const Coord& pos) const {
+        return pos.row >= 0 && pos.row <= map.mapSize.height + 1 &&
+               pos.col >= 0 && pos.col <= map.mapSize.width + 1;
+    }
+    uint32_t headCell(const Coord& pos) const { return inGrid(pos) ? headGrid.get(pos.row, pos.col) : 0; }
+    uint32_t itemCell(const Coord& pos) const { return inGrid(pos) ? itemGrid.get(pos.row, pos.col) : 0; }
+
+    void moveSnake(int index, int action);
+    void resolveCollisions();
+    void eatItem(int index, int itemIndex);
+    void kill(int index, ArenaDeath reason);
+    void removeDead();
+    void respawnWaiting();
+    bool spawnSnake(int index);
+    void placeItem(int itemIndex);
+    void refreshItems();
+    void generateGates();
+    void clearReplica();
+    void layInitialBody(int index);
+    static Coord grownCell(const ArenaSnake& snake);
+    void growTail(ArenaSnake& snake);
+    void moveItem(int itemIndex, const Coord& coord);
+};
+
+// 화면 없이 maxTicks 틱 동안 모든 스네이크를 기본 봇으로 진행
+ArenaStats runArenaHeadless(const ArenaOptions& options, long maxTicks);
+void printArenaStats(const ArenaStats& stats, int snakeCount, ostream& out);
+
+#endif
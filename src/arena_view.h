@@ -0,0 +1,235 @@
+#ifndef ARENA_VIEW_H
+#define ARENA_VIEW_H
+
+#include "arena.h"
+#include "frame_clock.h"
+#include <ncurses.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// 아레나 관전 / 플레이 화면 (ncurses 초기화는 호출자 담당, 색상 쌍은 Game과 같은 번호를 씀)
+// 보드가 창보다 크면 따라가는 스네이크의 머리를 가운데에 두고 창 크기만큼만 그린다.
+// 칸마다 타일 / 머리 격자 / 아이템 격자를 O(1)로 읽으므로 그리기 비용은 스네이크 수가 아니라 창 크기에 비례한다.
+//
+// 조작: 방향키 = 맡은 스네이크 조종, Tab = 따라갈 스네이크 바꾸기, p = 일시 정지, q = 종료
+// run()은 아레나를 직접 진행하고, 네트워크 클라이언트처럼 틱을 밖에서 받는 쪽은
+// begin() 뒤에 handleKey / takeAction / draw를 직접 부른다.
+class ArenaScreen
+{
+public:
+    static const int kPanelWidth = 30;
+
+    // controlledSnake: 방향키로 조종할 스네이크 번호 (-1 = 관전)
+    ArenaScreen(Arena& arena, int controlledSnake)
+        : arena(arena), controlled(controlledSnake), actions(arena.size()),
+          followed(controlledSnake >= 0 ? controlledSnake : 0) {}
+
+    void run() {
+        begin();
+        frameClock.reset();
+        while (true) {
+            int key;
+            while ((key = getch()) != ERR) {
+                if (!handleKey(key)) return;
+            }
+            if (!paused) {
+                arena.greedyActions(actions.data());
+                if (controlled >= 0) actions[controlled] = takeAction();
+                arena.step(actions.data());
+            }
+            draw();
+            frameClock.waitNextTick(paused ? 50.0 : arena.getTickPeriodMs());
+        }
+    }
+
+    void begin() {
+        initColors();
+        nodelay(stdscr, TRUE);
+        keypad(stdscr, TRUE);
+    }
+
+    // false를 반환하면 종료
+    bool handleKey(int key) {
+        switch (key) {
+            case KEY_UP: humanAction = 1; break;
+            case KEY_LEFT: humanAction = 2; break;
+            case KEY_RIGHT: humanAction = 3; break;
+            case KEY_DOWN: humanAction = 4; break;
+            case '\t':
+                followNextAlive();
+                followingOther = false;
+                break;
+            case 'p':
+            case 'P':
+                paused = !paused;
+                frameClock.reset();
+                break;
+            case 'q':
+            case 'Q':
+                return false;
+            default: break;
+        }
+        return true;
+    }
+
+    // 마지막 방향키 입력을 꺼냄 (없으면 0)
+    int takeAction() {
+        int action = humanAction;
+        humanAction = 0;
+        return action;
+    }
+
+    // 패널 맨 아래에 덧붙일 줄 (네트워크 상태 등, 빈 문자열이면 생략)
+    void setStatusLine(const string& line) { statusLine = line; }
+
+    void draw() {
+        const Map& map = arena.getMap();
+        int screenRows, screenCols;
+        getmaxyx(stdscr, screenRows, screenCols);
+        int viewRows = max(0, min(map.mapSize.height, screenRows));
+        int viewCols = max(0, min(map.mapSize.width, screenCols - kPanelWidth));
+
+        if (controlled >= 0 && followingOther && arena.snake(controlled).alive) {
+            followed = controlled;
+            followingOther = false;
+        }
+        if (!arena.snake(followed).alive) {
+            followingOther = controlled >= 0 && followed == controlled;
+            followNextAlive();
+        }
+        const ArenaSnake& target = arena.snake(followed);
+        if (target.alive) {
+            viewTop = clampView(target.head.row - viewRows / 2, viewRows, map.mapSize.height);
+            viewLeft = clampView(target.head.col - viewCols / 2, viewCols, map.mapSize.width);
+        }
+
+        erase();
+        for (int r = 0; r < viewRows; ++r) {
+            for (int c = 0; c < viewCols; ++c) {
+                chtype glyph = glyphAt({viewTop + r, viewLeft + c});
+                if (glyph != ' ') mvaddch(r, c, glyph);
+            }
+        }
+        drawPanel(viewCols + 1);
+        refresh();
+    }
+
+private:
+    Arena& arena;
+    int controlled;
+    vector<int> actions;
+    vector<int> ranking;     // 길이 순위 계산용 (프레임마다 다시 씀)
+    FrameClock frameClock;
+    string statusLine;
+    int humanAction = 0;
+    int followed;
+    bool followingOther = false; // 맡은 스네이크가 탈락해서 다른 스네이크를 따라가는 중 (부활하면 돌아감)
+    bool paused = false;
+    int viewTop = 1;
+    int viewLeft = 1;
+
+    static void initColors() {
+        if (!has_colors()) return;
+        start_color();
+        init_pair(1, COLOR_WHITE, COLOR_WHITE);   // Wall
+        init_pair(2, COLOR_BLACK, COLOR_WHITE);   // Immuned Wall
+        init_pair(3, COLOR_YELLOW, COLOR_BLACK);  // Snake Head
+        init_pair(4, COLOR_GREEN, COLOR_BLACK);   // Snake Body
+        init_pair(5, COLOR_BLUE, COLOR_BLUE);     // Growth Item
+        init_pair(6, COLOR_RED, COLOR_RED);       // Poison Item
+        init_pair(7, COLOR_BLACK, COLOR_MAGENTA); // GATE
+        init_pair(8, COLOR_YELLOW, COLOR_YELLOW); // Time Item
+    }
+
+    void followNextAlive() {
+        for (int k = 1; k <= arena.size(); ++k) {
+            int candidate = (followed + k) % arena.size();
+            if (arena.snake(candidate).alive) {
+                followed = candidate;
+                return;
+            }
+        }
+    }
+
+    static int clampView(int top, int visible, int size) {
+        return max(1, min(top, size - visible + 1));
+    }
+
+    chtype glyphAt(const Coord& pos) const {
+        const Map& map = arena.getMap();
+        int item = arena.itemAt(pos);
+        if (item >= 0) {
+            switch (arena.getItems()[item].kind) {
+                case ArenaItemKind::GROWTH: return '+' | COLOR_PAIR(5);
+                case ArenaItemKind::POISON: return '-' | COLOR_PAIR(6);
+                case ArenaItemKind::TIME: return 'T' | COLOR_PAIR(8);
+            }
+        }
+        int head = arena.headAt(pos);
+        if (head >= 0) {
+            chtype headChar = 'O';
+            switch (arena.snake(head).direction) {
+                case 1: headChar = '^'; break;
+                case 2: headChar = '<'; break;
+                case 3: headChar = '>'; break;
+                case 4: headChar = 'v'; break;
+            }
+            chtype attributes = COLOR_PAIR(3) | A_BOLD;
+            if (head == followed) attributes |= A_REVERSE;
+            return headChar | attributes;
+        }
+        for (const auto& gate : map.gameGates) {
+            if (gate.coord == pos) return ' ' | COLOR_PAIR(7);
+        }
+        if (map.bodyCountAt(pos) > 0) return 'o' | COLOR_PAIR(4);
+        switch (map.cellAt(pos)) {
+            case CellType::WALL: return ' ' | COLOR_PAIR(1);
+            case CellType::IMMUNE_WALL: return '+' | COLOR_PAIR(2);
+            default: return ' ';
+        }
+    }
+
+    void drawPanel(int left) {
+        const ArenaStats& stats = arena.getStats();
+        const ArenaSnake& target = arena.snake(followed);
+        int row = 0;
+        mvprintw(row++, left, "ARENA%s", paused ? "  (paused)" : "");
+        mvprintw(row++, left, "Tick: %ld", stats.ticks);
+        mvprintw(row++, left, "Alive: %d / %d", arena.aliveCount(), arena.size());
+        mvprintw(row++, left, "Speed: x%.1f", arena.getSpeedMultiplier());
+        mvprintw(row++, left, "Deaths H/B/W/P: %ld/%ld/%ld/%ld",
+                 stats.headOnDeaths, stats.bodyDeaths, stats.wallDeaths, stats.poisonDeaths);
+        mvprintw(row++, left, "Items eaten: %ld", stats.itemsEaten);
+        row++;
+        mvprintw(row++, left, "Following #%d%s", followed, followed == controlled ? " (YOU)" : "");
+        if (target.alive) {
+            mvprintw(row++, left, " Length: %d", static_cast<int>(target.body.size()));
+        } else {
+            mvprintw(row++, left, " Respawn in %d (%s)", target.respawnTimer, arenaDeathName(target.lastDeath));
+        }
+        mvprintw(row++, left, " Items: %d  Deaths: %d", target.itemsEaten, target.deaths);
+        row++;
+
+        // 길이 상위 5마리 (부분 정렬이라 스네이크 수에 거의 비례)
+        ranking.resize(arena.size());
+        for (int i = 0; i < arena.size(); ++i) ranking[i] = i;
+        int shown = min(5, arena.size());
+        partial_sort(ranking.begin(), ranking.begin() + shown, ranking.end(), [this](int a, int b) {
+            return arena.snake(a).body.size() > arena.snake(b).body.size();
+        });
+        mvprintw(row++, left, "Longest:");
+        for (int k = 0; k < shown; ++k) {
+            const ArenaSnake& snake = arena.snake(ranking[k]);
+            mvprintw(row++, left, " #%-5d %d", ranking[k], static_cast<int>(snake.body.size()));
+        }
+        row++;
+        if (controlled >= 0) mvprintw(row++, left, "Arrows: move #%d", controlled);
+        mvprintw(row++, left, "Tab: follow  p: pause  q: quit");
+        if (!statusLine.empty()) mvprintw(row++, left, "%s", statusLine.c_str());
+    }
+};
+
+#endif
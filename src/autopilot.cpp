@@ -0,0 +1,304 @@
+#include "autopilot.h"
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std;
+
+namespace {
+
+const int kRowDelta[5] = {0, -1, 0, 0, 1};
+const int kColDelta[5] = {0, 0, -1, 1, 0};
+
+// 창 안에서 머리 / 목표 둘레로 남겨 둘 칸 수
+const int kWindowMargin = 32;
+
+bool isOpposite(int a, int b)
+{
+    return a >= 1 && a <= 4 && b >= 1 && b <= 4 && a + b == 5;
+}
+
+// 한 축에서 창의 시작 좌표: 머리와 목표가 여유를 두고 함께 들어가면 둘의 가운데, 아니면 머리에서
+// 목표 쪽으로 최대한 뻗는 위치 (격자 밖으로 나가지 않게 맞춤)
+int windowStart(int head, int target, int size, int gridSize)
+{
+    int low = min(head, target) - kWindowMargin;
+    int high = max(head, target) + kWindowMargin;
+    int start;
+    if (high - low + 1 <= size) {
+        start = low - (size - (high - low + 1)) / 2;
+    } else if (target >= head) {
+        start = head - kWindowMargin;
+    } else {
+        start = head + kWindowMargin - size + 1;
+    }
+    return max(0, min(start, gridSize - size));
+}
+
+} // namespace
+
+bool Autopilot::PlanKey::operator==(const PlanKey& other) const
+{
+    return mapGeneration == other.mapGeneration &&
+           growthItem == other.growthItem &&
+           poisonItem == other.poisonItem &&
+           gates[0] == other.gates[0] && gates[1] == other.gates[1] &&
+           bodyLength == other.bodyLength &&
+           poisonWanted == other.poisonWanted &&
+           gateWanted == other.gateWanted;
+}
+
+Autopilot::PlanKey Autopilot::makeKey(const Simulation& sim) const
+{
+    const Map& map = sim.getMap();
+    Simulation::MissionTargets targets = sim.getCurrentMissionTargets();
+    PlanKey key;
+    key.mapGeneration = sim.getMapGeneration();
+    key.growthItem = map.growthItemObject.coord;
+    key.poisonItem = map.poisonItemObject.coord;
+    for (size_t i = 0; i < map.gameGates.size() && i < 2; ++i) {
+        key.gates[i] = map.gameGates[i].coord;
+    }
+    key.bodyLength = map.snakeHeadObject.snakeBodySegments.size();
+    // 독 아이템은 길이 미션과 최소 길이(3)를 해치지 않을 때만 목표로 삼는다
+    int length = static_cast<int>(key.bodyLength);
+    key.poisonWanted = sim.getPoisonItemCount() < targets.poisonItems &&
+                       length > 3 && length > targets.snakeLength;
+    key.gateWanted = map.gameGates.size() == 2 && sim.getGatesUsedCount() < targets.gateUses;
+    return key;
+}
+
+void Autopilot::nextVisit()
+{
+    if (++visitStamp == 0) {
+        fill(visited.begin(), visited.end(), 0u);
+        visitStamp = 1;
+    }
+}
+
+void Autopilot::placeWindow(const Map& map, const Coord& target)
+{
+    int gridRows = map.mapSize.height + 2;
+    int gridCols = map.mapSize.width + 2;
+    int newRows = min(gridRows, static_cast<int>(kMaxWindowSide));
+    int newCols = min(gridCols, static_cast<int>(kMaxWindowSide));
+    if (newRows != rows || newCols != cols) {
+        rows = newRows;
+        cols = newCols;
+        size_t cells = static_cast<size_t>(rows) * static_cast<size_t>(cols);
+        visited.assign(cells, 0u);
+        bodyStamp.assign(cells, 0u);
+        bodyFreeAt.assign(cells, 0);
+        bodyMarks.assign(cells, 0);
+        parent.assign(cells, -1);
+        arrivalDirection.assign(cells, -1);
+        pressDirection.assign(cells, -1);
+        distance.assign(cells, 0);
+        queue.reserve(cells);
+        visitStamp = 0;
+        bodyEpoch = 0;
+    }
+    windowClipped = rows < gridRows || cols < gridCols;
+    const Coord& head = map.snakeHeadObject.coord;
+    top = windowStart(head.row, target.row, rows, gridRows);
+    left = windowStart(head.col, target.col, cols, gridCols);
+}
+
+void Autopilot::prepare(const Simulation& sim, const Coord& target)
+{
+    const Map& map = sim.getMap();
+    placeWindow(map, target);
+    if (++bodyEpoch == 0) {
+        fill(bodyStamp.begin(), bodyStamp.end(), 0u);
+        bodyEpoch = 1;
+    }
+
+    // 목(0번)부터 i번째 몸통 칸은 (길이 - i)틱 뒤에 비워진다. 창 안의 경로는 창 칸 수보다 길 수 없으므로
+    // 그 안에 비는 꼬리 쪽 칸만 표시하고, 나머지 몸통은 isOpenAt에서 맵의 몸통 수로 막는다.
+    const SnakeBodyRing& body = map.snakeHeadObject.snakeBodySegments;
+    int length = static_cast<int>(body.size());
+    int first = max(0, length - rows * cols);
+    for (int i = first; i < length; ++i) {
+        const Coord& pos = body[static_cast<size_t>(i)];
+        if (!inWindow(pos)) continue;
+        int cell = index(pos);
+        int freeAt = length - i;
+        if (bodyStamp[cell] != bodyEpoch) {
+            bodyStamp[cell] = bodyEpoch;
+            bodyFreeAt[cell] = freeAt;
+            bodyMarks[cell] = 1;
+        } else {
+            bodyFreeAt[cell] = max(bodyFreeAt[cell], freeAt);
+            bodyMarks[cell]++;
+        }
+    }
+}
+
+bool Autopilot::isOpenAt(const Map& map, int cell, int tick, bool allowPoison) const
+{
+    Coord pos = coordOf(cell);
+    if (map.cellAt(pos) != CellType::EMPTY) return false;
+    if (bodyStamp[cell] == bodyEpoch) {
+        if (bodyFreeAt[cell] > tick || map.bodyCountAt(pos) > bodyMarks[cell]) return false;
+    } else if (map.bodyCountAt(pos) > 0) {
+        return false;
+    }
+    if (!allowPoison && pos == map.poisonItemObject.coord) return false;
+    return true;
+}
+
+bool Autopilot::search(const Simulation& sim, const PlanKey& key)
+{
+    searchCount++;
+    prepare(sim, key.growthItem);
+    nextVisit();
+
+    const Map& map = sim.getMap();
+    const SnakeHead& head = map.snakeHeadObject;
+    int start = index(head.coord);
+    visited[start] = visitStamp;
+    parent[start] = -1;
+    arrivalDirection[start] = head.currentDirection;
+    distance[start] = 0;
+    queue.clear();
+    queue.push_back(start);
+
+    int goal = -1;
+    for (size_t front = 0; front < queue.size() && goal < 0; ++front) {
+        int cell = queue[front];
+        Coord pos = coordOf(cell);
+        int tick = distance[cell] + 1;
+        for (int d = 1; d <= 4 && goal < 0; ++d) {
+            if (isOpposite(d, arrivalDirection[cell])) continue;
+
+            Coord next{pos.row + kRowDelta[d], pos.col + kColDelta[d]};
+            int nextDirection = d;
+            bool viaGate = false;
+            for (size_t g = 0; g < map.gameGates.size() && map.gameGates.size() == 2; ++g) {
+                if (map.gameGates[g].coord != next) continue;
+                // 게이트로 들어가면 반대쪽 게이트의 출구로 나온다 (막혀 있으면 이 방향은 포기)
+                if (!sim.findGateExit(map.gameGates[1 - g], d, next, nextDirection)) {
+                    next = map.gameGates[g].coord;
+                    nextDirection = -1;
+                }
+                viaGate = true;
+                break;
+            }
+            if (nextDirection < 0) continue;
+            if (!inWindow(next)) continue;
+
+            int nextCell = index(next);
+            if (visited[nextCell] == visitStamp) continue;
+            if (!isOpenAt(map, nextCell, tick, key.poisonWanted)) continue;
+
+            visited[nextCell] = visitStamp;
+            parent[nextCell] = cell;
+            distance[nextCell] = tick;
+            arrivalDirection[nextCell] = nextDirection;
+            pressDirection[nextCell] = d;
+            queue.push_back(nextCell);
+
+            if (next == key.growthItem ||
+                (key.poisonWanted && next == key.poisonItem) ||
+                (key.gateWanted && viaGate)) {
+                goal = nextCell;
+            }
+        }
+    }
+    // 창이 보드보다 작으면 목표가 창 밖이거나 창 밖으로 돌아가야 할 수 있다: 목표 쪽 가장자리까지 진행
+    if (goal < 0 && windowClipped) goal = frontierGoal(map, key.growthItem);
+    if (goal < 0) return false;
+
+    plan.clear();
+    for (int cell = goal; cell != start; cell = parent[cell]) {
+        plan.push_back({pressDirection[cell], coordOf(cell)});
+    }
+    reverse(plan.begin(), plan.end());
+    planCursor = 0;
+    planKey = key;
+    return true;
+}
+
+int Autopilot::frontierGoal(const Map& map, const Coord& target) const
+{
+    // 이번 탐색에서 닿은 칸 중 격자 안쪽으로 이어지는 창 가장자리 칸, 목표와의 맨해튼 거리가 가장 짧은 것
+    // (같으면 먼저 닿은 칸)
+    int gridRows = map.mapSize.height + 2;
+    int gridCols = map.mapSize.width + 2;
+    int best = -1;
+    int bestDistance = 0;
+    for (size_t i = 1; i < queue.size(); ++i) {
+        int cell = queue[i];
+        Coord pos = coordOf(cell);
+        bool edge = (pos.row == top && top > 0) || (pos.row == top + rows - 1 && top + rows < gridRows) ||
+                    (pos.col == left && left > 0) || (pos.col == left + cols - 1 && left + cols < gridCols);
+        if (!edge) continue;
+        int toTarget = abs(pos.row - target.row) + abs(pos.col - target.col);
+        if (best < 0 || toTarget < bestDistance) {
+            best = cell;
+            bestDistance = toTarget;
+        }
+    }
+    return best;
+}
+
+int Autopilot::fallbackDirection(const Simulation& sim)
+{
+    // 목표까지 길이 없으면 갈 수 있는 칸이 가장 넓은 쪽으로 버틴다
+    const Map& map = sim.getMap();
+    const SnakeHead& head = map.snakeHeadObject;
+    int currentDirection = head.currentDirection;
+    int bestDirection = (currentDirection >= 1 && currentDirection <= 4) ? currentDirection : 1;
+    long bestArea = -1;
+
+    for (int d = 1; d <= 4; ++d) {
+        if (isOpposite(d, currentDirection)) continue;
+        Coord next{head.coord.row + kRowDelta[d], head.coord.col + kColDelta[d]};
+        if (!inWindow(next)) continue;
+        int start = index(next);
+        if (!isOpenAt(map, start, 1, false)) continue;
+
+        nextVisit();
+        visited[start] = visitStamp;
+        distance[start] = 1;
+        queue.clear();
+        queue.push_back(start);
+        for (size_t front = 0; front < queue.size(); ++front) {
+            int cell = queue[front];
+            Coord pos = coordOf(cell);
+            for (int n = 1; n <= 4; ++n) {
+                Coord around{pos.row + kRowDelta[n], pos.col + kColDelta[n]};
+                if (!inWindow(around)) continue;
+                int aroundCell = index(around);
+                if (visited[aroundCell] == visitStamp) continue;
+                if (!isOpenAt(map, aroundCell, distance[cell] + 1, false)) continue;
+                visited[aroundCell] = visitStamp;
+                distance[aroundCell] = distance[cell] + 1;
+                queue.push_back(aroundCell);
+            }
+        }
+        long area = static_cast<long>(queue.size());
+        if (area > bestArea) {
+            bestArea = area;
+            bestDirection = d;
+        }
+    }
+    return bestDirection;
+}
+
+int Autopilot::chooseDirection(const Simulation& sim)
+{
+    PlanKey key = makeKey(sim);
+    const Coord& head = sim.getMap().snakeHeadObject.coord;
+
+    if (planCursor < plan.size() && key == planKey && head == expectedHead) {
+        reuseCount++;
+    } else if (!search(sim, key)) {
+        plan.clear();
+        planCursor = 0;
+        return fallbackDirection(sim);
+    }
+
+    const PlanStep& step = plan[planCursor++];
+    expectedHead = step.head;
+    return step.direction;
+}
@@ -0,0 +1,92 @@
+#ifndef AUTOPILOT_H
+#define AUTOPILOT_H
+
+#include "simulation.h"
+#include <vector>
+
+using namespace std;
+
+// 자동 조종: 머리에서 목표(성장 아이템, 미션에 필요하면 독 아이템 / 게이트)까지 너비 우선 탐색
+// - 벽은 지나갈 수 없고, 게이트 칸은 Simulation::findGateExit과 같은 규칙으로 출구로 이어진다.
+// - 몸통 칸은 머리가 도착하는 시점에 꼬리가 이미 빠져나간 경우에만 지나갈 수 있다.
+// - 독 아이템은 독 미션이 남아 있고 길이가 충분할 때만 밟는다.
+// 찾은 경로는 계획으로 보관해 두고, 머리가 예상 위치에 있고 아이템 / 게이트 / 길이 / 맵이
+// 그대로면 다음 틱에 다시 탐색하지 않고 이어서 사용한다.
+// 탐색은 머리와 성장 아이템을 감싸는 최대 kMaxWindowSide x kMaxWindowSide 창 안에서만 하므로 한 번에
+// 방문하는 칸 수(와 버퍼 크기)가 보드 넓이와 무관하다. 창이 보드보다 작아 목표를 찾지 못하면 목표에
+// 가장 가까운 창 가장자리 칸까지를 계획으로 삼아 따라가고, 도착하면 그 자리에서 다시 탐색한다.
+class Autopilot
+{
+public:
+    static const int kMaxWindowSide = 512;   // 탐색 한 번에 방문하는 칸은 최대 512x512개
+
+    // 이번 틱에 누를 방향 (1=위, 2=왼쪽, 3=오른쪽, 4=아래). 바꿀 필요가 없으면 현재 방향
+    int chooseDirection(const Simulation& sim);
+    // 저장된 계획을 버리고 다음 틱에 새로 탐색
+    void invalidate() { plan.clear(); }
+
+    long getSearchCount() const { return searchCount; }
+    long getReuseCount() const { return reuseCount; }
+
+private:
+    struct PlanStep {
+        int direction;   // 누를 방향
+        Coord head;      // 이동 후 머리 위치
+    };
+
+    // 계획이 만들어질 때의 조건 (하나라도 바뀌면 다시 탐색)
+    struct PlanKey {
+        unsigned long mapGeneration = 0;
+        Coord growthItem{0, 0};
+        Coord poisonItem{0, 0};
+        Coord gates[2] = {{0, 0}, {0, 0}};
+        size_t bodyLength = 0;
+        bool poisonWanted = false;
+        bool gateWanted = false;
+
+        bool operator==(const PlanKey& other) const;
+    };
+
+    vector<PlanStep> plan;
+    size_t planCursor = 0;
+    Coord expectedHead{0, 0};
+    PlanKey planKey;
+
+    // 탐색 창 (격자 좌표 top / left부터 rows x cols 칸)과 창 크기만큼 한 번 할당하는 탐색용 버퍼
+    // (방문 표시는 세대 번호로 초기화 생략)
+    int top = 0;
+    int left = 0;
+    int rows = 0;
+    int cols = 0;
+    bool windowClipped = false; // 창이 격자 전체를 덮지 못함
+    unsigned visitStamp = 0;    // 탐색마다 증가
+    unsigned bodyEpoch = 0;     // prepare마다 증가
+    vector<unsigned> visited;
+    vector<unsigned> bodyStamp;
+    vector<int> bodyFreeAt;     // 몸통 칸이 비는 틱 (머리가 그 이후에 도착해야 안전)
+    vector<int> bodyMarks;      // 그 칸에 표시한 몸통 수 (맵의 몸통 수보다 적으면 탐색 중에 비지 않는 칸이 겹침)
+    vector<int> parent;
+    vector<int> arrivalDirection;   // 칸에 도착했을 때의 진행 방향 (게이트 통과 시 출구 방향)
+    vector<int> pressDirection;     // 그 칸으로 가기 위해 누른 방향
+    vector<int> distance;
+    vector<int> queue;
+
+    long searchCount = 0;
+    long reuseCount = 0;
+
+    PlanKey makeKey(const Simulation& sim) const;
+    void placeWindow(const Map& map, const Coord& target);
+    void prepare(const Simulation& sim, const Coord& target);
+    void nextVisit();
+    bool search(const Simulation& sim, const PlanKey& key);
+    int frontierGoal(const Map& map, const Coord& target) const;
+    int fallbackDirection(const Simulation& sim);
+    bool isOpenAt(const Map& map, int index, int tick, bool allowPoison) const;
+    bool inWindow(const Coord& pos) const {
+        return pos.row >= top && pos.row < top + rows && pos.col >= left && pos.col < left + cols;
+    }
+    int index(const Coord& pos) const { return (pos.row - top) * cols + (pos.col - left); }
+    Coord coordOf(int cell) const { return {top + cell / cols, left + cell % cols}; }
+};
+
+#endif
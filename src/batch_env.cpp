@@ -0,0 +1,430 @@
+#include "batch_env.h"
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+const int kDirRow[5] = {0, -1, 0, 0, 1};
+const int kDirCol[5] = {0, 0, -1, 1, 0};
+}
+
+BatchEnv::BatchEnv(int gameCount, int startStage, uint64_t seed)
+    : gameCount(gameCount)
+{
+    const Map& templateMap = scratch.getMap();
+    mapHeight = templateMap.mapSize.height;
+    mapWidth = templateMap.mapSize.width;
+    rows = mapHeight + 2;
+    cols = mapWidth + 2;
+    cellCount = static_cast<size_t>(rows) * cols;
+    if (cellCount > 0xFFFF) {
+        throw std::invalid_argument("BatchEnv supports boards up to 65535 cells");
+    }
+    // 몸통 링은 게임마다 고정 크기 (셀 수 이상인 2의 거듭제곱)
+    ringCapacity = 1;
+    while (ringCapacity < cellCount) ringCapacity <<= 1;
+    ringMask = ringCapacity - 1;
+
+    size_t n = static_cast<size_t>(gameCount);
+    headRow.assign(n, 0); headCol.assign(n, 0); direction.assign(n, -1);
+    bodyRing.assign(n * ringCapacity, 0);
+    bodyStart.assign(n, 0); bodyLength.assign(n, 0);
+    occupancy.assign(n * cellCount, 0);
+    bodyOnWall.assign(n, 0); bodyOnImmuneWall.assign(n, 0);
+    growthRow.assign(n, 0); growthCol.assign(n, 0);
+    poisonRow.assign(n, 0); poisonCol.assign(n, 0);
+    timeRow.assign(n, 0); timeCol.assign(n, 0);
+    gateRow.assign(n * 2, 0); gateCol.assign(n * 2, 0); gateExit.assign(n * 2, 6);
+    gateActive.assign(n, 0); gateDuration.assign(n, 0);
+    stage.assign(n, startStage);
+    growthTimer.assign(n, 0); poisonTimer.assign(n, 0); timeTimer.assign(n, 0);
+    speedBoost.assign(n, 0); tickCount.assign(n, 0);
+    speedMultiplier.assign(n, 1.0f);
+    growthCount.assign(n, 0); poisonCount.assign(n, 0); gatesUsed.assign(n, 0); maxLength.assign(n, 3);
+    stageCleared.assign(n, 0);
+    rngs.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        rngs.emplace_back(seed + i);
+    }
+
+    for (int i = 0; i < gameCount; ++i) {
+        resetGame(i, startStage);
+    }
+}
+
+Coord BatchEnv::bodySegment(int game, int index) const
+{
+    int cell = bodyRing[game * ringCapacity + ((bodyStart[game] + index) & ringMask)];
+    return Coord{cell / cols, cell % cols};
+}
+
+CellType BatchEnv::cellAt(int game, int row, int col) const
+{
+    if (row < 0 || row >= rows || col < 0 || col >= cols) return CellType::IMMUNE_WALL;
+    return layers[stage[game]].cells[row * cols + col];
+}
+
+int BatchEnv::occupancyAt(int game, int row, int col) const
+{
+    if (row < 0 || row >= rows || col < 0 || col >= cols) return 0;
+    return occupancy[game * cellCount + row * cols + col];
+}
+
+bool BatchEnv::isGate(int game, int row, int col) const
+{
+    return (gateRow[game * 2] == row && gateCol[game * 2] == col) ||
+           (gateRow[game * 2 + 1] == row && gateCol[game * 2 + 1] == col);
+}
+
+void BatchEnv::markBody(int game, int row, int col, int delta)
+{
+    CellType cell = cellAt(game, row, col);
+    if (cell == CellType::WALL) bodyOnWall[game] += delta;
+    else if (cell == CellType::IMMUNE_WALL) bodyOnImmuneWall[game] += delta;
+    if (row >= 0 && row < rows && col >= 0 && col < cols) {
+        occupancy[game * cellCount + row * cols + col] += delta;
+    }
+}
+
+void BatchEnv::pushFront(int game, int row, int col)
+{
+    if (static_cast<size_t>(bodyLength[game]) == ringCapacity) return;
+    bodyStart[game] = (bodyStart[game] + ringMask) & ringMask;
+    bodyRing[game * ringCapacity + bodyStart[game]] = static_cast<unsigned short>(row * cols + col);
+    bodyLength[game]++;
+    markBody(game, row, col, +1);
+}
+
+void BatchEnv::pushBack(int game, int row, int col)
+{
+    if (static_cast<size_t>(bodyLength[game]) == ringCapacity) return;
+    bodyRing[game * ringCapacity + ((bodyStart[game] + bodyLength[game]) & ringMask)] =
+        static_cast<unsigned short>(row * cols + col);
+    bodyLength[game]++;
+    markBody(game, row, col, +1);
+}
+
+void BatchEnv::popBack(int game)
+{
+    if (bodyLength[game] == 0) return;
+    Coord tail = bodySegment(game, bodyLength[game] - 1);
+    markBody(game, tail.row, tail.col, -1);
+    bodyLength[game]--;
+}
+
+void BatchEnv::resetGame(int game, int newStage)
+{
+    // 맵 / 아이템 / 게이트는 Simulation의 초기화 규칙을 그대로 사용 (게임별 난수 스트림에서 시드 파생)
+    scratch.reseed(rngs[game].next64());
+    scratch.jumpToStage(newStage);
+    const Map& map = scratch.getMap();
+
+    StageLayer& layer = layers[newStage];
+    if (!layer.built) {
+        layer.cells.resize(cellCount);
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < cols; ++c) {
+                layer.cells[r * cols + c] = map.cellAt({r, c});
+            }
+        }
+        for (int r = 2; r <= mapHeight; ++r) {
+            for (int c = 2; c <= mapWidth; ++c) {
+                if (map.isSpawnEligible({r, c})) layer.spawnCells.push_back(static_cast<unsigned short>(r * cols + c));
+            }
+        }
+        layer.map = map;
+        layer.built = true;
+    }
+
+    // 이전 몸통 점유 제거
+    while (bodyLength[game] > 0) {
+        popBack(game);
+    }
+    bodyStart[game] = 0;
+    bodyOnWall[game] = 0;
+    bodyOnImmuneWall[game] = 0;
+    stage[game] = newStage;
+
+    const SnakeHead& head = map.snakeHeadObject;
+    headRow[game] = head.coord.row;
+    headCol[game] = head.coord.col;
+    direction[game] = head.currentDirection;
+    for (const auto& body : head.snakeBodySegments) {
+        pushBack(game, body.row, body.col);
+    }
+
+    growthRow[game] = map.growthItemObject.coord.row;
+    growthCol[game] = map.growthItemObject.coord.col;
+    poisonRow[game] = map.poisonItemObject.coord.row;
+    poisonCol[game] = map.poisonItemObject.coord.col;
+    timeRow[game] = map.timeItemObject.coord.row;
+    timeCol[game] = map.timeItemObject.coord.col;
+
+    for (int g = 0; g < 2; ++g) {
+        gateRow[game * 2 + g] = map.gameGates[g].coord.row;
+        gateCol[game * 2 + g] = map.gameGates[g].coord.col;
+        gateExit[game * 2 + g] = map.gameGates[g].exitDirection;
+    }
+    gateActive[game] = 0;
+    gateDuration[game] = 0;
+
+    growthTimer[game] = 0;
+    poisonTimer[game] = 0;
+    timeTimer[game] = 0;
+    tickCount[game] = 0;
+    speedMultiplier[game] = 1.0f;
+    growthCount[game] = 0;
+    poisonCount[game] = 0;
+    gatesUsed[game] = 0;
+    maxLength[game] = 3;
+    stageCleared[game] = 0;
+}
+
+void BatchEnv::spawnItem(int game, int& outRow, int& outCol)
+{
+    // 후보는 Simulation::generateRandCoord와 같음: Map::isSpawnEligible인 칸 중 몸통 / 머리 / 아이템이 없는 칸
+    // (출력 인자가 아이템 좌표 자신일 수 있어 지역 변수 사용)
+    const vector<unsigned short>& spawnCells = layers[stage[game]].spawnCells;
+    auto isSpawnable = [&](int row, int col) {
+        return occupancyAt(game, row, col) == 0 &&
+               !(headRow[game] == row && headCol[game] == col) &&
+               !(growthRow[game] == row && growthCol[game] == col) &&
+               !(poisonRow[game] == row && poisonCol[game] == col) &&
+               !(timeRow[game] == row && timeCol[game] == col);
+    };
+    if (spawnCells.empty()) {
+        outRow = Map::parkedCoord().row;
+        outCol = Map::parkedCoord().col;
+        return;
+    }
+
+    // 첫 단계는 Map::pickFreeCell과 같은 추출 (스폰 가능 칸 중 균등). 게임별 빈 셀 집합은 두지 않으므로
+    // 추출이 연달아 실패하면 (보드가 거의 참) 스폰 가능 칸을 직접 훑어 균등 추출
+    const int kMaxAttempts = 16;
+    const uint32_t eligibleCount = static_cast<uint32_t>(spawnCells.size());
+    for (int attempt = 0; attempt < kMaxAttempts; ++attempt) {
+        int cell = spawnCells[rngs[game].nextBelow(eligibleCount)];
+        if (isSpawnable(cell / cols, cell % cols)) {
+            outRow = cell / cols;
+            outCol = cell % cols;
+            return;
+        }
+    }
+    int candidateCount = 0;
+    Coord picked = Map::parkedCoord();
+    for (int cell : spawnCells) {
+        if (!isSpawnable(cell / cols, cell % cols)) continue;
+        // 저수지 표본 추출: 후보 목록 없이 균등하게 하나 선택
+        if (rngs[game].nextBelow(static_cast<uint32_t>(++candidateCount)) == 0) {
+            picked = {cell / cols, cell % cols};
+        }
+    }
+    outRow = picked.row;
+    outCol = picked.col;
+}
+
+void BatchEnv::growTail(int game)
+{
+    int length = bodyLength[game];
+    if (length < 2) {
+        pushBack(game, headRow[game] + 1, headCol[game]);
+        return;
+    }
+    Coord last = bodySegment(game, length - 1);
+    Coord sec = bodySegment(game, length - 2);
+    pushBack(game, last.row - (sec.row - last.row), last.col - (sec.col - last.col));
+}
+
+void BatchEnv::applyDirection(int game, int newDirection)
+{
+    int currentDir = direction[game];
+    if (currentDir == newDirection) return;
+    if (currentDir >= 1 && currentDir <= 4 && currentDir + newDirection == 5) {
+        direction[game] = -2; // 역방향 시도 표시
+        return;
+    }
+    direction[game] = newDirection;
+}
+
+bool BatchEnv::isValid(int game) const
+{
+    if (direction[game] == -2) return false;
+    int row = headRow[game];
+    int col = headCol[game];
+    bool isOnActiveGate = gateActive[game] && isGate(game, row, col);
+    if (!isOnActiveGate && cellAt(game, row, col) != CellType::EMPTY) return false;
+    if (bodyOnWall[game] > 0 || bodyOnImmuneWall[game] > 0) return false;
+    if (occupancyAt(game, row, col) > 0) return false;
+    return bodyLength[game] >= 3;
+}
+
+StepStatus BatchEnv::stepGame(int game, int action)
+{
+    if (action >= 1 && action <= 4) {
+        applyDirection(game, action);
+    }
+    if (stageCleared[game]) {
+        return StepStatus::STAGE_CLEAR;
+    }
+    if (direction[game] == -2) {
+        return StepStatus::GAME_OVER;
+    }
+
+    // 게이트 활성 시간 감소
+    if (gateDuration[game] == 0) gateActive[game] = 0;
+    else gateDuration[game]--;
+
+    // 몸통 이동 후 머리 이동
+    int dir = direction[game];
+    if (dir >= 1 && dir <= 4) {
+        popBack(game);
+        pushFront(game, headRow[game], headCol[game]);
+        headRow[game] += kDirRow[dir];
+        headCol[game] += kDirCol[dir];
+    }
+
+    // 게이트 통과 처리 (출구는 Simulation::update와 같이 Map::findGateExit로 계산)
+    for (int g = 0; g < 2; ++g) {
+        int idx = game * 2 + g;
+        if (gateRow[idx] != headRow[game] || gateCol[idx] != headCol[game]) continue;
+
+        gateActive[game] = 1;
+        gateDuration[game] = bodyLength[game];
+        int other = game * 2 + (1 - g);
+        Gate exitGate(gateRow[other], gateCol[other]);
+        exitGate.exitDirection = gateExit[other];
+        Coord exitPosition;
+        int exitDirection;
+        layers[stage[game]].map.findGateExit(exitGate, direction[game], exitPosition, exitDirection);
+
+        headRow[game] = exitPosition.row;
+        headCol[game] = exitPosition.col;
+        direction[game] = exitDirection;
+        gatesUsed[game]++;
+        break;
+    }
+
+    // 아이템 50틱마다 재생성
+    if (growthTimer[game] >= 50) { spawnItem(game, growthRow[game], growthCol[game]); growthTimer[game] = 0; }
+    if (poisonTimer[game] >= 50) { spawnItem(game, poisonRow[game], poisonCol[game]); poisonTimer[game] = 0; }
+    if (timeTimer[game] >= 50) { spawnItem(game, timeRow[game], timeCol[game]); timeTimer[game] = 0; }
+
+    int row = headRow[game];
+    int col = headCol[game];
+    if (row == growthRow[game] && col == growthCol[game]) {
+        growthCount[game]++;
+        spawnItem(game, growthRow[game], growthCol[game]);
+        growthTimer[game] = 0;
+        growTail(game);
+    }
+    if (row == poisonRow[game] && col == poisonCol[game]) {
+        poisonCount[game]++;
+        spawnItem(game, poisonRow[game], poisonCol[game]);
+        poisonTimer[game] = 0;
+        if (bodyLength[game] <= 3) {
+            return StepStatus::GAME_OVER;
+        }
+        popBack(game);
+    }
+    if (row == timeRow[game] && col == timeCol[game]) {
+        spawnItem(game, timeRow[game], timeCol[game]);
+        timeTimer[game] = 0;
+        speedMultiplier[game] = 1.5f;
+        speedBoost[game] = 40;
+    }
+
+    // 미션 확인
+    Simulation::MissionTargets targets = Simulation::getMissionTargets(stage[game]);
+    stageCleared[game] = bodyLength[game] >= targets.snakeLength &&
+                         growthCount[game] >= targets.growthItems &&
+                         poisonCount[game] >= targets.poisonItems &&
+                         gatesUsed[game] >= targets.gateUses;
+    if (bodyLength[game] > maxLength[game]) maxLength[game] = bodyLength[game];
+
+    if (!isValid(game)) {
+        return StepStatus::GAME_OVER;
+    }
+
+    if (direction[game] != -1) {
+        growthTimer[game]++;
+        poisonTimer[game]++;
+        timeTimer[game]++;
+        if (speedBoost[game] > 0 && --speedBoost[game] == 0) {
+            speedMultiplier[game] = 1.0f;
+        }
+        tickCount[game]++;
+    }
+    return StepStatus::RUNNING;
+}
+
+void BatchEnv::step(const int* actions, StepStatus* statuses)
+{
+    stepRange(0, gameCount, actions, statuses);
+}
+
+void BatchEnv::stepGreedy(StepStatus* statuses)
+{
+    // 블록 단위로 행동 계산과 진행을 묶어 블록의 상태가 캐시에 남아 있을 때 처리
+    int actions[kBlockSize];
+    for (int first = 0; first < gameCount; first += kBlockSize) {
+        int last = first + kBlockSize < gameCount ? first + kBlockSize : gameCount;
+        greedyRange(first, last, actions);
+        stepRange(first, last, actions, statuses);
+    }
+}
+
+void BatchEnv::stepRange(int first, int last, const int* actions, StepStatus* statuses)
+{
+    for (int i = first; i < last; ++i) {
+        StepStatus status = stepGame(i, actions ? actions[i - first] : 0);
+        if (statuses) statuses[i] = status;
+        if (status == StepStatus::GAME_OVER) {
+            gameOverCount++;
+            resetGame(i, stage[i]);
+        } else if (status == StepStatus::STAGE_CLEAR) {
+            stageClearCount++;
+            int next = stage[i] + 1;
+            if (next > Simulation::kFinalStage) {
+                finishedRunCount++;
+                next = 1;
+            }
+            resetGame(i, next);
+        }
+    }
+    stepsTaken += last - first;
+}
+
+void BatchEnv::greedyActions(int* actions) const
+{
+    greedyRange(0, gameCount, actions);
+}
+
+void BatchEnv::greedyRange(int first, int last, int* actions) const
+{
+    for (int i = first; i < last; ++i) {
+        Simulation::MissionTargets targets = Simulation::getMissionTargets(stage[i]);
+        bool wantsPoison = poisonCount[i] < targets.poisonItems &&
+                           growthCount[i] >= targets.growthItems &&
+                           bodyLength[i] > targets.snakeLength;
+        int targetRow = wantsPoison ? poisonRow[i] : growthRow[i];
+        int targetCol = wantsPoison ? poisonCol[i] : growthCol[i];
+        int currentDir = direction[i];
+
+        int bestDir = (currentDir >= 1 && currentDir <= 4) ? currentDir : 0;
+        int bestDistance = -1;
+        for (int d = 1; d <= 4; ++d) {
+            if (currentDir >= 1 && currentDir <= 4 && d + currentDir == 5) continue;
+            int r = headRow[i] + kDirRow[d];
+            int c = headCol[i] + kDirCol[d];
+            if (cellAt(i, r, c) != CellType::EMPTY && !isGate(i, r, c)) continue;
+            if (occupancyAt(i, r, c) > 0) continue;
+            if (!wantsPoison && r == poisonRow[i] && c == poisonCol[i]) continue;
+            int distance = abs(r - targetRow) + abs(c - targetCol);
+            if (bestDistance < 0 || distance < bestDistance) {
+                bestDistance = distance;
+                bestDir = d;
+            }
+        }
+        actions[i - first] = bestDir;
+    }
+}
@@ -0,0 +1,126 @@
+#ifndef BATCH_ENV_H
+#define BATCH_ENV_H
+
+#include "simulation.h"
+#include <vector>
+
+using namespace std;
+
+// 여러 게임을 구조체 배열(SoA) 형태로 보관하고 한 번에 진행하는 배치 엔진
+// 이동 / 충돌 / 아이템 효과 / 성장 / 미션은 Simulation::tick을 따르고, 아이템 후보 칸(Map::isSpawnEligible)과
+// 게이트 출구(Map::findGateExit)는 스테이지 맵의 함수를 그대로 쓴다. 끝난 게임은 제자리에서 초기화된다.
+// (게임 오버 → 같은 스테이지 재시작, 스테이지 클리어 → 다음 스테이지, 마지막 스테이지 클리어 → 1스테이지)
+// Simulation과 다른 점:
+//   - 아이템 추출의 첫 단계는 Map::pickFreeCell과 같지만, 게임별 빈 셀 집합이 없어 추출이 연달아 실패하면
+//     후보를 직접 훑으므로 그 뒤의 난수 소비가 다르다. 게임별 난수 스트림도 달라 Simulation과 궤적이 같지 않다.
+//   - 놓을 칸이 없는 아이템은 보드 밖에 두고 게임을 계속한다 (Simulation은 board full로 끝냄).
+//   - 기본 크기 내장 스테이지만 지원한다 (보드 크기 / 스테이지 팩 / 절차적 맵 제외).
+class BatchEnv
+{
+public:
+    // seed: 게임별 난수 생성기를 파생시키는 기준 시드
+    BatchEnv(int gameCount, int startStage = 1, uint64_t seed = 0);
+
+    int size() const { return gameCount; }
+
+    // actions[i]: 0=입력 없음, 1~4=방향 / statuses[i]에 이번 틱 결과 기록 (nullptr 허용)
+    void step(const int* actions, StepStatus* statuses);
+
+    // Simulation::resetCurrentStage와 같은 규칙으로 i번째 게임을 초기화
+    void resetGame(int game, int stage);
+
+    // 내장 그리디 봇의 행동을 모든 게임에 대해 계산
+    void greedyActions(int* actions) const;
+    // 그리디 봇 행동 계산과 진행을 블록 단위로 묶어서 한 틱 진행
+    void stepGreedy(StepStatus* statuses);
+
+    // 구조체 배열 접근자
+    const vector<int>& headRows() const { return headRow; }
+    const vector<int>& headCols() const { return headCol; }
+    const vector<int>& directions() const { return direction; }
+    const vector<int>& bodyLengths() const { return bodyLength; }
+    const vector<int>& stages() const { return stage; }
+    const vector<int>& growthCounts() const { return growthCount; }
+    const vector<int>& poisonCounts() const { return poisonCount; }
+    const vector<int>& gateCounts() const { return gatesUsed; }
+    const vector<int>& maxLengths() const { return maxLength; }
+    const vector<int>& tickCounts() const { return tickCount; }
+    Coord bodySegment(int game, int index) const;
+
+    long totalSteps() const { return stepsTaken; }
+    long gameOvers() const { return gameOverCount; }
+    long stageClears() const { return stageClearCount; }
+    // 마지막 스테이지까지 클리어해 끝난 실행 수 (이후 1스테이지부터 새 게임)
+    long finishedRuns() const { return finishedRunCount; }
+
+private:
+    // 스테이지별 정적 벽 계층과 규칙 조회용 맵 (스테이지 맵은 결정적이므로 한 번만 만든다)
+    struct StageLayer {
+        bool built = false;
+        vector<CellType> cells;
+        vector<unsigned short> spawnCells; // Map::isSpawnEligible인 칸 (칸 번호 오름차순)
+        Map map;
+    };
+
+    static const int kBlockSize = 64;
+
+    int gameCount;
+    int rows;          // 격자 행 수 (height + 2)
+    int cols;          // 격자 열 수 (width + 2)
+    int mapHeight;
+    int mapWidth;
+    size_t cellCount;
+    size_t ringCapacity;
+    size_t ringMask;
+
+    StageLayer layers[Simulation::kFinalStage + 1];
+    Simulation scratch; // 초기화 규칙 재사용용
+
+    // 스네이크
+    vector<int> headRow, headCol, direction;
+    vector<unsigned short> bodyRing;   // game * ringCapacity, 셀 인덱스(row * cols + col)
+    vector<size_t> bodyStart;
+    vector<int> bodyLength;
+    vector<unsigned char> occupancy;   // game * cellCount (몸통 개수)
+    vector<int> bodyOnWall, bodyOnImmuneWall;
+
+    // 게임별 난수 생성기
+    vector<Rng> rngs;
+
+    // 아이템
+    vector<int> growthRow, growthCol, poisonRow, poisonCol, timeRow, timeCol;
+
+    // 게이트 (게임당 2개)
+    vector<int> gateRow, gateCol, gateExit;
+    vector<unsigned char> gateActive;
+    vector<int> gateDuration;
+
+    // 타이머와 미션 카운터
+    vector<int> stage, growthTimer, poisonTimer, timeTimer, speedBoost, tickCount;
+    vector<float> speedMultiplier;
+    vector<int> growthCount, poisonCount, gatesUsed, maxLength;
+    vector<unsigned char> stageCleared;
+
+    long stepsTaken = 0;
+    long gameOverCount = 0;
+    long stageClearCount = 0;
+    long finishedRunCount = 0;
+
+    CellType cellAt(int game, int row, int col) const;
+    int occupancyAt(int game, int row, int col) const;
+    bool isGate(int game, int row, int col) const;
+    void markBody(int game, int row, int col, int delta);
+    void pushFront(int game, int row, int col);
+    void pushBack(int game, int row, int col);
+    void popBack(int game);
+    void spawnItem(int game, int& outRow, int& outCol);
+    void growTail(int game);
+    bool isValid(int game) const;
+    StepStatus stepGame(int game, int action);
+    // actions 배열의 0번은 first번 게임에 대응 (statuses는 전체 게임 인덱스)
+    void stepRange(int first, int last, const int* actions, StepStatus* statuses);
+    void greedyRange(int first, int last, int* actions) const;
+    void applyDirection(int game, int newDirection);
+};
+
+#endif
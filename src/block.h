@@ -24,13 +24,13 @@ struct Coord
         return (row < other.row) || (row == other.row && col < other.col);
     }
     
-    // 좌표 유효성 검사
-    bool isValid(int maxRow = 100, int maxCol = 100) const {
+    // 좌표 유효성 검사 (보드 크기는 실행 시 정해지므로 범위를 항상 넘겨받음)
+    bool isValid(int maxRow, int maxCol) const {
         return row >= 0 && col >= 0 && row < maxRow && col < maxCol;
     }
     
     // 안전한 좌표 설정
-    void setSafe(int newRow, int newCol, int maxRow = 100, int maxCol = 100) {
+    void setSafe(int newRow, int newCol, int maxRow, int maxCol) {
         if (newRow < 0 || newRow >= maxRow || newCol < 0 || newCol >= maxCol) {
             throw std::out_of_range("Coordinate out of bounds");
         }
@@ -39,14 +39,13 @@ struct Coord
     }
 };
 
+// 보드 위 물체의 값 타입 (가상 함수 없음: 좌표와 종류별 몇 개 필드만 가짐)
+// 벽 / 무적벽 배치는 Map의 1바이트 타일 격자가 원본이고, 아래 타입은 벽 목록 / 게이트 / 아이템을 다루는 보기 역할.
+// 종류 코드는 인스턴스마다 저장하지 않고 타입마다 kObjectType 상수로 둔다.
 class Block
 {
 public:
     Coord coord;
-    int objectType = 0;
-    
-    virtual ~Block() = default;
-    virtual int getObjectType() const { return objectType; }
     
     Block() = default;
     Block(int row, int col) : coord{row, col} {
@@ -56,91 +55,86 @@ public:
     Block& operator=(const Block &b) = default;
     
 protected:
-    // 좌표 유효성 검사 (기본적인 범위 체크)
+    // 좌표 유효성 검사 (상한은 맵 크기를 아는 Map / Simulation이 검사)
     void validateCoordinates(int row, int col) const {
         if (row < 0 || col < 0) {
             throw std::invalid_argument("Coordinates cannot be negative");
         }
-        // 너무 큰 값도 체크 (메모리 오버플로우 방지)
-        if (row > 10000 || col > 10000) {
-            throw std::invalid_argument("Coordinates too large");
-        }
     }
 };
 
 class Wall : public Block
 {
 public:
+    static const int kObjectType = 1;
     int wallPositionType;
     
-    Wall() : Block() { objectType = 1; }
+    Wall() : Block(), wallPositionType(-1) {}
     Wall(int row, int col, int wallPositionType = -1) 
         : Block(row, col), wallPositionType(wallPositionType) 
     {
-        objectType = 1;
     }
     
-    int getObjectType() const override { return objectType; }
+    int getObjectType() const { return kObjectType; }
 };
 
 class ImmunedWall : public Block
 {
 public:
-    ImmunedWall() : Block() { objectType = 2; }
-    ImmunedWall(int row, int col) : Block(row, col) { objectType = 2; }
-    ImmunedWall(const ImmunedWall &iwall) = default;
-    ImmunedWall& operator=(const ImmunedWall &iwall) = default;
+    static const int kObjectType = 2;
+
+    ImmunedWall() : Block() {}
+    ImmunedWall(int row, int col) : Block(row, col) {}
     
-    int getObjectType() const override { return objectType; }
+    int getObjectType() const { return kObjectType; }
 };
 
 class GrowthItem : public Block
 {
 public:
-    GrowthItem() : Block() { objectType = 5; }
-    GrowthItem(int row, int col) : Block(row, col) { objectType = 5; }
-    GrowthItem(const GrowthItem &gitem) = default;
-    GrowthItem& operator=(const GrowthItem &gitem) = default;
+    static const int kObjectType = 5;
+
+    GrowthItem() : Block() {}
+    GrowthItem(int row, int col) : Block(row, col) {}
     
-    int getObjectType() const override { return objectType; }
+    int getObjectType() const { return kObjectType; }
 };
 
 class PoisonItem : public Block
 {
 public:
-    PoisonItem() : Block() { objectType = -5; }
-    PoisonItem(int row, int col) : Block(row, col) { objectType = -5; }
-    PoisonItem(const PoisonItem &pitem) = default;
-    PoisonItem& operator=(const PoisonItem &pitem) = default;
+    static const int kObjectType = -5;
+
+    PoisonItem() : Block() {}
+    PoisonItem(int row, int col) : Block(row, col) {}
     
-    int getObjectType() const override { return objectType; }
+    int getObjectType() const { return kObjectType; }
 };
 
 class TimeItem : public Block
 {
 public:
-    TimeItem() : Block() { objectType = 6; }
-    TimeItem(int row, int col) : Block(row, col) { objectType = 6; }
-    TimeItem(const TimeItem &titem) = default;
-    TimeItem& operator=(const TimeItem &titem) = default;
+    static const int kObjectType = 6;
+
+    TimeItem() : Block() {}
+    TimeItem(int row, int col) : Block(row, col) {}
     
-    int getObjectType() const override { return objectType; }
+    int getObjectType() const { return kObjectType; }
 };
 
 class Gate : public Block
 {
 public:
+    static const int kObjectType = 2;
     int exitDirection;
     bool isActive = false;
     
     Gate() : Block() { 
-        objectType = 2; 
         exitDirection = 6; // 기본값: 자유 방향
     }
     
     Gate(const Wall &wall) : Block(wall.coord.row, wall.coord.col)
     {
-        objectType = 2;
         // wallPositionType: 1=상단, 2=좌측, 3=우측, 4=하단, -1=내부벽
         if (wall.wallPositionType == -1) {
             exitDirection = 6; // 내부 벽은 자유 방향
@@ -150,37 +144,138 @@ public:
     }
     
     Gate(int row, int col) : Block(row, col) { 
-        objectType = 2; 
         exitDirection = 6; // 기본값: 자유 방향
     }
     
-    int getObjectType() const override { return objectType; }
+    int getObjectType() const { return kObjectType; }
 };
 
-class SnakeHead;
-
-class SnakeBody : public Block
+// 스네이크 몸통 원형 버퍼 (좌표만 저장, 0번 = 목, 마지막 = 꼬리)
+// 머리 쪽 추가 / 꼬리 쪽 추가·제거가 모두 O(1). 저장 공간은 작게 시작해 가득 차면 두 배로 늘리며
+// (분할 상환 O(1)), 길이는 maxSize(맵 셀 수)를 넘지 않는다.
+class SnakeBodyRing
 {
 public:
-    SnakeBody() : Block() { objectType = 4; }
-    SnakeBody(int row, int col) : Block(row, col) { objectType = 4; }
-    SnakeBody(const SnakeHead &head);
-    
-    int getObjectType() const override { return objectType; }
+    class const_iterator
+    {
+    public:
+        const_iterator(const SnakeBodyRing* ring, size_t index) : ring(ring), index(index) {}
+        const Coord& operator*() const { return (*ring)[index]; }
+        const Coord* operator->() const { return &(*ring)[index]; }
+        const_iterator& operator++() { ++index; return *this; }
+        bool operator==(const const_iterator& other) const { return index == other.index; }
+        bool operator!=(const const_iterator& other) const { return index != other.index; }
+    private:
+        const SnakeBodyRing* ring;
+        size_t index;
+    };
+
+    explicit SnakeBodyRing(size_t maxSize = 16) : limit(maxSize) {
+        size_t capacity = 1;
+        while (capacity < kInitialCapacity && capacity < maxSize) capacity <<= 1;
+        cells.resize(capacity);
+        mask = capacity - 1;
+    }
+
+    SnakeBodyRing(const SnakeBodyRing&) = default;
+    SnakeBodyRing(SnakeBodyRing&&) = default;
+    SnakeBodyRing& operator=(SnakeBodyRing&&) = default;
+
+    // 복사 대입은 기존 버퍼가 원본 길이를 담을 수 있으면 그대로 두고 순서를 펴서 덮어씀
+    // (스테이지 원본을 복사해 다시 시작해도 이전 스테이지에서 늘린 버퍼를 줄이지 않음)
+    SnakeBodyRing& operator=(const SnakeBodyRing& other) {
+        if (this == &other) return *this;
+        if (cells.size() < other.count) {
+            cells.resize(other.cells.size());
+            mask = cells.size() - 1;
+        }
+        for (size_t i = 0; i < other.count; ++i) cells[i] = other[i];
+        limit = other.limit;
+        start = 0;
+        count = other.count;
+        return *this;
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count >= limit; }
+    size_t maxSize() const { return limit; }
+    size_t capacity() const { return cells.size(); }
+
+    const Coord& operator[](size_t i) const { return cells[(start + i) & mask]; }
+    const Coord& front() const { return (*this)[0]; }
+    const Coord& back() const { return (*this)[count - 1]; }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+
+    // 목 위치에 추가 (최대 길이 초과 시 false)
+    bool pushFront(const Coord& c) {
+        if (!reserveOne()) return false;
+        start = (start + mask) & mask;
+        cells[start] = c;
+        count++;
+        return true;
+    }
+
+    // 꼬리 뒤에 추가 (최대 길이 초과 시 false)
+    bool pushBack(const Coord& c) {
+        if (!reserveOne()) return false;
+        cells[(start + count) & mask] = c;
+        count++;
+        return true;
+    }
+
+    void popBack() {
+        if (count > 0) count--;
+    }
+
+    void clear() {
+        start = 0;
+        count = 0;
+    }
+
+    // 비우고 최대 길이만 바꿈 (늘려 둔 버퍼는 그대로 다시 씀)
+    void reset(size_t maxSize) {
+        clear();
+        limit = maxSize;
+    }
+
+private:
+    static const size_t kInitialCapacity = 64;
+
+    vector<Coord> cells;
+    size_t limit;
+    size_t mask = 0;
+    size_t start = 0;
+    size_t count = 0;
+
+    bool reserveOne() {
+        if (full()) return false;
+        if (count < cells.size()) return true;
+        // 순서를 펴서 두 배 크기 버퍼로 옮김
+        vector<Coord> grown(cells.size() * 2);
+        for (size_t i = 0; i < count; ++i) grown[i] = (*this)[i];
+        cells.swap(grown);
+        mask = cells.size() - 1;
+        start = 0;
+        return true;
+    }
 };
 
 class SnakeHead : public Block
 {
 public:
-    vector<SnakeBody> snakeBodySegments;
+    SnakeBodyRing snakeBodySegments;
     int currentDirection = -1;
     
-    friend class SnakeBody;
-    
-    SnakeHead() : Block() { objectType = 3; }
-    SnakeHead(int row, int col) : Block(row, col) { objectType = 3; }
+    static const int kObjectType = 3;
+
+    SnakeHead() : Block() {}
+    SnakeHead(int row, int col, size_t maxBodyLength = 16)
+        : Block(row, col), snakeBodySegments(maxBodyLength) {}
     
-    int getObjectType() const override { return objectType; }
+    int getObjectType() const { return kObjectType; }
     
     void move()
     {
@@ -198,37 +293,9 @@ public:
             case 4: newCoord.row++; break; // Down
         }
         
-        // 새 좌표가 유효한 범위 내인지 확인 (기본적인 체크)
-        if (newCoord.isValid(1000, 1000)) {
-            coord = newCoord;
-        }
-        // 유효하지 않은 좌표로 이동하려 하면 그냥 무시 (게임 로직에서 처리)
-    }
-    
-    // 안전한 몸통 추가
-    void addBodySegment(int row, int col) {
-        try {
-            snakeBodySegments.emplace_back(row, col);
-        } catch (const std::exception& e) {
-            // 유효하지 않은 좌표면 머리 위치에 추가
-            snakeBodySegments.emplace_back(coord.row, coord.col);
-        }
-    }
-    
-    // 안전한 몸통 제거
-    bool removeBodySegment() {
-        if (snakeBodySegments.size() <= 3) {
-            return false; // 최소 길이 유지
-        }
-        snakeBodySegments.pop_back();
-        return true;
+        // 격자 밖은 Map::cellAt이 무적벽으로 취급하므로 충돌 판정은 게임 로직에서 처리
+        coord = newCoord;
     }
 };
 
-inline SnakeBody::SnakeBody(const SnakeHead &head)
-    : Block(head.coord.row, head.coord.col)
-{
-    objectType = 4;
-}
-
 #endif
\ No newline at end of file
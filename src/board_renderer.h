@@ -0,0 +1,252 @@
+#ifndef BOARD_RENDERER_H
+#define BOARD_RENDERER_H
+
+#include "simulation.h"
+#include <ncurses.h>
+#include <algorithm>
+#include <vector>
+
+using namespace std;
+
+// 보드 창을 셀 단위로 증분 갱신하는 렌더러
+// 마지막으로 그린 문자를 화면 칸별 그림자 버퍼에 보관하고, 매 틱 바뀔 수 있는 셀
+// (머리, 목, 꼬리, 아이템, 게이트의 이전 / 현재 위치)만 다시 계산해서 달라진 셀만 출력한다.
+// 몸통이 짧아진 틱(독 아이템)에는 꼬리 쪽에서 두 칸 이상 비므로 보이는 칸 전체를 다시 계산한다.
+// 맵이 새로 만들어지거나(스테이지 초기화) invalidate()가 호출되면 한 번 전체를 다시 그린다.
+//
+// 보드가 창보다 크면 창 크기만큼의 영역(뷰포트)만 그린다. 뷰포트는 머리를 따라가되 머리가 가운데
+// 불감 영역 안에 있는 동안은 움직이지 않으며, 움직일 때도 보이는 칸만 다시 계산하므로 그리기 비용은
+// 보드가 아니라 창 크기에 비례한다. 화면 밖의 아이템 / 게이트는 그 방향의 테두리에 같은 문자로 표시한다.
+class BoardRenderer
+{
+public:
+    // 뷰포트로 쓸 수 있는 최소 창 크기 (테두리 포함)
+    static const int kMinWindowRows = 7;
+    static const int kMinWindowCols = 12;
+
+    void invalidate() { fullRedraw = true; }
+
+    // 보이는 맵 영역의 왼쪽 위 칸 (맵 좌표)
+    int getViewTop() const { return viewTop; }
+    int getViewLeft() const { return viewLeft; }
+
+    // 보드 창에 현재 상태를 반영하고 실제로 출력한 셀 수를 반환 (wnoutrefresh는 호출자 담당)
+    int draw(WINDOW* board, const Simulation& sim) {
+        const Map& map = sim.getMap();
+        int windowRows, windowCols;
+        getmaxyx(board, windowRows, windowCols);
+        int newViewRows = min(map.mapSize.height, windowRows - 2);
+        int newViewCols = min(map.mapSize.width, windowCols - 2);
+        if (fullRedraw || sim.getMapGeneration() != drawnGeneration ||
+            map.mapSize.height != mapHeight || map.mapSize.width != mapWidth ||
+            newViewRows != viewRows || newViewCols != viewCols) {
+            return redrawAll(board, sim, newViewRows, newViewCols);
+        }
+
+        int drawn = 0;
+        size_t bodyLength = map.snakeHeadObject.snakeBodySegments.size();
+        bool bodyShrank = bodyLength < drawnBodyLength;
+        drawnBodyLength = bodyLength;
+        if (followHead(map) || bodyShrank) {
+            // 뷰포트가 움직이거나 직전 꼬리 외의 칸도 비었으면 보이는 칸 전체를 다시 계산 (그림자 버퍼와 다른 칸만 출력)
+            drawn += drawVisible(board, sim);
+            collectDynamicCells(map, lastDynamic);
+        } else {
+            for (const Coord& pos : lastDynamic) {
+                drawn += drawCell(board, sim, pos);
+            }
+            collectDynamicCells(map, lastDynamic);
+            for (const Coord& pos : lastDynamic) {
+                drawn += drawCell(board, sim, pos);
+            }
+        }
+        drawn += drawEdgeIndicators(board, map, false);
+        return drawn;
+    }
+
+private:
+    struct Indicator {
+        int row;
+        int col;
+        chtype glyph;
+        bool operator==(const Indicator& other) const {
+            return row == other.row && col == other.col && glyph == other.glyph;
+        }
+    };
+
+    bool fullRedraw = true;
+    unsigned long drawnGeneration = 0;
+    int mapHeight = 0;
+    int mapWidth = 0;
+    int viewRows = 0;            // 보이는 맵 행 / 열 수 (테두리 제외)
+    int viewCols = 0;
+    int viewTop = 1;
+    int viewLeft = 1;
+    size_t drawnBodyLength = 0;  // 직전 프레임의 몸통 길이
+    vector<chtype> shadow;       // 화면 칸별로 마지막에 출력한 문자 + 속성
+    vector<Coord> lastDynamic;   // 직전 프레임의 동적 셀 위치
+    vector<Indicator> lastIndicators;
+    vector<Indicator> indicators;
+
+    int redrawAll(WINDOW* board, const Simulation& sim, int newViewRows, int newViewCols) {
+        const Map& map = sim.getMap();
+        bool newLayout = sim.getMapGeneration() != drawnGeneration ||
+                         map.mapSize.height != mapHeight || map.mapSize.width != mapWidth ||
+                         newViewRows != viewRows || newViewCols != viewCols;
+        mapHeight = map.mapSize.height;
+        mapWidth = map.mapSize.width;
+        viewRows = max(0, newViewRows);
+        viewCols = max(0, newViewCols);
+        shadow.assign(static_cast<size_t>(viewRows) * viewCols, ' ');
+
+        // 새 맵 / 창 크기에서는 머리를 가운데에 두고 시작
+        if (newLayout) {
+            const Coord& head = map.snakeHeadObject.coord;
+            viewTop = clampView(head.row - viewRows / 2, viewRows, mapHeight);
+            viewLeft = clampView(head.col - viewCols / 2, viewCols, mapWidth);
+        }
+        followHead(map);
+
+        werase(board);
+        box(board, 0, 0);
+        int drawn = drawVisible(board, sim);
+        collectDynamicCells(map, lastDynamic);
+        drawnBodyLength = map.snakeHeadObject.snakeBodySegments.size();
+        drawn += drawEdgeIndicators(board, map, true);
+        drawnGeneration = sim.getMapGeneration();
+        fullRedraw = false;
+        return drawn;
+    }
+
+    int drawVisible(WINDOW* board, const Simulation& sim) {
+        int drawn = 0;
+        for (int row = viewTop; row < viewTop + viewRows; ++row) {
+            for (int col = viewLeft; col < viewLeft + viewCols; ++col) {
+                drawn += drawCell(board, sim, {row, col});
+            }
+        }
+        return drawn;
+    }
+
+    // 보이는 영역이 맵 범위(1..size)를 벗어나지 않도록 보정
+    static int clampView(int top, int visible, int size) {
+        return max(1, min(top, size - visible + 1));
+    }
+
+    // 축 하나에 대해 머리가 불감 영역(가장자리에서 보이는 크기의 1/4 안쪽)을 벗어나면 그만큼만 이동
+    static int followAxis(int top, int head, int visible, int size) {
+        int margin = visible / 4;
+        if (head < top + margin) top = head - margin;
+        else if (head > top + visible - 1 - margin) top = head - (visible - 1 - margin);
+        return clampView(top, visible, size);
+    }
+
+    // 뷰포트를 머리 쪽으로 옮기고 움직였는지 반환
+    bool followHead(const Map& map) {
+        const Coord& head = map.snakeHeadObject.coord;
+        int newTop = followAxis(viewTop, head.row, viewRows, mapHeight);
+        int newLeft = followAxis(viewLeft, head.col, viewCols, mapWidth);
+        bool moved = newTop != viewTop || newLeft != viewLeft;
+        viewTop = newTop;
+        viewLeft = newLeft;
+        return moved;
+    }
+
+    bool isVisible(const Coord& pos) const {
+        return pos.row >= viewTop && pos.row < viewTop + viewRows &&
+               pos.col >= viewLeft && pos.col < viewLeft + viewCols;
+    }
+
+    // 화면 밖 아이템 / 게이트를 창 테두리의 가장 가까운 칸에 표시 (바뀌었을 때만 테두리를 다시 그림)
+    int drawEdgeIndicators(WINDOW* board, const Map& map, bool force) {
+        indicators.clear();
+        addIndicator(map.growthItemObject.coord, '+' | COLOR_PAIR(5));
+        addIndicator(map.poisonItemObject.coord, '-' | COLOR_PAIR(6));
+        addIndicator(map.timeItemObject.coord, 'T' | COLOR_PAIR(8));
+        for (const auto& gate : map.gameGates) {
+            addIndicator(gate.coord, ' ' | COLOR_PAIR(7));
+        }
+        if (!force && indicators == lastIndicators) return 0;
+
+        box(board, 0, 0);
+        for (const Indicator& indicator : indicators) {
+            mvwaddch(board, indicator.row, indicator.col, indicator.glyph);
+        }
+        int drawn = static_cast<int>(lastIndicators.size() + indicators.size());
+        lastIndicators.swap(indicators);
+        return drawn;
+    }
+
+    void addIndicator(const Coord& pos, chtype glyph) {
+        if (!Map::isPlaced(pos) || pos.row < 1 || pos.row > mapHeight ||
+            pos.col < 1 || pos.col > mapWidth || isVisible(pos)) {
+            return;
+        }
+        int row = max(0, min(pos.row - viewTop + 1, viewRows + 1));
+        int col = max(0, min(pos.col - viewLeft + 1, viewCols + 1));
+        indicators.push_back({row, col, glyph});
+    }
+
+    static void collectDynamicCells(const Map& map, vector<Coord>& cells) {
+        const auto& segments = map.snakeHeadObject.snakeBodySegments;
+        cells.clear();
+        cells.push_back(map.snakeHeadObject.coord);
+        if (!segments.empty()) {
+            cells.push_back(segments.front());
+            cells.push_back(segments.back());
+        }
+        cells.push_back(map.growthItemObject.coord);
+        cells.push_back(map.poisonItemObject.coord);
+        cells.push_back(map.timeItemObject.coord);
+        for (const auto& gate : map.gameGates) {
+            cells.push_back(gate.coord);
+        }
+    }
+
+    // 기존 전체 그리기 순서(벽 → 몸통 → 게이트 → 머리 → 아이템)에서 마지막에 남는 문자
+    static chtype glyphAt(const Simulation& sim, const Coord& pos) {
+        const Map& map = sim.getMap();
+        if (Map::isPlaced(map.timeItemObject.coord) && map.timeItemObject.coord == pos)
+            return 'T' | COLOR_PAIR(8);
+        if (Map::isPlaced(map.poisonItemObject.coord) && map.poisonItemObject.coord == pos)
+            return '-' | COLOR_PAIR(6);
+        if (Map::isPlaced(map.growthItemObject.coord) && map.growthItemObject.coord == pos)
+            return '+' | COLOR_PAIR(5);
+        if (map.snakeHeadObject.coord == pos) {
+            chtype headChar = 'O';
+            switch (map.snakeHeadObject.currentDirection) {
+                case 1: headChar = '^'; break;
+                case 2: headChar = '<'; break;
+                case 3: headChar = '>'; break;
+                case 4: headChar = 'v'; break;
+            }
+            return headChar | COLOR_PAIR(3) | A_BOLD;
+        }
+        for (const auto& gate : map.gameGates) {
+            if (gate.coord == pos) return ' ' | COLOR_PAIR(7);
+        }
+        const auto& segments = map.snakeHeadObject.snakeBodySegments;
+        if (!segments.empty() && segments.back() == pos) return 'o' | COLOR_PAIR(9);
+        if (map.bodyCountAt(pos) > 0) return 'O' | COLOR_PAIR(4);
+        switch (map.cellAt(pos)) {
+            case CellType::WALL: return ' ' | COLOR_PAIR(2);
+            case CellType::IMMUNE_WALL: return '+' | COLOR_PAIR(2);
+            default: return ' ';
+        }
+    }
+
+    int drawCell(WINDOW* board, const Simulation& sim, const Coord& pos) {
+        // 테두리(box)와 뷰포트 밖 좌표는 건드리지 않음
+        if (!isVisible(pos)) return 0;
+        int screenRow = pos.row - viewTop;
+        int screenCol = pos.col - viewLeft;
+        chtype glyph = glyphAt(sim, pos);
+        chtype& last = shadow[static_cast<size_t>(screenRow) * viewCols + screenCol];
+        if (last == glyph) return 0;
+        mvwaddch(board, screenRow + 1, screenCol + 1, glyph);
+        last = glyph;
+        return 1;
+    }
+};
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef BYTE_IO_H
+#define BYTE_IO_H
+
+#include "block.h"
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+// 리틀 엔디언 직렬화 도우미 (리플레이 파일 / 네트워크 메시지 공용)
+class ByteWriter
+{
+public:
+    explicit ByteWriter(vector<uint8_t>& bytes) : bytes(bytes) {}
+
+    void u8(uint8_t v) { bytes.push_back(v); }
+    void u16(uint16_t v) { put(v, 2); }
+    void u32(uint32_t v) { put(v, 4); }
+    void u64(uint64_t v) { put(v, 8); }
+    void i32(int v) { u32(static_cast<uint32_t>(v)); }
+    void f64(double v) { uint64_t bits; memcpy(&bits, &v, sizeof(bits)); u64(bits); }
+    void f32(float v) { uint32_t bits; memcpy(&bits, &v, sizeof(bits)); u32(bits); }
+    void coord(const Coord& c) { i32(c.row); i32(c.col); }
+
+private:
+    vector<uint8_t>& bytes;
+
+    void put(uint64_t v, int size) {
+        for (int i = 0; i < size; ++i) bytes.push_back(static_cast<uint8_t>(v >> (8 * i)));
+    }
+};
+
+class ByteReader
+{
+public:
+    // 읽을 바이트가 모자라면 truncatedMessage로 runtime_error
+    ByteReader(const uint8_t* data, size_t size, const char* truncatedMessage = "Replay file is truncated")
+        : data(data), size(size), truncatedMessage(truncatedMessage) {}
+
+    size_t position() const { return offset; }
+    bool atEnd() const { return offset >= size; }
+    size_t remaining() const { return size - offset; }
+
+    uint8_t u8() { need(1); return data[offset++]; }
+    uint16_t u16() { return static_cast<uint16_t>(get(2)); }
+    uint32_t u32() { return static_cast<uint32_t>(get(4)); }
+    uint64_t u64() { return get(8); }
+    int i32() { return static_cast<int>(u32()); }
+    double f64() { uint64_t bits = u64(); double v; memcpy(&v, &bits, sizeof(v)); return v; }
+    float f32() { uint32_t bits = u32(); float v; memcpy(&v, &bits, sizeof(v)); return v; }
+    Coord coord() { Coord c; c.row = i32(); c.col = i32(); return c; }
+    void skip(size_t count) { need(count); offset += count; }
+
+private:
+    const uint8_t* data;
+    size_t size;
+    const char* truncatedMessage;
+    size_t offset = 0;
+
+    void need(size_t count) const {
+        if (offset + count > size) throw runtime_error(truncatedMessage);
+    }
+    uint64_t get(int count) {
+        need(static_cast<size_t>(count));
+        uint64_t v = 0;
+        for (int i = 0; i < count; ++i) v |= static_cast<uint64_t>(data[offset + i]) << (8 * i);
+        offset += static_cast<size_t>(count);
+        return v;
+    }
+};
+
+#endif
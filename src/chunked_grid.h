@@ -0,0 +1,116 @@
+#ifndef CHUNKED_GRID_H
+#define CHUNKED_GRID_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+using namespace std;
+
+// 큰 보드용 격자 저장소
+// 64x64 칸 조각 단위로 나눠 두고, 기본값이 아닌 값이 처음 쓰일 때 그 조각만 할당한다.
+// 벽(테두리 / 패턴)과 스네이크가 지나간 곳만 메모리를 차지하며, 읽기는 조각 번호 계산 + 한 번의 참조.
+// 격자 아래쪽 끝 조각은 실제 행 수만큼만 할당하므로 기본 크기 보드는 (행 수 x 64)칸 한 조각으로 끝난다.
+template <typename T>
+class ChunkedGrid
+{
+public:
+    static const int kChunkShift = 6;
+    static const int kChunkSize = 1 << kChunkShift;
+    static const int kChunkMask = kChunkSize - 1;
+
+    ChunkedGrid() = default;
+    ChunkedGrid(const ChunkedGrid& other) { *this = other; }
+    ChunkedGrid(ChunkedGrid&& other) = default;
+    ChunkedGrid& operator=(ChunkedGrid&& other) = default;
+
+    // 내용만 복사하고 예비 조각은 그대로 둠 (이미 쓰던 조각 버퍼를 다시 써서 스테이지 복사가 할당 없이 끝남)
+    ChunkedGrid& operator=(const ChunkedGrid& other) {
+        if (this == &other) return *this;
+        reset(other.gridRows, other.gridCols, other.fillValue);
+        for (size_t i = 0; i < other.chunks.size(); ++i) {
+            if (other.chunks[i].empty()) continue;
+            acquireChunk(chunks[i]);
+            chunks[i] = other.chunks[i];
+        }
+        return *this;
+    }
+
+    // 모든 조각을 비우고 rows x cols 격자로 다시 시작 (모든 칸 = fill)
+    // 비운 조각 버퍼는 예비로 남겨 다음 스테이지에서 다시 씀 (예비 + 사용 중인 조각은 이전에 한꺼번에 쓰던
+    // 조각 수를 넘지 않으므로 최대 메모리는 그대로)
+    void reset(int rows, int cols, T fill = T()) {
+        gridRows = rows;
+        gridCols = cols;
+        fillValue = fill;
+        chunkCols = (cols + kChunkMask) >> kChunkShift;
+        int chunkRows = (rows + kChunkMask) >> kChunkShift;
+        for (auto& chunk : chunks) releaseChunk(chunk);
+        chunks.resize(static_cast<size_t>(chunkRows) * static_cast<size_t>(chunkCols));
+    }
+
+    int rows() const { return gridRows; }
+    int cols() const { return gridCols; }
+
+    // 범위 검사는 호출자 몫 (Map::isInGrid)
+    T get(int row, int col) const {
+        const vector<T>& chunk = chunks[chunkIndex(row, col)];
+        if (chunk.empty()) return fillValue;
+        return chunk[offset(row, col)];
+    }
+
+    void set(int row, int col, T value) {
+        vector<T>& chunk = chunks[chunkIndex(row, col)];
+        if (chunk.empty()) {
+            if (value == fillValue) return;
+            acquireChunk(chunk);
+            int rowsInChunk = min(static_cast<int>(kChunkSize), gridRows - (row & ~kChunkMask));
+            chunk.assign(static_cast<size_t>(rowsInChunk) * kChunkSize, fillValue);
+        }
+        chunk[offset(row, col)] = value;
+    }
+
+    // 할당된 조각 수 / 칸 데이터가 차지하는 바이트 (조각 목록 자체와 예비 조각 제외)
+    size_t allocatedChunks() const {
+        size_t count = 0;
+        for (const auto& chunk : chunks) {
+            if (!chunk.empty()) count++;
+        }
+        return count;
+    }
+    size_t allocatedBytes() const {
+        size_t cells = 0;
+        for (const auto& chunk : chunks) cells += chunk.size();
+        return cells * sizeof(T);
+    }
+
+private:
+    int gridRows = 0;
+    int gridCols = 0;
+    int chunkCols = 0;
+    T fillValue = T();
+    vector<vector<T>> chunks;
+    vector<vector<T>> spareChunks;   // 비어 있지만 용량이 남아 있는 조각 버퍼
+
+    void acquireChunk(vector<T>& chunk) {
+        if (spareChunks.empty()) return;
+        chunk.swap(spareChunks.back());
+        spareChunks.pop_back();
+    }
+    void releaseChunk(vector<T>& chunk) {
+        if (chunk.empty()) return;
+        chunk.clear();
+        spareChunks.emplace_back();
+        spareChunks.back().swap(chunk);
+    }
+
+    size_t chunkIndex(int row, int col) const {
+        return static_cast<size_t>(row >> kChunkShift) * static_cast<size_t>(chunkCols) +
+               static_cast<size_t>(col >> kChunkShift);
+    }
+    static size_t offset(int row, int col) {
+        return static_cast<size_t>(((row & kChunkMask) << kChunkShift) | (col & kChunkMask));
+    }
+};
+
+#endif
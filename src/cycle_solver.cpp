@@ -0,0 +1,415 @@
+#include "cycle_solver.h"
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+
+const int kRowDelta[5] = {0, -1, 0, 0, 1};
+const int kColDelta[5] = {0, 0, -1, 1, 0};
+
+// 지름길 후 머리와 꼬리 사이에 남겨 둘 여유 칸 (성장 아이템을 먹어 꼬리가 멈추는 틱 대비)
+const int kShortcutMargin = 3;
+
+int directionBetween(const Coord& from, const Coord& to)
+{
+    for (int d = 1; d <= 4; ++d) {
+        if (from.row + kRowDelta[d] == to.row && from.col + kColDelta[d] == to.col) return d;
+    }
+    return -1;
+}
+
+} // namespace
+
+HamiltonianCycle::HamiltonianCycle(const Map& map)
+    : rows(map.mapSize.height + 2), cols(map.mapSize.width + 2), layoutHash(map.getLayoutHash())
+{
+    for (const auto& wall : map.regularWalls) regularWalls.push_back(wall.coord);
+    for (const auto& wall : map.immuneWalls) immuneWalls.push_back(wall.coord);
+    order.assign(static_cast<size_t>(rows) * static_cast<size_t>(cols), -1);
+
+    // 2x2 블록 격자: 테두리 벽(행 1 / h, 열 1 / w) 안쪽 칸을 블록으로 나눈다.
+    // 안쪽 행 / 열 수가 홀수면 남는 한 행 / 열(spareRow / spareCol)을 가운데에 두어 테두리 벽에 붙지 않게 한다.
+    // 벽에 붙은 칸에서 순환이 벽 반대쪽으로 꺾이면 그 칸이 꼬리일 때 성장하는 칸이 벽이 되기 때문이다.
+    auto emptyCell = [&map](int row, int col) { return map.cellAt({row, col}) == CellType::EMPTY; };
+    int innerRows = map.mapSize.height - 2;
+    int innerCols = map.mapSize.width - 2;
+    int blockRows = innerRows / 2;
+    int blockCols = innerCols / 2;
+    if (blockRows <= 0 || blockCols <= 0) return;
+    int spareRow = innerRows % 2 == 1 ? 2 + 2 * (blockRows / 2) : -1;
+    int spareCol = innerCols % 2 == 1 ? 2 + 2 * (blockCols / 2) : -1;
+    auto blockTop = [spareRow](int br) { int row = 2 + 2 * br; return spareRow >= 0 && row >= spareRow ? row + 1 : row; };
+    auto blockLeft = [spareCol](int bc) { int col = 2 + 2 * bc; return spareCol >= 0 && col >= spareCol ? col + 1 : col; };
+
+    int blockCount = blockRows * blockCols;
+    vector<unsigned char> usable(static_cast<size_t>(blockCount), 0);
+    for (int br = 0; br < blockRows; ++br) {
+        for (int bc = 0; bc < blockCols; ++bc) {
+            int row = blockTop(br);
+            int col = blockLeft(bc);
+            usable[br * blockCols + bc] = emptyCell(row, col) && emptyCell(row, col + 1) &&
+                                          emptyCell(row + 1, col) && emptyCell(row + 1, col + 1);
+        }
+    }
+
+    // 블록 사이 간선 (남는 행 / 열을 건너는 간선은 건너는 두 칸이 비어 있어야 함)
+    // 우선순위: 0 = 블록 격자 가장자리를 따라 도는 간선, 1 = 세로, 2 = 가로.
+    // 가장자리 블록을 먼저 한 줄로 이어 두면 순환의 바깥 둘레가 테두리를 따라 곧게 지나가고,
+    // 안쪽 블록은 세로 빗살로 붙어 꺾이는 곳이 모두 몸통 칸과 맞닿는다.
+    struct BlockEdge {
+        int a;
+        int b;   // a의 오른쪽(가로) 또는 아래(세로) 블록
+    };
+    vector<BlockEdge> edges[3];
+    for (int br = 0; br < blockRows; ++br) {
+        for (int bc = 0; bc < blockCols; ++bc) {
+            int a = br * blockCols + bc;
+            if (!usable[a]) continue;
+            int row = blockTop(br);
+            int col = blockLeft(bc);
+            if (bc + 1 < blockCols && usable[a + 1] &&
+                (blockLeft(bc + 1) == col + 2 || (emptyCell(row, col + 2) && emptyCell(row + 1, col + 2)))) {
+                bool rim = br == 0 || br == blockRows - 1;
+                edges[rim ? 0 : 2].push_back({a, a + 1});
+            }
+            if (br + 1 < blockRows && usable[a + blockCols] &&
+                (blockTop(br + 1) == row + 2 || (emptyCell(row + 2, col) && emptyCell(row + 2, col + 1)))) {
+                bool rim = bc == 0 || bc == blockCols - 1;
+                edges[rim ? 0 : 1].push_back({a, a + blockCols});
+            }
+        }
+    }
+
+    // 크루스칼: 우선순위 순서로 고리를 만들지 않는 간선만 트리에 넣음
+    vector<int> parent(static_cast<size_t>(blockCount));
+    for (int block = 0; block < blockCount; ++block) parent[block] = block;
+    auto findRoot = [&parent](int block) {
+        while (parent[block] != block) {
+            parent[block] = parent[parent[block]];
+            block = parent[block];
+        }
+        return block;
+    };
+    vector<BlockEdge> treeEdges;
+    for (const auto& list : edges) {
+        for (const BlockEdge& edge : list) {
+            int ra = findRoot(edge.a);
+            int rb = findRoot(edge.b);
+            if (ra == rb) continue;
+            parent[ra] = rb;
+            treeEdges.push_back(edge);
+        }
+    }
+    // 가장 큰 연결 블록 묶음만 순환에 넣음
+    vector<int> componentSize(static_cast<size_t>(blockCount), 0);
+    int bestRoot = -1;
+    for (int block = 0; block < blockCount; ++block) {
+        if (!usable[block]) continue;
+        int root = findRoot(block);
+        if (++componentSize[root] > (bestRoot >= 0 ? componentSize[bestRoot] : 0)) bestRoot = root;
+    }
+    if (bestRoot < 0) return;
+    auto inCycle = [&](int block) { return usable[block] && findRoot(block) == bestRoot; };
+
+    // 칸별 순환 간선 (비트 d-1 = d 방향 이웃과 연결). 블록마다 네 칸짜리 고리로 시작해
+    // 트리 간선마다 맞닿은 두 변을 끊고 두 블록을 가로질러 이으면 하나의 순환이 된다.
+    vector<unsigned char> links(order.size(), 0);
+    auto cell = [this](int row, int col) { return row * cols + col; };
+    auto setLink = [&](int row, int col, int d, bool on) {
+        unsigned char here = static_cast<unsigned char>(1u << (d - 1));
+        unsigned char there = static_cast<unsigned char>(1u << (4 - d));
+        int a = cell(row, col);
+        int b = cell(row + kRowDelta[d], col + kColDelta[d]);
+        if (on) { links[a] |= here; links[b] |= there; }
+        else { links[a] &= static_cast<unsigned char>(~here); links[b] &= static_cast<unsigned char>(~there); }
+    };
+
+    for (int block = 0; block < blockCount; ++block) {
+        if (!inCycle(block)) continue;
+        int row = blockTop(block / blockCols);
+        int col = blockLeft(block % blockCols);
+        setLink(row, col, 3, true);
+        setLink(row, col, 4, true);
+        setLink(row + 1, col, 3, true);
+        setLink(row, col + 1, 4, true);
+    }
+    // 남는 행 / 열의 칸 중 트리 간선이 건너며 넣은 칸 (나머지는 아래에서 ㄷ자 우회로 넣음)
+    vector<unsigned char> spareRowTaken(static_cast<size_t>(blockCols), 0);
+    vector<unsigned char> spareColTaken(static_cast<size_t>(blockRows), 0);
+    for (const BlockEdge& edge : treeEdges) {
+        if (!inCycle(edge.a)) continue;
+        int row = blockTop(edge.a / blockCols);
+        int col = blockLeft(edge.a % blockCols);
+        if (edge.b == edge.a + 1) {
+            // 오른쪽 블록과 연결: 맞닿은 세로 변 두 개를 가로 간선으로 교체 (남는 열이 끼면 그 두 칸을 거침)
+            int right = blockLeft(edge.a % blockCols + 1);
+            setLink(row, col + 1, 4, false);
+            setLink(row, right, 4, false);
+            for (int c = col + 1; c < right; ++c) {
+                setLink(row, c, 3, true);
+                setLink(row + 1, c, 3, true);
+            }
+            if (right != col + 2) spareColTaken[edge.a / blockCols] = 1;
+        } else {
+            // 아래 블록과 연결: 맞닿은 가로 변 두 개를 세로 간선으로 교체 (남는 행이 끼면 그 두 칸을 거침)
+            int below = blockTop(edge.a / blockCols + 1);
+            setLink(row + 1, col, 3, false);
+            setLink(below, col, 3, false);
+            for (int r = row + 1; r < below; ++r) {
+                setLink(r, col, 4, true);
+                setLink(r, col + 1, 4, true);
+            }
+            if (below != row + 2) spareRowTaken[edge.a % blockCols] = 1;
+        }
+    }
+
+    // 남는 행 / 열의 나머지 칸: 위(왼쪽) 블록의 아래(오른쪽) 변, 없으면 아래(오른쪽) 블록의 위(왼쪽) 변을
+    // 그 두 칸을 거치는 ㄷ자 우회로 바꾼다. 두 줄이 만나는 한 칸은 어떤 순환에도 들 수 없다.
+    if (spareRow >= 0) {
+        for (int bc = 0; bc < blockCols; ++bc) {
+            int col = blockLeft(bc);
+            if (spareRowTaken[bc] || !emptyCell(spareRow, col) || !emptyCell(spareRow, col + 1)) continue;
+            int above = (blockRows / 2 - 1) * blockCols + bc;
+            int below = (blockRows / 2) * blockCols + bc;
+            int edgeRow;
+            if (blockRows / 2 > 0 && inCycle(above)) edgeRow = spareRow - 1;
+            else if (inCycle(below)) edgeRow = spareRow + 1;
+            else continue;
+            setLink(edgeRow, col, 3, false);
+            setLink(min(edgeRow, spareRow), col, 4, true);
+            setLink(min(edgeRow, spareRow), col + 1, 4, true);
+            setLink(spareRow, col, 3, true);
+        }
+    }
+    if (spareCol >= 0) {
+        for (int br = 0; br < blockRows; ++br) {
+            int row = blockTop(br);
+            if (spareColTaken[br] || !emptyCell(row, spareCol) || !emptyCell(row + 1, spareCol)) continue;
+            int left = br * blockCols + blockCols / 2 - 1;
+            int right = br * blockCols + blockCols / 2;
+            int edgeCol;
+            if (blockCols / 2 > 0 && inCycle(left)) edgeCol = spareCol - 1;
+            else if (inCycle(right)) edgeCol = spareCol + 1;
+            else continue;
+            setLink(row, edgeCol, 4, false);
+            setLink(row, min(edgeCol, spareCol), 3, true);
+            setLink(row + 1, min(edgeCol, spareCol), 3, true);
+            setLink(row, spareCol, 4, true);
+        }
+    }
+
+    // 아무 칸에서 시작해 왔던 쪽이 아닌 간선을 따라 한 바퀴
+    size_t cycleCells = 0;
+    for (unsigned char edges : links) cycleCells += edges != 0;
+    int startBlock = 0;
+    while (!inCycle(startBlock)) ++startBlock;
+    Coord start{blockTop(startBlock / blockCols), blockLeft(startBlock % blockCols)};
+    path.reserve(cycleCells);
+    Coord pos = start;
+    int cameFrom = -1;
+    do {
+        path.push_back(pos);
+        unsigned char edges = links[cell(pos.row, pos.col)];
+        int step = -1;
+        for (int d = 1; d <= 4; ++d) {
+            if ((edges & (1u << (d - 1))) && d + cameFrom != 5) {
+                step = d;
+                break;
+            }
+        }
+        if (step < 0) break;
+        pos = {pos.row + kRowDelta[step], pos.col + kColDelta[step]};
+        cameFrom = step;
+    } while (pos != start && path.size() < cycleCells);
+
+    // 방향 선택: 꼬리가 그 칸에 있을 때 성장하면 벽으로 늘어나는 칸(다음 칸의 반대쪽이 벽)이 적은 쪽으로 돈다
+    auto wallBehind = [&map](const Coord& tail, const Coord& next) {
+        return map.cellAt({2 * tail.row - next.row, 2 * tail.col - next.col}) != CellType::EMPTY;
+    };
+    size_t n = path.size();
+    size_t forwardRisk = 0;
+    size_t backwardRisk = 0;
+    for (size_t i = 0; i < n; ++i) {
+        forwardRisk += wallBehind(path[i], path[(i + 1) % n]);
+        backwardRisk += wallBehind(path[i], path[(i + n - 1) % n]);
+    }
+    if (backwardRisk < forwardRisk) reverse(path.begin(), path.end());
+    for (size_t i = 0; i < n; ++i) {
+        order[cell(path[i].row, path[i].col)] = static_cast<int>(i);
+    }
+}
+
+int HamiltonianCycle::orderOf(const Coord& pos) const
+{
+    if (pos.row < 0 || pos.row >= rows || pos.col < 0 || pos.col >= cols) return -1;
+    return order[static_cast<size_t>(pos.row * cols + pos.col)];
+}
+
+bool HamiltonianCycle::matches(const Map& map) const
+{
+    if (map.getLayoutHash() != layoutHash || map.mapSize.height + 2 != rows || map.mapSize.width + 2 != cols ||
+        map.regularWalls.size() != regularWalls.size() || map.immuneWalls.size() != immuneWalls.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < regularWalls.size(); ++i) {
+        if (map.regularWalls[i].coord != regularWalls[i]) return false;
+    }
+    for (size_t i = 0; i < immuneWalls.size(); ++i) {
+        if (map.immuneWalls[i].coord != immuneWalls[i]) return false;
+    }
+    return true;
+}
+
+const HamiltonianCycle& CycleSolver::cycleFor(const Simulation& sim)
+{
+    if (current && sim.getMapGeneration() == currentGeneration) return *current;
+
+    const Map& map = sim.getMap();
+    auto found = find_if(cycles.begin(), cycles.end(),
+                         [&map](const unique_ptr<HamiltonianCycle>& cycle) { return cycle->matches(map); });
+    unique_ptr<HamiltonianCycle> cycle;
+    if (found != cycles.end()) {
+        cycle = move(*found);
+        cycles.erase(found);
+    } else {
+        if (cycles.size() >= kMaxCachedCycles) cycles.erase(cycles.begin());
+        cycle.reset(new HamiltonianCycle(map));
+        buildCount++;
+    }
+    cycles.push_back(move(cycle));
+    current = cycles.back().get();
+    currentGeneration = sim.getMapGeneration();
+    ticksOnCycle = 0;
+    return *current;
+}
+
+void CycleSolver::invalidate()
+{
+    current = nullptr;
+    ticksOnCycle = 0;
+    fallback.invalidate();
+}
+
+bool CycleSolver::isBlocked(const Map& map, const Coord& pos, bool avoidPoison) const
+{
+    if (map.isWall(pos)) return true;
+    // 꼬리 칸은 이번 틱에 비워지므로 지나갈 수 있다
+    const SnakeBodyRing& body = map.snakeHeadObject.snakeBodySegments;
+    int tailHere = (!body.empty() && body.back() == pos) ? 1 : 0;
+    if (map.bodyCountAt(pos) > tailHere) return true;
+    return avoidPoison && pos == map.poisonItemObject.coord;
+}
+
+bool CycleSolver::isGrowthSafe(const HamiltonianCycle& cycle, const Map& map, int firstOrder, int goalOrder,
+                               int poisonOrder) const
+{
+    // firstOrder로 한 칸 움직인 뒤 순환을 따라 goalOrder에서 성장 아이템을 먹는다고 가정 (가는 길에 poisonOrder를
+    // 지나면 독 아이템을 먹어 한 칸 짧아짐). 그 시점의 몸통 = 지나온 순환 칸들(최근 것부터) + 현재 머리 + 현재 몸통
+    // 앞부분이며, 성장하면 꼬리가 (꼬리 - 꼬리 앞 칸) 방향으로 늘어나므로 그 칸이 벽이면 충돌한다.
+    const SnakeBodyRing& body = map.snakeHeadObject.snakeBodySegments;
+    int length = static_cast<int>(body.size());
+    int goalDistance = cycle.forwardDistance(firstOrder, goalOrder);
+    if (poisonOrder >= 0 && cycle.forwardDistance(firstOrder, poisonOrder) < goalDistance) length--;
+    if (length < 2) return true;
+    int moves = 1 + goalDistance;
+    auto segmentAt = [&](int j) -> Coord {
+        if (j >= moves) return body[static_cast<size_t>(j - moves)];
+        int step = moves - 1 - j;  // step번째 이동 후의 머리 위치 (0 = 현재)
+        if (step == 0) return map.snakeHeadObject.coord;
+        return cycle.at((firstOrder + step - 1) % cycle.size());
+    };
+    Coord tail = segmentAt(length - 1);
+    Coord beforeTail = segmentAt(length - 2);
+    Coord grown{tail.row - (beforeTail.row - tail.row), tail.col - (beforeTail.col - tail.col)};
+    // 늘어난 꼬리가 아이템을 먹은 머리 자리와 겹쳐도 몸통 충돌
+    return map.cellAt(grown) == CellType::EMPTY && grown != cycle.at(goalOrder);
+}
+
+int CycleSolver::chooseDirection(const Simulation& sim)
+{
+    const HamiltonianCycle& cycle = cycleFor(sim);
+    const Map& map = sim.getMap();
+    const SnakeHead& head = map.snakeHeadObject;
+    int headOrder = cycle.size() > 0 ? cycle.orderOf(head.coord) : -1;
+    if (headOrder < 0) {
+        ticksOnCycle = 0;
+        return fallback.chooseDirection(sim);
+    }
+
+    const SnakeBodyRing& body = map.snakeHeadObject.snakeBodySegments;
+    int length = static_cast<int>(body.size());
+    Simulation::MissionTargets targets = sim.getCurrentMissionTargets();
+    bool avoidPoison = !(sim.getPoisonItemCount() < targets.poisonItems &&
+                         length > 3 && length > targets.snakeLength);
+
+    int n = cycle.size();
+    int successor = (headOrder + 1) % n;
+    bool settled = ticksOnCycle >= length;
+    if (!settled && isBlocked(map, cycle.at(successor), avoidPoison)) {
+        // 순환에 막 합류해 몸통이 아직 순환 순서대로 놓이지 않음
+        ticksOnCycle = 0;
+        return fallback.chooseDirection(sim);
+    }
+    ticksOnCycle++;
+
+    // 후보: 순환의 다음 칸, 몸통이 순환 순서대로 놓였으면 꼬리까지의 거리 안에서 건너뛰는 이웃 칸
+    // 성장 직후의 꼬리 끝 칸은 순환 순서와 무관한 자리에 한 틱 동안만 붙으므로 바로 앞 칸과 비교해 가까운 쪽 사용
+    int tailDistance = 0;
+    if (settled && length >= 2) {
+        int tailOrder = cycle.orderOf(body.back());
+        int beforeTailOrder = cycle.orderOf(body[static_cast<size_t>(length - 2)]);
+        if (beforeTailOrder >= 0) {
+            tailDistance = cycle.forwardDistance(headOrder, beforeTailOrder);
+            if (tailOrder >= 0) tailDistance = min(tailDistance, cycle.forwardDistance(headOrder, tailOrder));
+        }
+    }
+    int goalOrder = cycle.orderOf(map.growthItemObject.coord);
+    int goalDistance = goalOrder >= 0 ? cycle.forwardDistance(headOrder, goalOrder) : n;
+    bool shortcutsAllowed = length * 2 < n;
+    // 순환대로 가서 먹으면 꼬리가 벽으로 늘어나는데, 가는 길의 독 아이템을 먹어 한 칸 줄이면 안전해지는 경우 독을 먹음
+    int poisonOrder = cycle.orderOf(map.poisonItemObject.coord);
+    if (avoidPoison && length > 3 && goalOrder >= 0 && poisonOrder >= 0 &&
+        !isGrowthSafe(cycle, map, successor, goalOrder, -1) &&
+        isGrowthSafe(cycle, map, successor, goalOrder, poisonOrder)) {
+        avoidPoison = false;
+    }
+    if (avoidPoison) poisonOrder = -1;
+
+    int bestOrder = -1;        // 목표를 넘지 않는 가장 먼 안전한 칸
+    int bestDistance = 0;
+    int skipOrder = -1;        // 다음 칸이 막혔거나 위험할 때 쓸 가장 가까운 안전한 건너뛰기
+    int skipDistance = n;
+    for (int d = 1; d <= 4; ++d) {
+        Coord neighbor{head.coord.row + kRowDelta[d], head.coord.col + kColDelta[d]};
+        int neighborOrder = cycle.orderOf(neighbor);
+        if (neighborOrder < 0) continue;
+        int distance = cycle.forwardDistance(headOrder, neighborOrder);
+        if (distance != 1 && (distance == 0 || distance >= tailDistance - kShortcutMargin)) continue;
+        if (isBlocked(map, neighbor, avoidPoison)) continue;
+        // 이 칸을 거쳐 순환대로 성장 아이템을 먹게 되면 늘어나는 꼬리가 벽에 닿지 않아야 함.
+        // 목표를 건너뛰는 칸은 이번에 먹지 않으므로 그대로 후보 (아이템은 50틱 안에 다른 자리로 옮겨짐)
+        if (distance <= goalDistance && goalOrder >= 0 && !isGrowthSafe(cycle, map, neighborOrder, goalOrder, poisonOrder)) continue;
+
+        bool preferred = distance == 1 || (shortcutsAllowed && distance <= goalDistance);
+        if (preferred && distance > bestDistance) {
+            bestDistance = distance;
+            bestOrder = neighborOrder;
+        }
+        if (distance > 1 && distance < skipDistance) {
+            skipDistance = distance;
+            skipOrder = neighborOrder;
+        }
+    }
+    if (bestOrder < 0) bestOrder = skipOrder;
+    if (bestOrder < 0) {
+        // 안전한 칸이 없으면 다음 칸으로 (독 아이템은 길이가 남으면 먹고 지나감, 꼬리 한 칸이 줄 뿐)
+        if (!isBlocked(map, cycle.at(successor), length <= 3)) {
+            return directionBetween(head.coord, cycle.at(successor));
+        }
+        // 몸통이 순환 순서에서 벗어나 다음 칸이 막힘: 너비 우선 탐색으로 다시 자리 잡음
+        ticksOnCycle = 0;
+        return fallback.chooseDirection(sim);
+    }
+    return directionBetween(head.coord, cycle.at(bestOrder));
+}
@@ -0,0 +1,81 @@
+#ifndef CYCLE_SOLVER_H
+#define CYCLE_SOLVER_H
+
+#include "simulation.h"
+#include "autopilot.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+// 맵의 빈 칸 위를 한 번씩 지나 제자리로 돌아오는 해밀턴 순환
+// 테두리 벽 안쪽 칸을 2x2 블록으로 나눠 네 칸이 모두 빈 블록끼리의 신장 트리를 만들고, 트리 둘레를 따라
+// 순환을 만든다. 트리는 블록 격자 가장자리 → 세로 → 가로 간선 순으로 잇고 방향도 골라, 꼬리에서 성장할 때
+// 벽으로 늘어나는 칸을 빈 판 기준 5칸(네 모서리는 어떤 순환이든 피할 수 없음 + 1)으로 줄인다.
+// 안쪽 행 / 열 수가 홀수면 남는 한 행 / 열을 가운데에 두고 트리 간선으로 건너거나 두 칸씩 우회해 넣는다
+// (둘 다 홀수면 칸 수가 홀수라 두 줄이 만나는 한 칸만 빠짐).
+// 가장 큰 연결 블록 묶음만 포함하므로 벽에 걸친 블록의 칸은 순환 밖에 남는다.
+class HamiltonianCycle
+{
+public:
+    explicit HamiltonianCycle(const Map& map);
+
+    // 순환 길이 (0이면 만들 수 있는 블록이 없음)
+    int size() const { return static_cast<int>(path.size()); }
+    // 순환상의 순번 (순환 밖이면 -1)
+    int orderOf(const Coord& pos) const;
+    const Coord& at(int order) const { return path[static_cast<size_t>(order)]; }
+    // from에서 순환 방향으로 to까지 몇 칸인지
+    int forwardDistance(int from, int to) const { return (to - from + size()) % size(); }
+
+    // 이 순환을 만든 맵과 벽 배치가 같은지 (해시가 같을 때 크기와 벽 목록으로 확인, 벽 수에 비례)
+    uint64_t getLayoutHash() const { return layoutHash; }
+    bool matches(const Map& map) const;
+
+private:
+    int rows;
+    int cols;
+    vector<Coord> path;
+    vector<int> order;     // 격자 칸 → 순번 (-1 = 순환 밖)
+    uint64_t layoutHash;
+    vector<Coord> regularWalls;
+    vector<Coord> immuneWalls;
+};
+
+// 해밀턴 순환을 따라가는 자동 조종 (판을 채우는 쪽으로 오래 버티는 내구 실행용)
+// - 기본은 순환의 다음 칸. 판이 절반 이하로 찼을 때만 목표 아이템 쪽으로 순환 순서를 건너뛰는 지름길을
+//   쓰며, 건너뛴 뒤에도 머리에서 꼬리까지의 순환 거리가 kShortcutMargin칸 넘게 남는 경우로 제한한다.
+// - 판이 가득 찬다는 보장은 없다: 성장 아이템은 임의의 빈 칸에 다시 생기므로, 몸통이 길어 다음 칸 말고
+//   갈 곳이 없을 때 꼬리가 모서리에 있는 순간 바로 앞에 생기면 그대로 먹고 벽 충돌로 끝난다.
+//   지름길 건너뛰기와 독 아이템으로 꼬리 위치를 옮기는 것은 피할 여지가 있을 때만 통한다.
+// - 결정은 순번 조회 몇 번이라 O(1). 순환은 최근 벽 배치 kMaxCachedCycles개(내장 스테이지 4종)까지 보관해
+//   스테이지 재시작 시 다시 만들지 않는다 (끝없는 절차적 스테이지는 오래된 순환부터 버림).
+// - 머리가 순환 밖에 있거나 순환이 없으면 Autopilot(너비 우선 탐색)으로 진행한다.
+class CycleSolver
+{
+public:
+    static const size_t kMaxCachedCycles = 4;
+
+    int chooseDirection(const Simulation& sim);
+    void invalidate();
+
+    // 현재 맵의 순환 (맵이 바뀌었으면 캐시에서 찾거나 새로 만듦)
+    const HamiltonianCycle& cycleFor(const Simulation& sim);
+    size_t getCachedCycleCount() const { return cycles.size(); }
+    long getCycleBuildCount() const { return buildCount; }
+
+private:
+    vector<unique_ptr<HamiltonianCycle>> cycles;   // 최근에 쓴 순서 (뒤쪽이 최신)
+    const HamiltonianCycle* current = nullptr;
+    unsigned long currentGeneration = 0;
+    long buildCount = 0;
+    // 연속으로 순환 위를 이동한 틱 수 (몸통 길이 이상이면 몸통 전체가 순환 순서대로 놓인 상태)
+    long ticksOnCycle = 0;
+    Autopilot fallback;
+
+    bool isBlocked(const Map& map, const Coord& pos, bool avoidPoison) const;
+    bool isGrowthSafe(const HamiltonianCycle& cycle, const Map& map, int firstOrder, int goalOrder, int poisonOrder) const;
+};
+
+#endif
@@ -0,0 +1,87 @@
+#include "frame_clock.h"
+#include <algorithm>
+#include <thread>
+
+using namespace std;
+
+FrameClock::FrameClock(int maxCatchUpTicks, size_t sampleCapacity)
+    : maxCatchUpTicks(maxCatchUpTicks)
+    , sampleCapacity(sampleCapacity > 0 ? sampleCapacity : 1)
+{
+    jitterSamples.reserve(this->sampleCapacity);
+}
+
+void FrameClock::reset()
+{
+    started = false;
+}
+
+void FrameClock::waitNextTick(double periodMs)
+{
+    if (!started) {
+        deadline = Clock::now();
+        started = true;
+    }
+    // 정수 ms로 자르지 않고 누적 (속도 1.5배일 때 166.67ms 그대로 유지)
+    Clock::duration period = chrono::duration_cast<Clock::duration>(
+        chrono::duration<double, milli>(periodMs));
+    deadline += period;
+
+    Clock::time_point now = Clock::now();
+    bool resync = false;
+    if (now < deadline) {
+        this_thread::sleep_until(deadline);
+        now = Clock::now();
+    } else {
+        lateTicks++;
+        Clock::duration lag = now - deadline;
+        if (period.count() > 0 && lag > period * maxCatchUpTicks) {
+            droppedTicks += static_cast<long>(lag / period);
+            resync = true;
+        }
+    }
+
+    // 재설정 전의 마감 기준으로 기록 (버리는 틱이 생긴 가장 큰 지연이 0으로 기록되지 않도록)
+    float jitterUs = chrono::duration<float, micro>(now - deadline).count();
+    if (jitterSamples.size() < sampleCapacity) {
+        jitterSamples.push_back(jitterUs);
+    } else {
+        jitterSamples[sampleCursor] = jitterUs;
+    }
+    sampleCursor = (sampleCursor + 1) % sampleCapacity;
+    maxJitterUs = max(maxJitterUs, jitterUs);
+    // 따라잡기 한도를 넘으면 밀린 틱을 버리고 현재 시각 기준으로 재출발
+    if (resync) deadline = now;
+    ticks++;
+}
+
+FramePacingStats FrameClock::stats() const
+{
+    FramePacingStats result;
+    result.ticks = ticks;
+    result.lateTicks = lateTicks;
+    result.droppedTicks = droppedTicks;
+    if (jitterSamples.empty()) return result;
+    // 백분위는 최근 표본 창, 최대는 전체 실행 기준 (틱 / 지연 / 버린 틱 수와 같은 범위)
+
+    vector<float> sorted(jitterSamples);
+    sort(sorted.begin(), sorted.end());
+    auto percentile = [&](double p) {
+        size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+        return static_cast<double>(sorted[index]);
+    };
+    result.p50Us = percentile(0.50);
+    result.p90Us = percentile(0.90);
+    result.p99Us = percentile(0.99);
+    result.maxUs = maxJitterUs;
+    return result;
+}
+
+void printFramePacingStats(const FramePacingStats& stats, ostream& out)
+{
+    out << "ticks: " << stats.ticks << "\n"
+        << "late ticks: " << stats.lateTicks << "\n"
+        << "dropped ticks: " << stats.droppedTicks << "\n"
+        << "jitter p50/p90/p99/max (us): " << stats.p50Us << " / " << stats.p90Us
+        << " / " << stats.p99Us << " / " << stats.maxUs << "\n";
+}
@@ -0,0 +1,57 @@
+#ifndef FRAME_CLOCK_H
+#define FRAME_CLOCK_H
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+// 틱 간격 통계 (지터 = 실제로 깨어난 시각 - 틱 마감 시각, 마이크로초)
+struct FramePacingStats {
+    long ticks = 0;
+    long lateTicks = 0;      // 마감이 이미 지나 대기 없이 바로 진행한 틱 (따라잡기)
+    long droppedTicks = 0;   // 너무 밀려서 일정을 재설정하며 건너뛴 틱 수
+    double p50Us = 0;
+    double p90Us = 0;
+    double p99Us = 0;        // p50 / p90 / p99는 최근 표본 창 기준
+    double maxUs = 0;        // 전체 틱 기준
+};
+
+// 단조 시계 기반 고정 간격 스케줄러
+// 마감 시각을 누적해 나가므로 렌더링 / 갱신에 걸린 시간이 틱 간격에 더해지지 않는다.
+// 밀린 경우 maxCatchUpTicks 틱까지는 대기 없이 따라잡고, 그보다 밀리면 현재 시각으로 재설정한다.
+class FrameClock
+{
+public:
+    explicit FrameClock(int maxCatchUpTicks = 3, size_t sampleCapacity = 4096);
+
+    // 일시 정지(메뉴 / 결과 화면 등) 후 호출: 다음 마감을 현재 시각부터 다시 잡는다
+    void reset();
+    // 이번 틱의 길이(ms, 소수 허용)만큼 이전 마감에서 더한 시각까지 대기
+    void waitNextTick(double periodMs);
+
+    FramePacingStats stats() const;
+
+private:
+    using Clock = chrono::steady_clock;
+
+    int maxCatchUpTicks;
+    bool started = false;
+    Clock::time_point deadline;
+
+    // 최근 지터 표본 (원형 버퍼)
+    vector<float> jitterSamples;
+    size_t sampleCapacity;
+    size_t sampleCursor = 0;
+
+    long ticks = 0;
+    long lateTicks = 0;
+    long droppedTicks = 0;
+    float maxJitterUs = 0;   // 전체 틱 중 최대 지터 (표본 창과 무관)
+};
+
+void printFramePacingStats(const FramePacingStats& stats, ostream& out);
+
+#endif
@@ -1,8 +1,15 @@
 #ifndef GAME_H
 #define GAME_H
 
+#include "simulation.h"
 #include "map.h"
 #include "block.h"
+#include "board_renderer.h"
+#include "frame_clock.h"
+#include "replay.h"
+#include "snapshot_ring.h"
+#include "autopilot.h"
+#include "cycle_solver.h"
 #include <iostream>
 #include <vector>
 #include <ncurses.h>
@@ -61,93 +68,109 @@ public:
     operator WINDOW*() const { return window; }
 };
 
-class Game
+// ncurses 화면 / 입력 계층: 게임 규칙은 Simulation이 담당
+class Game : public Simulation
 {
 public:
-    Game();
+    explicit Game(uint64_t seed = 0, int boardHeight = kDefaultBoardHeight,
+                  int boardWidth = kDefaultBoardWidth);
     ~Game();
 
     void refreshScreen();
-    bool update(int &growthItemTimer, int &poisonItemTimer, int &timeItemTimer, int previousDirection = 0);
-    bool isValid(int /*previousDirection*/);
-    void generateRandCoord(int &row, int &col, bool shouldIncludeWall = false);
-    void generateGate();
-    void generateItems();
-    void generateTItem();
-    void generateGItem();
-    void generatePItem();
+    // 게임 종료 시 틱 간격 통계를 표준 오류로 출력
+    void setPacingReport(bool enabled) { pacingReport = enabled; }
+    // 자동 조종: 키 입력이 없는 틱마다 Autopilot이 고른 방향을 방향키와 같은 경로로 입력
+    void setAutoplay(bool enabled) { autoplay = enabled; autopilot.invalidate(); cycleSolver.invalidate(); }
+    // 자동 조종에 너비 우선 탐색 대신 해밀턴 순환 추종(CycleSolver)을 사용
+    void setCycleAutoplay(bool enabled) { cycleAutoplay = enabled; }
+    // 이번 세션의 입력을 리플레이 파일로 기록
+    void startRecording(const string& path);
+    // 리플레이를 보드 화면으로 재생 (speed배속, startTick부터)
+    void playReplay(const ReplayReader& replay, double speed = 1.0, long startTick = 0);
+
+protected:
+    void onItemConsumed() override { beep(); }
+    void onAllStagesCleared() override { if (!replaying) showEndingScreen(); }
 
 private:
-    Map gameMap;
-    int currentStage = 1;
-    int gateActiveDuration = 0;
-    int growthItemCount = 0;
-    int poisonItemCount = 0;
-    int gatesUsedCount = 0;
-    int maxSnakeLength = 3;
-    int gameTimerSeconds = 0;
-    int gameSpeedDelay = 200;
-    float speedMultiplier = 1;
-    int speedBoostTimer = 0;
-    
-    // 아이템 타이머들을 멤버 변수로 추가
-    int growthItemTimer = 0;
-    int poisonItemTimer = 0;
-    int timeItemTimer = 0;
-
-    char missionSnakeLengthStatus = ' ';
-    char missionGrowthItemStatus = ' ';
-    char missionPoisonItemStatus = ' ';
-    char missionGateUseStatus = ' ';
-    string gameOverReason = "";
+    // 점수판 / 미션판에 표시되는 값 (바뀐 경우에만 해당 창을 다시 그림)
+    struct HudState {
+        int stage = 0;
+        int length = 0;
+        int maxLength = 0;
+        int growth = 0;
+        int poison = 0;
+        int gates = 0;
+        int time = 0;
+        char missions[4] = {' ', ' ', ' ', ' '};
+
+        bool sameMission(const HudState& other) const {
+            return stage == other.stage && length == other.length && growth == other.growth &&
+                   poison == other.poison && gates == other.gates &&
+                   equal(missions, missions + 4, other.missions);
+        }
+        bool sameScore(const HudState& other) const {
+            return sameMission(other) && maxLength == other.maxLength && time == other.time;
+        }
+    };
 
-    bool allMissionsCompleted = false;
     bool ncursesInitialized = false;
 
+    // 창은 한 번 만들고 터미널 크기가 바뀔 때(SIGWINCH → KEY_RESIZE)만 다시 만든다
+    unique_ptr<WindowWrapper> boardWindow;
+    unique_ptr<WindowWrapper> scoreWindow;
+    unique_ptr<WindowWrapper> missionWindow;
+    bool layoutDirty = true;
+    MapDimensions layoutBoardSize{0, 0};   // 창 배치를 계산할 때의 보드 크기 (스테이지 팩은 스테이지마다 다름)
+    bool screenDirty = true;   // 오버레이 화면 등으로 덮인 뒤 전체를 다시 그려야 함
+    BoardRenderer boardRenderer;
+    FrameClock frameClock;
+    bool pacingReport = false;
+    unique_ptr<ReplayWriter> recorder;
+    bool replaying = false;
+    // 되감기('B'): 최근 kRewindCapacity틱을 보관하고 한 번에 kRewindTicks틱 되돌림
+    static const int kRewindTicks = 25;
+    static const size_t kRewindCapacity = 300;
+    SnapshotRing snapshots{kRewindCapacity};
+    // 자동 조종 ('A' 키로 켜고 끔)
+    bool autoplay = false;
+    Autopilot autopilot;
+    bool cycleAutoplay = false;
+    CycleSolver cycleSolver;
+    HudState drawnHud;
+    bool hudDrawn = false;
+
     void initializeNcurses();
     void cleanupNcurses();
-    void drawBoard(WINDOW* board);
+    void exitGame();
+    void reportPacing();
+    bool rebuildLayout();
+    // 터미널 크기나 보드 크기가 바뀌어 창 배치를 다시 계산해야 하는지
+    bool needsLayout() const {
+        return layoutDirty || gameMap.mapSize.height != layoutBoardSize.height ||
+               gameMap.mapSize.width != layoutBoardSize.width;
+    }
+    void invalidateScreen();
+    void renderFrame();
+    HudState currentHud() const;
     void drawScore(WINDOW* score);
     void drawMission(WINDOW* mission);
     void handleGameOver();
     void handleMissionComplete();
-    void checkMissions();
-    void processInput(int key);
-    void updateTimers(int &growthItemTimer, int &poisonItemTimer, int &timeItemTimer);
-    void handleGateCollision();
-    void handleItemCollisions();
-    void resetCurrentStage();
-    void goToNextStage();
-    MapType getMapTypeForStage(int stage);
+    // 키 입력을 처리하고 리플레이에 기록할 입력 코드를 반환
+    uint8_t processInput(int key);
+    // 자동 조종이 고른 방향의 방향키 (방향을 바꿀 필요가 없으면 ERR)
+    int autopilotKey();
     void showEndingScreen();
-    
-    // 스테이지별 미션 목표 관리
-    struct MissionTargets {
-        int snakeLength;
-        int growthItems;
-        int poisonItems;
-        int gateUses;
-    };
-    MissionTargets getMissionTargets(int stage);
-    
-    // 안전한 벡터 접근을 위한 헬퍼 함수들
-    bool isSnakeBodySizeValid(size_t requiredSize) const;
-    void safeAddSnakeBody();
-    bool safeRemoveSnakeBody();
     void validateTerminalSize();
 };
 
-Game::Game()
+Game::Game(uint64_t seed, int boardHeight, int boardWidth)
+    : Simulation(seed, boardHeight, boardWidth)
 {
     try {
-        gameMap = Map(21, 41, 2);
         initializeNcurses();
         validateTerminalSize();
-        generateItems();
-        generateGate();
-        
-        // 초기 게임 속도를 0.2초(200ms)로 설정
-        gameSpeedDelay = 200;
     } catch (const std::exception& e) {
         cleanupNcurses();
         throw;
@@ -190,25 +213,44 @@ void Game::initializeNcurses()
     
     keypad(stdscr, TRUE);
     nodelay(stdscr, TRUE);
-    srand(static_cast<unsigned int>(time(nullptr)));
 }
 
 void Game::cleanupNcurses()
 {
+    boardWindow.reset();
+    scoreWindow.reset();
+    missionWindow.reset();
     if (ncursesInitialized) {
         endwin();
         ncursesInitialized = false;
     }
 }
 
+void Game::reportPacing()
+{
+    if (pacingReport) {
+        printFramePacingStats(frameClock.stats(), std::cerr);
+    }
+}
+
+void Game::exitGame()
+{
+    if (recorder) recorder->finish();
+    cleanupNcurses();
+    reportPacing();
+    if (profiler) profiler->writeReport();
+    exit(0);
+}
+
 void Game::validateTerminalSize()
 {
     int term_rows, term_cols;
     getmaxyx(stdscr, term_rows, term_cols);
     
     // 최소 요구사항 완화 (게임 플레이 가능한 최소 크기)
-    int min_width = gameMap.mapSize.width + 15;   // 맵 + 최소 UI 공간
-    int min_height = gameMap.mapSize.height + 3;  // 맵 + 최소 여유 공간
+    // 큰 보드는 뷰포트로 일부만 보여 주므로 최소 뷰포트 크기만 요구
+    int min_width = min(gameMap.mapSize.width, 40) + 15;   // 맵 + 최소 UI 공간
+    int min_height = min(gameMap.mapSize.height, 20) + 3;  // 맵 + 최소 여유 공간
     
     if (term_rows < min_height || term_cols < min_width) {
         // 예외를 던지지 않고 경고만 표시
@@ -235,128 +277,170 @@ void Game::validateTerminalSize()
     }
 }
 
-bool Game::isSnakeBodySizeValid(size_t requiredSize) const
+bool Game::rebuildLayout()
 {
-    return gameMap.snakeHeadObject.snakeBodySegments.size() >= requiredSize;
+    int term_rows, term_cols;
+    getmaxyx(stdscr, term_rows, term_cols);
+
+    // 터미널 크기에 맞춰 UI 레이아웃 동적 조정
+    int board_width = gameMap.mapSize.width + 2;
+    int board_height = gameMap.mapSize.height + 2;
+
+    // 보드가 터미널에 들어가지 않으면 UI 자리를 남기고 나머지를 뷰포트 창으로 사용
+    int ui_width;
+    if (board_width <= term_cols && board_height <= term_rows) {
+        ui_width = min(27, term_cols - board_width - 2);
+        if (ui_width < 15) ui_width = 15; // 최소 UI 너비
+    } else {
+        ui_width = max(15, min(27, term_cols / 3));
+        board_width = min(board_width, term_cols - ui_width - 1);
+        board_height = min(board_height, term_rows);
+    }
+
+    int score_height = min(10, (term_rows - 2) / 2);
+    int mission_height = min(9, term_rows - score_height - 2);
+
+    // UI 윈도우 위치 계산
+    int ui_x = min(board_width + 2, term_cols - ui_width);
+    if (ui_x + ui_width > term_cols) ui_x = term_cols - ui_width;
+    if (ui_x < 0) ui_x = 0;
+
+    int score_y = 0;
+    int mission_y = score_height + 1;
+    if (mission_y + mission_height > term_rows) {
+        mission_y = term_rows - mission_height;
+        if (mission_y < 0) mission_y = 0;
+    }
+
+    boardWindow.reset();
+    scoreWindow.reset();
+    missionWindow.reset();
+
+    // 뷰포트조차 들어가지 않을 만큼 터미널이 작은 경우
+    if (board_width < BoardRenderer::kMinWindowCols || board_height < BoardRenderer::kMinWindowRows) {
+        // 터미널이 너무 작은 경우 오버레이 모드로 전환
+        clear();
+        mvprintw(term_rows/2, (term_cols-30)/2, "Terminal too small for game board!");
+        mvprintw(term_rows/2+1, (term_cols-25)/2, "Please resize terminal window");
+        mvprintw(term_rows/2+2, (term_cols-20)/2, "Press 'q' to quit");
+        refresh();
+        return false;
+    }
+
+    boardWindow.reset(new WindowWrapper(board_height, board_width, 0, 0));
+    scoreWindow.reset(new WindowWrapper(score_height, ui_width, score_y, ui_x));
+    missionWindow.reset(new WindowWrapper(mission_height, ui_width, mission_y, ui_x));
+    layoutDirty = false;
+    layoutBoardSize = gameMap.mapSize;
+    invalidateScreen();
+    return true;
 }
 
-void Game::safeAddSnakeBody()
+void Game::invalidateScreen()
 {
-    if (!isSnakeBodySizeValid(2)) {
-        // 몸통이 2개 미만이면 기본 위치에 추가
-        Coord headPos = gameMap.snakeHeadObject.coord;
-        gameMap.snakeHeadObject.snakeBodySegments.push_back(
-            SnakeBody(headPos.row + 1, headPos.col));
-        return;
-    }
-    
-    auto& segments = gameMap.snakeHeadObject.snakeBodySegments;
-    auto last = segments.end() - 1;
-    auto sec = segments.end() - 2;
-    
-    segments.push_back(SnakeBody(
-        last->coord.row - (sec->coord.row - last->coord.row),
-        last->coord.col - (sec->coord.col - last->coord.col)
-    ));
+    screenDirty = true;
+    hudDrawn = false;
+    boardRenderer.invalidate();
 }
 
-bool Game::safeRemoveSnakeBody()
+Game::HudState Game::currentHud() const
 {
-    if (gameMap.snakeHeadObject.snakeBodySegments.size() <= 3) {
-        return false; // 최소 길이 유지
+    HudState hud;
+    hud.stage = currentStage;
+    hud.length = (int)gameMap.snakeHeadObject.snakeBodySegments.size();
+    hud.maxLength = maxSnakeLength;
+    hud.growth = growthItemCount;
+    hud.poison = poisonItemCount;
+    hud.gates = gatesUsedCount;
+    hud.time = getElapsedSeconds();
+    hud.missions[0] = missionSnakeLengthStatus;
+    hud.missions[1] = missionGrowthItemStatus;
+    hud.missions[2] = missionPoisonItemStatus;
+    hud.missions[3] = missionGateUseStatus;
+    return hud;
+}
+
+void Game::renderFrame()
+{
+    // 화면 전체를 지우는 것은 레이아웃 재구성 / 오버레이 직후에만
+    if (screenDirty) {
+        clear();
+        wnoutrefresh(stdscr);
+        screenDirty = false;
     }
-    
-    gameMap.snakeHeadObject.snakeBodySegments.pop_back();
-    return true;
+
+    ProfileScope drawScope(profiler, TickPhase::DRAW);
+    boardRenderer.draw(boardWindow->get(), *this);
+    wnoutrefresh(boardWindow->get());
+
+    HudState hud = currentHud();
+    if (!hudDrawn || !hud.sameScore(drawnHud)) {
+        werase(scoreWindow->get());
+        box(scoreWindow->get(), 0, 0);
+        drawScore(scoreWindow->get());
+        wnoutrefresh(scoreWindow->get());
+    }
+    if (!hudDrawn || !hud.sameMission(drawnHud)) {
+        werase(missionWindow->get());
+        box(missionWindow->get(), 0, 0);
+        drawMission(missionWindow->get());
+        wnoutrefresh(missionWindow->get());
+    }
+    drawnHud = hud;
+    hudDrawn = true;
+
+    ProfileScope flushScope(profiler, TickPhase::FLUSH);
+    doupdate();
 }
 
 void Game::refreshScreen()
 {
     try {
         while (true) {
-            clear();
-            
-            int term_rows, term_cols;
-            getmaxyx(stdscr, term_rows, term_cols);
-            
-            // 터미널 크기에 맞춰 UI 레이아웃 동적 조정
-            int board_width = gameMap.mapSize.width + 2;
-            int board_height = gameMap.mapSize.height + 2;
-            
-            // UI 윈도우 크기 계산 (터미널 크기에 따라 조정)
-            int ui_width = min(27, term_cols - board_width - 2);
-            if (ui_width < 15) ui_width = 15; // 최소 UI 너비
-            
-            int score_height = min(9, (term_rows - 2) / 2);
-            int mission_height = min(9, term_rows - score_height - 2);
-            
-            // UI 윈도우 위치 계산
-            int ui_x = min(board_width + 2, term_cols - ui_width);
-            if (ui_x + ui_width > term_cols) ui_x = term_cols - ui_width;
-            if (ui_x < 0) ui_x = 0;
-            
-            int score_y = 0;
-            int mission_y = score_height + 1;
-            if (mission_y + mission_height > term_rows) {
-                mission_y = term_rows - mission_height;
-                if (mission_y < 0) mission_y = 0;
-            }
-            
-            // 게임 보드가 터미널 크기를 초과하는 경우 조정
-            if (board_width > term_cols || board_height > term_rows) {
-                // 터미널이 너무 작은 경우 오버레이 모드로 전환
-                clear();
-                mvprintw(term_rows/2, (term_cols-30)/2, "Terminal too small for game board!");
-                mvprintw(term_rows/2+1, (term_cols-25)/2, "Please resize terminal window");
-                mvprintw(term_rows/2+2, (term_cols-20)/2, "Press 'q' to quit");
-                refresh();
-                
+            if (needsLayout() && !rebuildLayout()) {
                 int key = getch();
                 if (key == 'q' || key == 'Q') {
+                    if (recorder) recorder->finish();
+                    reportPacing();
+                    if (profiler) profiler->writeReport();
                     return;
                 }
+                usleep(100000);
+                frameClock.reset();
                 continue;
             }
-            
-            // RAII 패턴으로 윈도우 자동 관리
-            WindowWrapper board(board_height, board_width, 0, 0);
-            WindowWrapper score(score_height, ui_width, score_y, ui_x);
-            WindowWrapper mission(mission_height, ui_width, mission_y, ui_x);
-
-            box(board.get(), 0, 0);
-            box(score.get(), 0, 0);
-            box(mission.get(), 0, 0);
-
-            drawBoard(board.get());
-            drawScore(score.get());
-            drawMission(mission.get());
 
-            refresh();
-            wrefresh(board.get());
-            wrefresh(score.get());
-            wrefresh(mission.get());
+            renderFrame();
+            snapshots.capture(*this);
+            if (profiler && TickProfiler::consumeDumpRequest()) profiler->writeReport();
 
-            int key = getch();
-            int previousDirection = gameMap.snakeHeadObject.currentDirection;
-            processInput(key);
+            uint8_t input;
+            {
+                ProfileScope inputScope(profiler, TickPhase::INPUT);
+                input = processInput(getch());
+                if (autoplay && input == kReplayNoInput) input = processInput(autopilotKey());
+            }
 
-            if (allMissionsCompleted) {
+            StepStatus status = tick();
+            if (recorder) recorder->recordTick(input);
+            if (status == StepStatus::STAGE_CLEAR) {
                 handleMissionComplete();
+                invalidateScreen();
+                frameClock.reset();
+                if (recorder) recorder->checkpoint(*this);
                 continue;
             }
-
-            if (!update(growthItemTimer, poisonItemTimer, timeItemTimer, previousDirection)) {
+            if (status == StepStatus::GAME_OVER) {
                 handleGameOver();
+                invalidateScreen();
+                frameClock.reset();
+                if (recorder) recorder->checkpoint(*this);
                 continue;
             }
+            if (recorder) recorder->checkpoint(*this);
 
-            // 스네이크가 방향을 가지고 있을 때만 타이머 업데이트 (실제로 움직일 때만)
-            if (gameMap.snakeHeadObject.currentDirection != -1) {
-                updateTimers(growthItemTimer, poisonItemTimer, timeItemTimer);
-                gameTimerSeconds++;
-            }
-
-            usleep(1000 * static_cast<useconds_t>((float)gameSpeedDelay / speedMultiplier));
+            // 렌더링 / 갱신 시간과 무관하게 틱 마감 시각까지만 대기
+            frameClock.waitNextTick(getTickPeriodMs());
         }
     } catch (const std::exception& e) {
         cleanupNcurses();
@@ -365,63 +449,6 @@ void Game::refreshScreen()
     }
 }
 
-void Game::drawBoard(WINDOW* board)
-{
-    // Draw immune walls
-    for (const auto& wall : gameMap.immuneWalls) {
-                wattron(board, COLOR_PAIR(2));
-        mvwaddch(board, wall.coord.row, wall.coord.col, '+');
-                wattroff(board, COLOR_PAIR(2));
-            }
-    // Draw regular walls
-    for (const auto& wall : gameMap.regularWalls) {
-                wattron(board, COLOR_PAIR(2));
-        mvwaddch(board, wall.coord.row, wall.coord.col, ' ');
-                wattroff(board, COLOR_PAIR(2));
-            }
-    // Draw snake body (꼬리만 따로 색상)
-    int bodySize = gameMap.snakeHeadObject.snakeBodySegments.size();
-    for (int i = 0; i < bodySize; ++i) {
-        if (i == bodySize-1) {
-            wattron(board, COLOR_PAIR(9)); // 꼬리
-            mvwaddch(board, gameMap.snakeHeadObject.snakeBodySegments[i].coord.row, gameMap.snakeHeadObject.snakeBodySegments[i].coord.col, 'o');
-            wattroff(board, COLOR_PAIR(9));
-        } else {
-                wattron(board, COLOR_PAIR(4));
-            mvwaddch(board, gameMap.snakeHeadObject.snakeBodySegments[i].coord.row, gameMap.snakeHeadObject.snakeBodySegments[i].coord.col, 'O');
-                wattroff(board, COLOR_PAIR(4));
-            }
-    }
-    // Draw gates
-    for (const auto& gate : gameMap.gameGates) {
-                wattron(board, COLOR_PAIR(7));
-        mvwaddch(board, gate.coord.row, gate.coord.col, ' ');
-                wattroff(board, COLOR_PAIR(7));
-            }
-    // Draw snake head (노란색, 방향 문자)
-    char headChar = '>';
-    switch (gameMap.snakeHeadObject.currentDirection) {
-        case 1: headChar = '^'; break;
-        case 2: headChar = '<'; break;
-        case 3: headChar = '>'; break;
-        case 4: headChar = 'v'; break;
-        default: headChar = 'O'; break;
-    }
-    wattron(board, COLOR_PAIR(3) | A_BOLD);
-    mvwaddch(board, gameMap.snakeHeadObject.coord.row, gameMap.snakeHeadObject.coord.col, headChar);
-    wattroff(board, COLOR_PAIR(3) | A_BOLD);
-    // Draw items
-            wattron(board, COLOR_PAIR(5));
-    mvwaddch(board, gameMap.growthItemObject.coord.row, gameMap.growthItemObject.coord.col, '+');
-            wattroff(board, COLOR_PAIR(5));
-            wattron(board, COLOR_PAIR(6));
-    mvwaddch(board, gameMap.poisonItemObject.coord.row, gameMap.poisonItemObject.coord.col, '-');
-            wattroff(board, COLOR_PAIR(6));
-            wattron(board, COLOR_PAIR(8));
-    mvwaddch(board, gameMap.timeItemObject.coord.row, gameMap.timeItemObject.coord.col, 'T');
-            wattroff(board, COLOR_PAIR(8));
-}
-
 void Game::drawScore(WINDOW* score)
 {
     int height, width;
@@ -431,22 +458,28 @@ void Game::drawScore(WINDOW* score)
     if (height >= 8 && width >= 20) {
         // 표준 크기
         mvwprintw(score, 1, 1, "*******Score Board*******");
-        mvwprintw(score, 2, 1, " Stage: %d/4", currentStage);
+        if (isEndless()) mvwprintw(score, 2, 1, " Stage: %d", currentStage);
+        else mvwprintw(score, 2, 1, " Stage: %d/%d", currentStage, getStageCount());
         mvwprintw(score, 3, 1, " B: %d/%d", (int)gameMap.snakeHeadObject.snakeBodySegments.size(), maxSnakeLength);
         mvwprintw(score, 4, 1, " +: %d", growthItemCount);
         mvwprintw(score, 5, 1, " -: %d", poisonItemCount);
         mvwprintw(score, 6, 1, " G: %d", gatesUsedCount);
-        mvwprintw(score, 7, 1, " time: %d", gameTimerSeconds / (1000 / gameSpeedDelay));
+        mvwprintw(score, 7, 1, " time: %d", getElapsedSeconds());
+        if (height >= 10) {
+            mvwprintw(score, 8, 1, " seed: %llu", (unsigned long long)getSeed());
+        }
     } else if (height >= 6 && width >= 15) {
         // 중간 크기
         mvwprintw(score, 1, 1, "Score Board");
-        mvwprintw(score, 2, 1, "Stage: %d/4", currentStage);
+        if (isEndless()) mvwprintw(score, 2, 1, "Stage: %d", currentStage);
+        else mvwprintw(score, 2, 1, "Stage: %d/%d", currentStage, getStageCount());
         mvwprintw(score, 3, 1, "B:%d +:%d", (int)gameMap.snakeHeadObject.snakeBodySegments.size(), growthItemCount);
         mvwprintw(score, 4, 1, "-:%d G:%d", poisonItemCount, gatesUsedCount);
-        mvwprintw(score, 5, 1, "Time: %d", gameTimerSeconds / (1000 / gameSpeedDelay));
+        mvwprintw(score, 5, 1, "Time: %d", getElapsedSeconds());
     } else if (height >= 4 && width >= 10) {
         // 작은 크기
-        mvwprintw(score, 1, 1, "S:%d/4", currentStage);
+        if (isEndless()) mvwprintw(score, 1, 1, "S:%d", currentStage);
+        else mvwprintw(score, 1, 1, "S:%d/%d", currentStage, getStageCount());
         mvwprintw(score, 2, 1, "L:%d", (int)gameMap.snakeHeadObject.snakeBodySegments.size());
     } else {
         // 최소 크기
@@ -461,16 +494,15 @@ void Game::drawMission(WINDOW* mission)
     getmaxyx(mission, height, width);
     
     // 현재 스테이지의 미션 목표 가져오기
-    MissionTargets targets = getMissionTargets(currentStage);
+    MissionTargets targets = getCurrentMissionTargets();
     
     // 윈도우 크기에 맞춰 내용 조정
     if (height >= 7 && width >= 25) {
         // 표준 크기
         mvwprintw(mission, 1, 1, "******Mission Board******");
-        mvwprintw(mission, 2, 1, " Stage %d: %s", currentStage, 
-            currentStage == 1 ? "BASIC" :
-            currentStage == 2 ? "MAZE" :
-            currentStage == 3 ? "ISLANDS" : "CROSS");
+        // 스테이지 팩의 긴 이름은 창 너비에서 잘라 다음 줄로 넘어가지 않게
+        string stageName = getStageName();
+        mvwprintw(mission, 2, 1, " Stage %d: %.*s", currentStage, max(0, width - 13), stageName.c_str());
         mvwprintw(mission, 3, 1, " B: %d / %d (%c) ", targets.snakeLength, (int)gameMap.snakeHeadObject.snakeBodySegments.size(), missionSnakeLengthStatus);
         mvwprintw(mission, 4, 1, " +: %d / %d (%c) ", targets.growthItems, growthItemCount, missionGrowthItemStatus);
         mvwprintw(mission, 5, 1, " -: %d / %d (%c) ", targets.poisonItems, poisonItemCount, missionPoisonItemStatus);
@@ -491,90 +523,162 @@ void Game::drawMission(WINDOW* mission)
     }
 }
 
-void Game::processInput(int key)
+uint8_t Game::processInput(int key)
 {
-    int newDirection = -1;
-    
+    uint8_t input = kReplayNoInput;
+
     switch (key) {
         case KEY_UP:
-            newDirection = 1;
+            input = 1;
             break;
         case KEY_DOWN:
-            newDirection = 4;
+            input = 4;
             break;
         case KEY_RIGHT:
-            newDirection = 3;
+            input = 3;
             break;
         case KEY_LEFT:
-            newDirection = 2;
+            input = 2;
             break;
         // 디버그: D키로 미션 강제 클리어
         case 'd':
         case 'D':
-            {
-                MissionTargets targets = getMissionTargets(currentStage);
-                growthItemCount = targets.growthItems;
-                poisonItemCount = targets.poisonItems;
-                gatesUsedCount = targets.gateUses;
-                gameMap.snakeHeadObject.snakeBodySegments.resize(targets.snakeLength);
-                checkMissions();
-            }
+            input = kReplayCompleteMissions;
+            invalidateScreen();
             break;
         // 디버그: E키로 엔딩 바로 보기
         case 'e':
         case 'E':
             showEndingScreen();
+            invalidateScreen();
+            frameClock.reset();
+            break;
+        // B키로 최근 상태로 되감기 (맵을 다시 만들지 않고 저장된 틱 상태를 복원)
+        case 'b':
+        case 'B':
+        case KEY_BACKSPACE:
+            if (snapshots.rewind(*this, kRewindTicks) > 0) {
+                input = kReplayStateJump;
+                autopilot.invalidate();
+                cycleSolver.invalidate();
+                if (recorder) recorder->recordStateJump(*this);
+                invalidateScreen();
+                frameClock.reset();
+            }
+            break;
+        // A키로 자동 조종 켜기 / 끄기
+        case 'a':
+        case 'A':
+            setAutoplay(!autoplay);
+            break;
+        // 터미널 크기 변경 (ncurses가 SIGWINCH를 KEY_RESIZE로 전달)
+        case KEY_RESIZE:
+            layoutDirty = true;
             break;
         // 디버그: 1~4키로 스테이지 이동 (4스테이지까지만)
         case '1': case '2': case '3': case '4':
-            currentStage = key - '0';
-            resetCurrentStage();
+            input = static_cast<uint8_t>(kReplayJumpStage | (key - '0'));
             break;
     }
-    
-    // 방향키가 입력된 경우에만 처리
-    if (newDirection != -1) {
-        int currentDir = gameMap.snakeHeadObject.currentDirection;
-        
-        // 1. 같은 방향 키 입력은 무시
-        if (currentDir == newDirection) {
-            return;
-        }
-        
-        // 2. 역방향 이동 검사 (현재 방향이 설정되어 있을 때만)
-        if (currentDir != -1) {
-            bool isOpposite = false;
-            switch (currentDir) {
-                case 1: isOpposite = (newDirection == 4); break; // 위 ↔ 아래
-                case 2: isOpposite = (newDirection == 3); break; // 왼쪽 ↔ 오른쪽
-                case 3: isOpposite = (newDirection == 2); break; // 오른쪽 ↔ 왼쪽
-                case 4: isOpposite = (newDirection == 1); break; // 아래 ↔ 위
-            }
-            
-            if (isOpposite) {
-                // 역방향 이동 시도를 표시하기 위해 특별한 값 설정
-                gameMap.snakeHeadObject.currentDirection = -2; // 역방향 시도 표시
-                return;
-            }
-        }
-        
-        // 3. 유효한 방향 변경
-        gameMap.snakeHeadObject.currentDirection = newDirection;
+
+    // 게임 상태 변경은 리플레이와 같은 경로로 (방향 규칙은 Simulation::applyDirection)
+    applyReplayInput(*this, input);
+    return input;
+}
+
+int Game::autopilotKey()
+{
+    int direction = cycleAutoplay ? cycleSolver.chooseDirection(*this) : autopilot.chooseDirection(*this);
+    if (direction == gameMap.snakeHeadObject.currentDirection) return ERR;
+    switch (direction) {
+        case 1: return KEY_UP;
+        case 2: return KEY_LEFT;
+        case 3: return KEY_RIGHT;
+        case 4: return KEY_DOWN;
+        default: return ERR;
     }
 }
 
-void Game::updateTimers(int &growthItemTimer, int &poisonItemTimer, int &timeItemTimer)
+void Game::startRecording(const string& path)
 {
-    growthItemTimer++;
-    poisonItemTimer++;
-    timeItemTimer++;
+    recorder.reset(new ReplayWriter(path, *this));
+}
 
-    if (speedBoostTimer > 0) {
-        speedBoostTimer--;
-        if (speedBoostTimer == 0) {
-            speedMultiplier = 1;
+void Game::playReplay(const ReplayReader& replay, double speed, long startTick)
+{
+    // 리플레이 중에는 엔딩 화면 등 입력을 기다리는 화면을 띄우지 않음
+    replaying = true;
+    replay.seek(*this, startTick);
+    long tick = max(0L, min(startTick, replay.getTickCount()));
+    StepStatus pending = StepStatus::RUNNING;
+    bool paused = false;
+    frameClock.reset();
+
+    while (true) {
+        if (needsLayout() && !rebuildLayout()) {
+            int key = getch();
+            if (key == 'q' || key == 'Q') break;
+            usleep(100000);
+            frameClock.reset();
+            continue;
+        }
+
+        renderFrame();
+        int term_rows = getmaxy(stdscr);
+        int status_row = gameMap.mapSize.height + 2;
+        if (status_row < term_rows) {
+            mvprintw(status_row, 0, "REPLAY %ld/%ld  x%.2f %s  [space] pause  [<-/->] seek  [+/-] speed  [q] quit",
+                     tick, replay.getTickCount(), speed, paused ? "(paused)" : "");
+            clrtoeol();
+            refresh();
+        }
+
+        int key = getch();
+        bool seeking = false;
+        long seekTo = tick;
+        switch (key) {
+            case 'q': case 'Q':
+                replaying = false;
+                return;
+            case ' ':
+                paused = !paused;
+                break;
+            case '+':
+                speed = min(speed * 2, 64.0);
+                break;
+            case '-':
+                speed = max(speed / 2, 1.0 / 16);
+                break;
+            case KEY_LEFT:
+                seeking = true;
+                seekTo = tick - replay.getKeyframeInterval();
+                break;
+            case KEY_RIGHT:
+                seeking = true;
+                seekTo = tick + replay.getKeyframeInterval();
+                break;
+            case KEY_RESIZE:
+                layoutDirty = true;
+                break;
         }
+        if (seeking) {
+            tick = max(0L, min(seekTo, replay.getTickCount()));
+            replay.seek(*this, tick);
+            boardRenderer.invalidate();
+            pending = StepStatus::RUNNING;
+        } else if (!paused && tick < replay.getTickCount()) {
+            // 게임 오버 / 클리어 틱은 그 장면을 한 프레임 보여준 뒤 다음 단계로 넘어감
+            finishReplayTick(*this, pending);
+            // 되감기 틱은 맵을 제자리에서 복원하므로 보드 전체를 다시 그림
+            if (replay.inputAt(tick) == kReplayStateJump) boardRenderer.invalidate();
+            pending = replay.applyTick(*this, tick);
+            tick++;
+        }
+
+        double period = paused ? 50.0 : getTickPeriodMs() / speed;
+        frameClock.waitNextTick(period);
     }
+    replaying = false;
 }
 
 void Game::handleGameOver()
@@ -604,8 +708,7 @@ void Game::handleGameOver()
             while (true) {
                 char key = getch();
                 if (key == 'e' || key == 'E') {
-                    cleanupNcurses();
-                    exit(0);
+                    exitGame();
                 }
                 if (key == 'r' || key == 'R') {
                     resetCurrentStage();
@@ -711,8 +814,7 @@ void Game::handleGameOver()
 
             char key = getch();
             if (key == 'e' || key == 'E') {
-                cleanupNcurses();
-                exit(0);
+                exitGame();
             }
             if (key == 'r' || key == 'R') {
                 resetCurrentStage();
@@ -744,8 +846,7 @@ void Game::handleMissionComplete()
             while (true) {
                 char key = getch();
                 if (key == 'e' || key == 'E') {
-                    cleanupNcurses();
-                    exit(0);
+                    exitGame();
                 }
                 if (key == 'r' || key == 'R') {
                     goToNextStage();
@@ -777,8 +878,7 @@ void Game::handleMissionComplete()
 
             char key = getch();
             if (key == 'e' || key == 'E') {
-                cleanupNcurses();
-                exit(0);
+                exitGame();
             }
             if (key == 'r' || key == 'R') {
                 goToNextStage();
@@ -793,542 +893,6 @@ void Game::handleMissionComplete()
     }
 }
 
-void Game::resetCurrentStage()
-{
-    gameMap = Map(21, 41, rand() % 4 + 2, getMapTypeForStage(currentStage), currentStage);
-    gateActiveDuration = 0;
-    growthItemCount = 0;
-    poisonItemCount = 0;
-    gatesUsedCount = 0;
-    maxSnakeLength = 3;
-    gameTimerSeconds = 0;
-    speedMultiplier = 1;
-    
-    // 아이템 타이머들 초기화
-    growthItemTimer = 0;
-    poisonItemTimer = 0;
-    timeItemTimer = 0;
-    
-    // 미션 상태 초기화
-    missionSnakeLengthStatus = ' ';
-    missionGrowthItemStatus = ' ';
-    missionPoisonItemStatus = ' ';
-    missionGateUseStatus = ' ';
-    allMissionsCompleted = false;
-    
-    // 게임 오버 이유 초기화
-    gameOverReason = "";
-    
-    generateItems();
-    generateGate();
-    
-    // 스테이지별 게임 속도 설정 (점진적으로 빨라짐)
-    switch(currentStage) {
-        case 1: gameSpeedDelay = 250; break; // 가장 느림 (쉬움)
-        case 2: gameSpeedDelay = 200; break; // 중간
-        case 3: gameSpeedDelay = 170; break; // 빠름
-        case 4: gameSpeedDelay = 150; break; // 가장 빠름 (어려움)
-        default: gameSpeedDelay = 200; break;
-    }
-}
-
-void Game::goToNextStage()
-{
-    currentStage++;
-    if(currentStage > 4) {
-        showEndingScreen();
-        currentStage = 1;
-    }
-    resetCurrentStage();
-}
-
-void Game::checkMissions()
-{
-    MissionTargets targets = getMissionTargets(currentStage);
-    
-    missionSnakeLengthStatus = (static_cast<int>(gameMap.snakeHeadObject.snakeBodySegments.size()) >= targets.snakeLength) ? 'v' : ' ';
-    missionGrowthItemStatus = (growthItemCount >= targets.growthItems) ? 'v' : ' ';
-    missionPoisonItemStatus = (poisonItemCount >= targets.poisonItems) ? 'v' : ' ';
-    missionGateUseStatus = (gatesUsedCount >= targets.gateUses) ? 'v' : ' ';
-
-    allMissionsCompleted = (missionSnakeLengthStatus == 'v' && 
-                          missionGrowthItemStatus == 'v' && 
-                          missionPoisonItemStatus == 'v' && 
-                          missionGateUseStatus == 'v');
-}
-
-bool Game::update(int &growthItemTimer, int &poisonItemTimer, int &timeItemTimer, int previousDirection)
-{
-    // 먼저 역방향 이동 검사
-    if (gameMap.snakeHeadObject.currentDirection == -2) {
-        gameOverReason = "Tried moving in the opposite direction.";
-        return false; // 게임 종료
-    }
-    
-    if (gateActiveDuration == 0)
-    {
-        gameMap.gameGates[0].isActive = false;
-        gameMap.gameGates[1].isActive = false;
-    }
-    else
-        gateActiveDuration--;
-    
-    if (gameMap.snakeHeadObject.currentDirection != -1)
-    {
-        gameMap.snakeHeadObject.snakeBodySegments.insert(gameMap.snakeHeadObject.snakeBodySegments.begin(), SnakeBody(gameMap.snakeHeadObject));
-        gameMap.snakeHeadObject.snakeBodySegments.pop_back();
-    }
-    
-    gameMap.snakeHeadObject.move();
-    
-    // 게이트 통과 처리
-    for (size_t i = 0; i < gameMap.gameGates.size(); i++)
-    {
-        auto it = gameMap.gameGates.begin() + i;
-        if (it->coord == gameMap.snakeHeadObject.coord)
-        {
-            it->isActive = true;
-            gateActiveDuration = static_cast<int>(gameMap.snakeHeadObject.snakeBodySegments.size());
-            auto other = (i == 0 ? gameMap.gameGates.begin() + 1 : gameMap.gameGates.begin());
-            
-            // 게이트 출구 방향 결정 및 안전한 출구 위치 계산
-            int exitDirection = other->exitDirection;
-            Coord exitPosition = other->coord;
-            
-            if (exitDirection == 6) // 자유 방향 (벽 중앙)
-            {
-                int inDir = gameMap.snakeHeadObject.currentDirection;
-                int dirPriority[4];
-                dirPriority[0] = inDir; // 진입 방향과 일치하는 방향
-                // 시계 방향
-                dirPriority[1] = (inDir == 1) ? 3 : (inDir == 2) ? 1 : (inDir == 3) ? 4 : 2;
-                // 반시계 방향
-                dirPriority[2] = (inDir == 1) ? 2 : (inDir == 2) ? 4 : (inDir == 3) ? 1 : 3;
-                // 반대 방향
-                dirPriority[3] = (inDir == 1) ? 4 : (inDir == 2) ? 3 : (inDir == 3) ? 2 : 1;
-                
-                // 가능한 방향 찾기
-                bool foundValidExit = false;
-                for (int k = 0; k < 4; ++k) {
-                    int d = dirPriority[k];
-                    Coord testPos = other->coord;
-                    switch (d) {
-                        case 1: testPos.row--; break;
-                        case 2: testPos.col--; break;
-                        case 3: testPos.col++; break;
-                        case 4: testPos.row++; break;
-                    }
-                    
-                    // 벽 충돌 검사
-                    bool blocked = false;
-                    for (const auto& w : gameMap.regularWalls) {
-                        if (w.coord == testPos) { 
-                            blocked = true; 
-                            break; 
-                        }
-                    }
-                    for (const auto& w : gameMap.immuneWalls) {
-                        if (w.coord == testPos) { 
-                            blocked = true; 
-                            break; 
-                        }
-                    }
-                    
-                    // 맵 경계 검사
-                    if (testPos.row < 1 || testPos.row >= gameMap.mapSize.height || 
-                        testPos.col < 1 || testPos.col >= gameMap.mapSize.width) {
-                        blocked = true;
-                    }
-                    
-                    if (!blocked) {
-                        exitDirection = d;
-                        exitPosition = testPos;
-                        foundValidExit = true;
-                        break;
-                    }
-                }
-                
-                // 유효한 출구를 찾지 못한 경우 게이트 위에 그대로 둠
-                if (!foundValidExit) {
-                    exitDirection = inDir;
-                    exitPosition = other->coord;
-                }
-            } else {
-                // 고정 방향인 경우에도 출구 위치 계산
-                switch (exitDirection) {
-                    case 1: exitPosition.row--; break;
-                    case 2: exitPosition.col--; break;
-                    case 3: exitPosition.col++; break;
-                    case 4: exitPosition.row++; break;
-                }
-                
-                // 출구 위치가 막혀있는지 검사
-                bool blocked = false;
-                for (const auto& w : gameMap.regularWalls) {
-                    if (w.coord == exitPosition) { 
-                        blocked = true; 
-                        break; 
-                    }
-                }
-                for (const auto& w : gameMap.immuneWalls) {
-                    if (w.coord == exitPosition) { 
-                        blocked = true; 
-                        break; 
-                    }
-                }
-                
-                // 맵 경계 검사
-                if (exitPosition.row < 1 || exitPosition.row >= gameMap.mapSize.height || 
-                    exitPosition.col < 1 || exitPosition.col >= gameMap.mapSize.width) {
-                    blocked = true;
-                }
-                
-                // 출구가 막혀있으면 게이트 위에 그대로 둠
-                if (blocked) {
-                    exitPosition = other->coord;
-                }
-            }
-            
-            // 스네이크를 안전한 출구 위치로 텔레포트
-            gameMap.snakeHeadObject.coord = exitPosition;
-            gameMap.snakeHeadObject.currentDirection = exitDirection;
-            
-            // 다른 게이트도 활성화
-            other->isActive = true;
-            
-            gatesUsedCount++;
-            break;
-        }
-    }
-
-    // 아이템 5초(50틱)마다 자동 재생성
-    if (growthItemTimer >= 50) { generateGItem(); growthItemTimer = 0; }
-    if (poisonItemTimer >= 50) { generatePItem(); poisonItemTimer = 0; }
-    if (timeItemTimer >= 50) { generateTItem(); timeItemTimer = 0; }
-
-    if (gameMap.snakeHeadObject.coord == gameMap.growthItemObject.coord)
-    {
-        beep();
-        growthItemCount++;
-        generateGItem();
-        growthItemTimer = 0;
-        safeAddSnakeBody();
-    }
-    if (gameMap.snakeHeadObject.coord == gameMap.poisonItemObject.coord)
-    {
-        beep();
-        poisonItemCount++;
-        generatePItem();
-        poisonItemTimer = 0;
-        if (!safeRemoveSnakeBody()) {
-            gameOverReason = "Length is less than 3.";
-            return false;
-        }
-    }
-    if (gameMap.snakeHeadObject.coord == gameMap.timeItemObject.coord)
-    {
-        beep();
-        generateTItem();
-        timeItemTimer = 0;
-        speedMultiplier = 1.5;
-        speedBoostTimer = 40;
-    }
-
-    // mission
-    checkMissions();
-
-    // allMissionsCompleted
-    if (static_cast<int>(gameMap.snakeHeadObject.snakeBodySegments.size()) > maxSnakeLength)
-        maxSnakeLength = static_cast<int>(gameMap.snakeHeadObject.snakeBodySegments.size());
-
-    return isValid(previousDirection);
-}
-
-bool Game::isValid(int /*previousDirection*/)
-{
-    // 역방향 이동 시도 검사
-    if (gameMap.snakeHeadObject.currentDirection == -2) {
-        gameOverReason = "Tried moving in the opposite direction.";
-        return false;
-    }
-    
-    // 게이트가 활성화된 상태인지 확인 (두 게이트 모두 확인)
-    bool isOnActiveGate = false;
-    for (const auto& gate : gameMap.gameGates) {
-        if (gate.coord == gameMap.snakeHeadObject.coord && gate.isActive) {
-            isOnActiveGate = true;
-            break;
-        }
-    }
-    
-    // 벽과의 충돌 검사 (활성화된 게이트 위에 있으면 벽 충돌 무시)
-    if (!isOnActiveGate) {
-        for (const auto& wall : gameMap.regularWalls) {
-            if (wall.coord == gameMap.snakeHeadObject.coord) {
-                gameOverReason = "Collided with the wall.";
-                return false;
-            }
-        }
-        
-        for (const auto& wall : gameMap.immuneWalls) {
-            if (wall.coord == gameMap.snakeHeadObject.coord) {
-                gameOverReason = "Collided with the immune wall.";
-                return false;
-            }
-        }
-    }
-    
-    // 몸통과 벽 충돌 검사
-    for (const auto& body : gameMap.snakeHeadObject.snakeBodySegments) {
-        for (const auto& wall : gameMap.regularWalls) {
-            if (wall.coord == body.coord) {
-                gameOverReason = "Snake body overlapped with wall.";
-                return false;
-            }
-        }
-        for (const auto& wall : gameMap.immuneWalls) {
-            if (wall.coord == body.coord) {
-                gameOverReason = "Snake body overlapped with immune wall.";
-                return false;
-            }
-        }
-    }
-    
-    // 자기 몸통과의 충돌 검사
-    for (const auto& body : gameMap.snakeHeadObject.snakeBodySegments) {
-        if (body.coord == gameMap.snakeHeadObject.coord) {
-            gameOverReason = "Collided with the body.";
-            return false;
-        }
-    }
-    
-    // 최소 길이 검사
-    if (gameMap.snakeHeadObject.snakeBodySegments.size() < 3) {
-        gameOverReason = "Length is less than 3.";
-        return false;
-    }
-    
-    return true;
-}
-
-void Game::generateRandCoord(int &row, int &col, bool shouldIncludeWall)
-    {
-        while (1)
-        {
-        row = rand() % (gameMap.mapSize.height - 1) + 2;
-        col = rand() % (gameMap.mapSize.width - 1) + 2;
-            Coord tmp;
-        tmp.row = row;
-        tmp.col = col;
-            bool same = false;
-            if (!shouldIncludeWall)
-            {
-            for (auto it = gameMap.regularWalls.begin(); it != gameMap.regularWalls.end(); it++)
-            {
-                if (it->coord == tmp)
-                    same = true;
-            }
-        }
-        for (auto it = gameMap.snakeHeadObject.snakeBodySegments.begin(); it != gameMap.snakeHeadObject.snakeBodySegments.end(); it++)
-            {
-                if (it->coord == tmp)
-                    same = true;
-            }
-        for (auto it = gameMap.gameGates.begin(); it != gameMap.gameGates.end(); it++)
-        {
-            if (it->coord == tmp)
-                same = true;
-        }
-        if (gameMap.snakeHeadObject.coord == tmp)
-            same = true;
-        if (gameMap.growthItemObject.coord == tmp)
-                same = true;
-        if (gameMap.poisonItemObject.coord == tmp)
-                same = true;
-        // 아이템이 벽에 갇히지 않도록 상하좌우가 모두 벽이 아닌지 체크
-        bool surrounded = false;
-        int dr[4] = {-1, 1, 0, 0};
-        int dc[4] = {0, 0, -1, 1};
-        int wallCount = 0;
-        for (int d = 0; d < 4; ++d) {
-            Coord adj{row + dr[d], col + dc[d]};
-            for (auto it = gameMap.regularWalls.begin(); it != gameMap.regularWalls.end(); it++) {
-                if (it->coord == adj) wallCount++;
-            }
-        }
-        if (wallCount == 4) surrounded = true;
-        if (!same && !surrounded)
-            break;
-    }
-}
-
-void Game::generateGate()
-{
-    int wallIndex1, wallIndex2;
-    
-    // 게이트로 사용 가능한 벽인지 확인하는 함수
-    auto isGateWallValid = [&](const Wall& wall) {
-        // 1. 맵 경계에서 너무 가까운 곳은 제외 (모서리 근처)
-        if (wall.coord.row <= 2 || wall.coord.row >= gameMap.mapSize.height - 1 ||
-            wall.coord.col <= 2 || wall.coord.col >= gameMap.mapSize.width - 1) {
-            return false;
-        }
-        
-        // 2. 상하좌우 중 최소 2방향이 빈 공간이어야 함 (진출로 확보)
-        int dr[4] = {-1, 1, 0, 0};
-        int dc[4] = {0, 0, -1, 1};
-        int openDirections = 0;
-        
-        for (int d = 0; d < 4; ++d) {
-            Coord adj{wall.coord.row + dr[d], wall.coord.col + dc[d]};
-            
-            // 벽이 아니고 맵 범위 내인지 확인
-            bool isWall = false;
-            for (const auto& w : gameMap.regularWalls) {
-                if (w.coord == adj) { 
-                    isWall = true; 
-                    break; 
-                }
-            }
-            for (const auto& w : gameMap.immuneWalls) {
-                if (w.coord == adj) { 
-                    isWall = true; 
-                    break; 
-                }
-            }
-            
-            // 빈 공간이고 맵 범위 내라면 진출 가능한 방향
-            if (!isWall && adj.row > 1 && adj.row < gameMap.mapSize.height && 
-                adj.col > 1 && adj.col < gameMap.mapSize.width) {
-                openDirections++;
-            }
-        }
-        
-        // 최소 3방향 이상 진출 가능해야 함 (더 안전한 게이트 생성)
-        return openDirections >= 3;
-    };
-    
-    // 유효한 벽들만 필터링
-    vector<int> validWallIndices;
-    for (size_t i = 0; i < gameMap.regularWalls.size(); ++i) {
-        if (isGateWallValid(gameMap.regularWalls[i])) {
-            validWallIndices.push_back(static_cast<int>(i));
-        }
-    }
-    
-    // 유효한 벽이 2개 이상 있어야 게이트 생성 가능
-    if (validWallIndices.size() < 2) {
-        // 유효한 벽이 부족하면 기준을 낮춰서 다시 시도 (최소 2방향)
-        validWallIndices.clear();
-        for (size_t i = 0; i < gameMap.regularWalls.size(); ++i) {
-            const Wall& wall = gameMap.regularWalls[i];
-            if (wall.coord.row > 2 && wall.coord.row < gameMap.mapSize.height - 2 &&
-                wall.coord.col > 2 && wall.coord.col < gameMap.mapSize.width - 2) {
-                
-                // 최소 1방향이라도 열려있으면 사용
-                int dr[4] = {-1, 1, 0, 0};
-                int dc[4] = {0, 0, -1, 1};
-                bool hasOpenDirection = false;
-                
-                for (int d = 0; d < 4; ++d) {
-                    Coord adj{wall.coord.row + dr[d], wall.coord.col + dc[d]};
-                    bool isWall = false;
-                    for (const auto& w : gameMap.regularWalls) {
-                        if (w.coord == adj) { isWall = true; break; }
-                    }
-                    for (const auto& w : gameMap.immuneWalls) {
-                        if (w.coord == adj) { isWall = true; break; }
-                    }
-                    if (!isWall) {
-                        hasOpenDirection = true;
-                        break;
-                    }
-                }
-                
-                if (hasOpenDirection) {
-                    validWallIndices.push_back(static_cast<int>(i));
-                }
-            }
-        }
-    }
-    
-    if (validWallIndices.size() >= 2) {
-        // 유효한 벽들 중에서 랜덤 선택
-        wallIndex1 = validWallIndices[rand() % validWallIndices.size()];
-        do {
-            wallIndex2 = validWallIndices[rand() % validWallIndices.size()];
-        } while (wallIndex1 == wallIndex2);
-    } else {
-        // 최후의 수단: 테두리 벽 중에서 모서리가 아닌 곳 선택
-        vector<int> borderWalls;
-        for (size_t i = 0; i < gameMap.regularWalls.size(); ++i) {
-            const Wall& wall = gameMap.regularWalls[i];
-            // 테두리 벽 중에서 모서리가 아닌 곳만 선택
-            if ((wall.coord.row == 1 && wall.coord.col > 5 && wall.coord.col < gameMap.mapSize.width - 4) ||
-                (wall.coord.row == gameMap.mapSize.height && wall.coord.col > 5 && wall.coord.col < gameMap.mapSize.width - 4) ||
-                (wall.coord.col == 1 && wall.coord.row > 5 && wall.coord.row < gameMap.mapSize.height - 4) ||
-                (wall.coord.col == gameMap.mapSize.width && wall.coord.row > 5 && wall.coord.row < gameMap.mapSize.height - 4)) {
-                borderWalls.push_back(static_cast<int>(i));
-            }
-        }
-        
-        if (borderWalls.size() >= 2) {
-            wallIndex1 = borderWalls[rand() % borderWalls.size()];
-            do {
-                wallIndex2 = borderWalls[rand() % borderWalls.size()];
-            } while (wallIndex1 == wallIndex2);
-        } else {
-            // 최종 보장: 무작위로 두 개의 다른 벽 선택
-            wallIndex1 = rand() % gameMap.regularWalls.size();
-            do {
-                wallIndex2 = rand() % gameMap.regularWalls.size();
-            } while (wallIndex1 == wallIndex2);
-        }
-    }
-    
-    gameMap.gameGates[0] = Gate(gameMap.regularWalls[wallIndex1]);
-    gameMap.gameGates[1] = Gate(gameMap.regularWalls[wallIndex2]);
-}
-
-void Game::generateItems()
-    {
-        generateGItem();
-        generatePItem();
-        generateTItem();
-    }
-
-void Game::generateTItem()
-    {
-    int row, col;
-        generateRandCoord(row, col);
-    gameMap.timeItemObject = TimeItem(row, col);
-    }
-
-void Game::generateGItem()
-    {
-    int row, col;
-        generateRandCoord(row, col);
-    gameMap.growthItemObject = GrowthItem(row, col);
-    }
-
-void Game::generatePItem()
-    {
-    int row, col;
-        generateRandCoord(row, col);
-    gameMap.poisonItemObject = PoisonItem(row, col);
-}
-
-MapType Game::getMapTypeForStage(int stage)
-{
-    switch(stage) {
-        case 1: return MapType::BASIC;
-        case 2: return MapType::MAZE;
-        case 3: return MapType::ISLANDS;
-        case 4: return MapType::CROSS;
-        default: return MapType::BASIC;
-    }
-}
-
 void Game::showEndingScreen()
 {
     try {
@@ -1374,8 +938,7 @@ void Game::showEndingScreen()
         while (true) {
             int ch = wgetch(ending.get());
             if (ch == 'q' || ch == 'Q') {
-                cleanupNcurses();
-                exit(0);
+                exitGame();
             }
             if (ch == 'r' || ch == 'R') {
                 clear();
@@ -1391,20 +954,4 @@ void Game::showEndingScreen()
     }
 }
 
-Game::MissionTargets Game::getMissionTargets(int stage)
-{
-    switch(stage) {
-        case 1: // 스테이지 1: 쉬운 입문 난이도
-            return {5, 3, 1, 1}; // 길이 5, +아이템 3개, -아이템 1개, 게이트 1회
-        case 2: // 스테이지 2: 중간 난이도 (미로)
-            return {7, 5, 2, 2}; // 길이 7, +아이템 5개, -아이템 2개, 게이트 2회
-        case 3: // 스테이지 3: 높은 난이도 (섬)
-            return {9, 7, 3, 3}; // 길이 9, +아이템 7개, -아이템 3개, 게이트 3회
-        case 4: // 스테이지 4: 최고 난이도 (십자형) - 플레이 가능한 수준
-            return {12, 8, 4, 2}; // 길이 12, +아이템 8개, -아이템 4개, 게이트 2회
-        default:
-            return {5, 3, 1, 1}; // 기본값
-    }
-}
-
 #endif
\ No newline at end of file
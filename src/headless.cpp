@@ -0,0 +1,167 @@
+#include "headless.h"
+#include "batch_env.h"
+#include "autopilot.h"
+#include "cycle_solver.h"
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+
+int greedyDirection(const Simulation& sim)
+{
+    const Map& map = sim.getMap();
+    const SnakeHead& head = map.snakeHeadObject;
+    // 성장 미션을 채운 뒤 독 미션이 남았으면 독 아이템을 목표로 삼는다
+    Simulation::MissionTargets targets = sim.getCurrentMissionTargets();
+    bool wantsPoison = sim.getPoisonItemCount() < targets.poisonItems &&
+                       sim.getGrowthItemCount() >= targets.growthItems &&
+                       static_cast<int>(head.snakeBodySegments.size()) > targets.snakeLength;
+    const Coord target = wantsPoison ? map.poisonItemObject.coord : map.growthItemObject.coord;
+    int currentDir = head.currentDirection;
+
+    static const int dr[5] = {0, -1, 0, 0, 1};
+    static const int dc[5] = {0, 0, -1, 1, 0};
+
+    int bestDir = (currentDir >= 1 && currentDir <= 4) ? currentDir : 0;
+    int bestScore = -1;
+    for (int d = 1; d <= 4; ++d) {
+        // 역방향은 즉시 게임 오버이므로 후보에서 제외
+        if (currentDir >= 1 && currentDir <= 4 && d + currentDir == 5) continue;
+
+        Coord next{head.coord.row + dr[d], head.coord.col + dc[d]};
+        bool isGate = false;
+        for (const auto& gate : map.gameGates) {
+            if (gate.coord == next) isGate = true;
+        }
+        if (map.isWall(next) && !isGate) continue;
+        if (map.bodyCountAt(next) > 0) continue;
+        if (!wantsPoison && next == map.poisonItemObject.coord) continue;
+
+        int distance = abs(next.row - target.row) + abs(next.col - target.col);
+        int score = 100000 - distance;
+        if (score > bestScore) {
+            bestScore = score;
+            bestDir = d;
+        }
+    }
+    return bestDir;
+}
+
+void runHeadlessGame(Simulation& sim, const HeadlessOptions& options, HeadlessStats& stats)
+{
+    stats.games++;
+    Autopilot autopilot;
+    CycleSolver cycleSolver;
+    for (long t = 0; t < options.maxTicksPerGame; ++t) {
+        int action = options.cycleSolver ? cycleSolver.chooseDirection(sim)
+                   : options.autopilot ? autopilot.chooseDirection(sim)
+                   : greedyDirection(sim);
+        StepStatus status = sim.step(action);
+        stats.ticks++;
+        if (sim.getMaxSnakeLength() > stats.bestLength) {
+            stats.bestLength = sim.getMaxSnakeLength();
+        }
+        if (status == StepStatus::GAME_OVER) {
+            stats.gameOvers++;
+            return;
+        }
+        if (sim.isBoardFull()) {
+            // 더 놓을 빈 칸이 없음: 내구 실행의 끝
+            stats.boardsFilled++;
+            return;
+        }
+        if (status == StepStatus::STAGE_CLEAR) {
+            stats.stagesCleared++;
+            if (sim.getCurrentStage() >= sim.getStageCount()) {
+                stats.allStagesCleared++;
+                return;
+            }
+            sim.goToNextStage();
+        }
+    }
+    stats.timeouts++;
+}
+
+HeadlessStats runHeadless(const HeadlessOptions& options)
+{
+    HeadlessStats stats;
+    auto begin = chrono::steady_clock::now();
+    for (int g = 0; g < options.games; ++g) {
+        Simulation sim(options.seed + static_cast<uint64_t>(g), options.boardHeight, options.boardWidth);
+        if (options.stagePack) sim.setStagePack(options.stagePack);
+        if (options.wallDensity > 0) sim.setProceduralStages(options.wallDensity);
+        sim.setProfiler(options.profiler);
+        sim.jumpToStage(options.startStage);
+        runHeadlessGame(sim, options, stats);
+    }
+    stats.elapsedSeconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+    return stats;
+}
+
+HeadlessStats runHeadlessBatch(const HeadlessOptions& options)
+{
+    HeadlessStats stats;
+    auto begin = chrono::steady_clock::now();
+    BatchEnv env(options.batchSize, options.startStage, options.seed);
+    for (long t = 0; t < options.maxTicksPerGame; ++t) {
+        env.stepGreedy(nullptr);
+    }
+    // 게임 = 게임 오버 / 마지막 스테이지 클리어로 끝난 게임 + 마지막 틱에 진행 중이던 게임 (시간 초과)
+    stats.games = env.gameOvers() + env.finishedRuns() + options.batchSize;
+    stats.ticks = env.totalSteps();
+    stats.stagesCleared = env.stageClears();
+    stats.allStagesCleared = env.finishedRuns();
+    stats.gameOvers = env.gameOvers();
+    stats.timeouts = options.batchSize;
+    for (int i = 0; i < env.size(); ++i) {
+        if (env.maxLengths()[i] > stats.bestLength) stats.bestLength = env.maxLengths()[i];
+    }
+    stats.elapsedSeconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+    return stats;
+}
+
+HeadlessStats runReplayHeadless(const ReplayReader& replay, shared_ptr<const StagePack> stagePack)
+{
+    HeadlessStats stats;
+    auto begin = chrono::steady_clock::now();
+    Simulation sim(replay.getSeed());
+    if (stagePack) sim.setStagePack(move(stagePack));
+    replay.seek(sim, 0);
+    stats.games = 1;
+    for (long t = 0; t < replay.getTickCount(); ++t) {
+        StepStatus status = replay.applyTick(sim, t);
+        stats.ticks++;
+        if (sim.getMaxSnakeLength() > stats.bestLength) {
+            stats.bestLength = sim.getMaxSnakeLength();
+        }
+        if (status == StepStatus::GAME_OVER) {
+            stats.gameOvers++;
+            stats.lastGameOverReason = sim.getGameOverReason();
+        } else if (status == StepStatus::STAGE_CLEAR) {
+            stats.stagesCleared++;
+            if (sim.getCurrentStage() >= sim.getStageCount()) stats.allStagesCleared++;
+        }
+        finishReplayTick(sim, status);
+    }
+    stats.elapsedSeconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+    return stats;
+}
+
+void printHeadlessStats(const HeadlessStats& stats, ostream& out)
+{
+    out << "games: " << stats.games << "\n"
+        << "ticks: " << stats.ticks << "\n"
+        << "stages cleared: " << stats.stagesCleared << "\n"
+        << "all stages cleared: " << stats.allStagesCleared << "\n"
+        << "game overs: " << stats.gameOvers << "\n"
+        << "timeouts: " << stats.timeouts << "\n"
+        << "boards filled: " << stats.boardsFilled << "\n"
+        << "best length: " << stats.bestLength << "\n"
+        << "elapsed: " << stats.elapsedSeconds << " s\n";
+    if (!stats.lastGameOverReason.empty()) {
+        out << "last game over: " << stats.lastGameOverReason << "\n";
+    }
+    if (stats.elapsedSeconds > 0) {
+        out << "ticks/s: " << static_cast<long>(stats.ticks / stats.elapsedSeconds) << "\n";
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+#include "simulation.h"
+#include "replay.h"
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace std;
+
+// 터미널 없이 게임을 반복 실행하기 위한 옵션
+struct HeadlessOptions {
+    int games = 1;            // 실행할 게임 수
+    int startStage = 1;       // 시작 스테이지 (1~스테이지 수)
+    long maxTicksPerGame = 100000; // 게임당 최대 틱 (무한 루프 방지)
+    int batchSize = 0;        // 0보다 크면 BatchEnv로 batchSize개 게임을 동시에 진행
+    uint64_t seed = 0;        // 기준 시드 (g번째 게임은 seed + g)
+    int boardHeight = Simulation::kDefaultBoardHeight; // 보드 크기 (배치 모드는 기본 크기만 지원)
+    int boardWidth = Simulation::kDefaultBoardWidth;
+    shared_ptr<const StagePack> stagePack; // 설정 시 내장 스테이지 대신 사용 (배치 모드 제외)
+    int wallDensity = 0;      // 0보다 크면 이 벽 밀도(%)의 절차적 스테이지로 끝없이 진행 (배치 모드 제외)
+    TickProfiler* profiler = nullptr; // 설정 시 시뮬레이션 구간 시간 측정 (배치 모드 제외)
+    bool autopilot = false;   // true면 greedyDirection 대신 Autopilot(너비 우선 탐색)으로 진행 (배치 모드 제외)
+    bool cycleSolver = false; // true면 CycleSolver(해밀턴 순환 추종)로 진행 (autopilot보다 우선)
+};
+
+// 헤드리스 실행 누적 결과
+struct HeadlessStats {
+    long games = 0;
+    long ticks = 0;
+    long stagesCleared = 0;
+    long allStagesCleared = 0;
+    long gameOvers = 0;
+    long timeouts = 0;
+    long boardsFilled = 0;    // 빈 칸이 없어 아이템을 놓지 못해 끝난 게임
+    int bestLength = 0;
+    double elapsedSeconds = 0;
+    string lastGameOverReason;
+};
+
+// 기본 봇: 벽/몸통을 피하면서 성장 아이템 쪽으로 이동하는 방향을 고른다
+int greedyDirection(const Simulation& sim);
+
+// 한 게임을 끝날 때까지 진행하고 결과를 stats에 누적
+void runHeadlessGame(Simulation& sim, const HeadlessOptions& options, HeadlessStats& stats);
+
+HeadlessStats runHeadless(const HeadlessOptions& options);
+// 배치 모드: batchSize개 게임을 maxTicksPerGame 틱 동안 동시에 진행
+HeadlessStats runHeadlessBatch(const HeadlessOptions& options);
+// 리플레이 파일의 모든 틱을 화면 없이 최대 속도로 재생 (스테이지 팩으로 기록했으면 같은 팩 필요)
+HeadlessStats runReplayHeadless(const ReplayReader& replay, shared_ptr<const StagePack> stagePack = nullptr);
+void printHeadlessStats(const HeadlessStats& stats, ostream& out);
+
+#endif
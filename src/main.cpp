@@ -1,9 +1,18 @@
 #include <vector>
 #include "game.h"
+#include "headless.h"
+#include "arena_view.h"
+#include "rollout_runner.h"
+#include "stage_pack.h"
 #include <ncurses.h>
 #include <locale.h>
 #include <stdexcept>
 #include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <chrono>
+#include <limits>
 
 using namespace std;
 
@@ -83,7 +92,7 @@ void drawMainMenu(int selectedOption) {
     // 아트와 메뉴의 크기
     int art_height = 7;
     int art_width = 44;
-    int menu_height = 7;
+    int menu_height = 8;
     int menu_width = 38;
     int total_height = art_height + menu_height + 4;
     int total_width = (art_width > menu_width ? art_width : menu_width) + 4;
@@ -123,17 +132,19 @@ void drawMainMenu(int selectedOption) {
     attron(A_BOLD);
     mvprintw(menu_start_row + 1, menu_start_col + (menu_width-9)/2, "MAIN MENU");
     attroff(A_BOLD);
-    for(int i = 1; i <= 3; i++) {
+    for(int i = 1; i <= 4; i++) {
         if(i == selectedOption) {
             attron(A_STANDOUT);
             mvprintw(menu_start_row + 2 + i, menu_start_col + (menu_width-16)/2, "> %s", 
                 i == 1 ? "Play Game" :
-                i == 2 ? "How to Play" : "Exit");
+                i == 2 ? "Autoplay" :
+                i == 3 ? "How to Play" : "Exit");
             attroff(A_STANDOUT);
         } else {
             mvprintw(menu_start_row + 2 + i, menu_start_col + (menu_width-16)/2, "  %s", 
                 i == 1 ? "Play Game" :
-                i == 2 ? "How to Play" : "Exit");
+                i == 2 ? "Autoplay" :
+                i == 3 ? "How to Play" : "Exit");
         }
     }
     
@@ -188,6 +199,7 @@ void showHowToPlay() {
         mvwprintw(howto.get(), 3, 3, "Controls:");
         mvwprintw(howto.get(), 4, 8, "↑↓←→ : Move the snake");
         mvwprintw(howto.get(), 5, 8, "Enter : Select menu option");
+        mvwprintw(howto.get(), 6, 8, "A : Toggle autoplay");
         mvwprintw(howto.get(), 7, 3, "Items:");
         mvwprintw(howto.get(), 8, 8, "+ : Growth Item (Increase length)");
         mvwprintw(howto.get(), 9, 8, "- : Poison Item (Decrease length)");
@@ -209,8 +221,275 @@ void showHowToPlay() {
     }
 }
 
-int main() {
+// 명령행 옵션
+struct CommandLineOptions {
+    bool headless = false;
+    HeadlessOptions headlessOptions;
+    int rollouts = 0;   // 0보다 크면 병렬 롤아웃 실행
+    int threads = 0;    // 0이면 하드웨어 스레드 수
+    bool pacingStats = false;
+    bool hasSeed = false;
+    uint64_t seed = 0;  // --seed 미지정 시 현재 시각에서 생성
+    string recordPath;  // 비어 있지 않으면 게임을 리플레이 파일로 기록
+    string replayPath;  // 비어 있지 않으면 리플레이 재생
+    double replaySpeed = 1.0;
+    long replayStart = 0;
+    string profilePath; // 비어 있지 않으면 틱 구간별 시간 분포를 이 파일에 기록
+    bool autoplay = false; // 메뉴의 Play Game도 자동 조종으로 시작 (헤드리스면 Autopilot 봇 사용)
+    bool cycleSolver = false; // 자동 조종에 해밀턴 순환 추종 사용
+    string stagesPath;  // 비어 있지 않으면 내장 스테이지 대신 이 스테이지 팩 사용
+    int wallDensity = 0; // 0보다 크면 절차적 스테이지 (내부 벽 밀도 %)
+    int arenaSnakes = 0; // 0보다 크면 이 수의 스네이크가 한 맵을 함께 쓰는 아레나 모드
+};
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options]\n"
+              << "  --headless          터미널 없이 봇으로 게임 실행\n"
+              << "  --games N           헤드리스 게임 수 (기본 1)\n"
+              << "  --stage S           헤드리스 시작 스테이지 (기본 1, 내장 스테이지는 1~4)\n"
+              << "  --max-ticks T       게임당 최대 틱 (기본 100000)\n"
+              << "  --batch N           N개 게임을 배치 엔진으로 동시에 진행\n"
+              << "  --rollouts N        N개 완주 게임을 모든 코어에서 병렬 실행\n"
+              << "  --threads T         롤아웃 스레드 수 (기본: 코어 수)\n"
+              << "  --seed S            난수 시드 (같은 시드 = 같은 게임 진행)\n"
+              << "  --board HxW         보드 크기 (기본 21x41, 각 변 10~16384)\n"
+              << "  --stages FILE       mapc로 만든 스테이지 팩(.stgp)으로 플레이 (보드 크기는 팩이 정함)\n"
+              << "  --procedural D      스테이지마다 벽 밀도 D%(1~40)의 새 맵을 생성해 끝없이 진행\n"
+              << "                      (내부 벽은 최대 262144개: 큰 보드는 실제 밀도가 낮아지며 시작 시 알림)\n"
+              << "  --arena N           N마리가 한 맵을 함께 쓰는 아레나 (방향키로 0번 조종, --autoplay면 관전,\n"
+              << "                      --headless면 --max-ticks 틱 동안 봇끼리 실행한 통계 출력)\n"
+              << "  --pacing-stats      게임 종료 시 틱 간격(지터) 통계 출력\n"
+              << "  --autoplay          너비 우선 탐색 자동 조종으로 플레이 (헤드리스 봇에도 적용)\n"
+              << "  --cycle             자동 조종을 해밀턴 순환 추종으로 (판을 채우는 쪽으로 버티는 내구 실행용)\n"
+              << "  --profile FILE      틱 구간별 시간 분포를 종료 시 / SIGUSR1 수신 시 FILE에 기록\n"
+              << "  --record FILE       게임 입력을 리플레이 파일로 기록\n"
+              << "  --replay FILE       리플레이 재생 (--headless와 함께면 최대 속도로 검증)\n"
+              << "  --replay-speed X    리플레이 재생 배속 (기본 1)\n"
+              << "  --replay-start T    리플레이를 T번째 틱부터 재생\n";
+}
+
+bool parseCommandLine(int argc, char* argv[], CommandLineOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (strcmp(arg, "--headless") == 0) {
+            options.headless = true;
+        } else if (strcmp(arg, "--games") == 0 && hasValue) {
+            options.headlessOptions.games = atoi(argv[++i]);
+        } else if (strcmp(arg, "--stage") == 0 && hasValue) {
+            options.headlessOptions.startStage = atoi(argv[++i]);
+        } else if (strcmp(arg, "--max-ticks") == 0 && hasValue) {
+            options.headlessOptions.maxTicksPerGame = atol(argv[++i]);
+        } else if (strcmp(arg, "--batch") == 0 && hasValue) {
+            options.headlessOptions.batchSize = atoi(argv[++i]);
+        } else if (strcmp(arg, "--rollouts") == 0 && hasValue) {
+            options.rollouts = atoi(argv[++i]);
+        } else if (strcmp(arg, "--threads") == 0 && hasValue) {
+            options.threads = atoi(argv[++i]);
+        } else if (strcmp(arg, "--pacing-stats") == 0) {
+            options.pacingStats = true;
+        } else if (strcmp(arg, "--autoplay") == 0) {
+            options.autoplay = true;
+            options.headlessOptions.autopilot = true;
+        } else if (strcmp(arg, "--cycle") == 0) {
+            options.autoplay = true;
+            options.cycleSolver = true;
+            options.headlessOptions.cycleSolver = true;
+        } else if (strcmp(arg, "--profile") == 0 && hasValue) {
+            options.profilePath = argv[++i];
+        } else if (strcmp(arg, "--record") == 0 && hasValue) {
+            options.recordPath = argv[++i];
+        } else if (strcmp(arg, "--replay") == 0 && hasValue) {
+            options.replayPath = argv[++i];
+        } else if (strcmp(arg, "--replay-speed") == 0 && hasValue) {
+            options.replaySpeed = atof(argv[++i]);
+        } else if (strcmp(arg, "--replay-start") == 0 && hasValue) {
+            options.replayStart = atol(argv[++i]);
+        } else if (strcmp(arg, "--board") == 0 && hasValue) {
+            int height = 0, width = 0;
+            if (sscanf(argv[++i], "%dx%d", &height, &width) != 2) {
+                std::cerr << "Board size must look like HxW (e.g. 21x41)" << std::endl;
+                return false;
+            }
+            options.headlessOptions.boardHeight = height;
+            options.headlessOptions.boardWidth = width;
+        } else if (strcmp(arg, "--stages") == 0 && hasValue) {
+            options.stagesPath = argv[++i];
+        } else if (strcmp(arg, "--procedural") == 0 && hasValue) {
+            options.wallDensity = atoi(argv[++i]);
+            if (options.wallDensity < 1 || options.wallDensity > Map::kMaxWallDensity) {
+                std::cerr << "Wall density must be between 1 and " << Map::kMaxWallDensity << std::endl;
+                return false;
+            }
+        } else if (strcmp(arg, "--arena") == 0 && hasValue) {
+            options.arenaSnakes = atoi(argv[++i]);
+            if (options.arenaSnakes < 1 || options.arenaSnakes > Arena::kMaxSnakes) {
+                std::cerr << "Arena snake count must be between 1 and " << Arena::kMaxSnakes << std::endl;
+                return false;
+            }
+        } else if (strcmp(arg, "--seed") == 0 && hasValue) {
+            options.seed = strtoull(argv[++i], nullptr, 0);
+            options.hasSeed = true;
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return false;
+        }
+    }
+    const HeadlessOptions& board = options.headlessOptions;
+    if (board.boardHeight < Simulation::kMinBoardSize || board.boardWidth < Simulation::kMinBoardSize ||
+        board.boardHeight > Simulation::kMaxBoardSize || board.boardWidth > Simulation::kMaxBoardSize) {
+        std::cerr << "Board size must be between " << Simulation::kMinBoardSize << " and "
+                  << Simulation::kMaxBoardSize << std::endl;
+        return false;
+    }
+    if (board.batchSize > 0 && (board.boardHeight != Simulation::kDefaultBoardHeight ||
+                                board.boardWidth != Simulation::kDefaultBoardWidth)) {
+        std::cerr << "--batch supports only the default board size" << std::endl;
+        return false;
+    }
+    if (!options.stagesPath.empty() && (board.batchSize > 0 ||
+                                        board.boardHeight != Simulation::kDefaultBoardHeight ||
+                                        board.boardWidth != Simulation::kDefaultBoardWidth)) {
+        std::cerr << "--stages cannot be combined with --board or --batch" << std::endl;
+        return false;
+    }
+    if (options.wallDensity > 0 && (board.batchSize > 0 || !options.stagesPath.empty())) {
+        std::cerr << "--procedural cannot be combined with --stages or --batch" << std::endl;
+        return false;
+    }
+    if (options.wallDensity > 0) {
+        // 큰 보드는 벽 수 상한(Map::kMaxProceduralWalls)에 걸려 요청보다 낮은 밀도로 만들어지므로 실제 값을 알림
+        int64_t interior = static_cast<int64_t>(board.boardHeight - 2) * (board.boardWidth - 2);
+        int64_t requested = interior * options.wallDensity / 100;
+        int64_t walls = Map::proceduralWallTarget(board.boardHeight, board.boardWidth, options.wallDensity);
+        if (walls < requested) {
+            std::cerr << "Note: wall density " << options.wallDensity << "% needs " << requested
+                      << " walls on this board; procedural maps are capped at " << walls << " walls ("
+                      << 100.0 * static_cast<double>(walls) / static_cast<double>(interior) << "%)" << std::endl;
+        }
+    }
+    if (options.arenaSnakes > 0 && (board.batchSize > 0 || options.rollouts > 0 || !options.stagesPath.empty() ||
+                                    !options.replayPath.empty() || !options.recordPath.empty())) {
+        std::cerr << "--arena cannot be combined with --batch, --rollouts, --stages, --replay or --record" << std::endl;
+        return false;
+    }
+    if (options.replaySpeed <= 0) {
+        std::cerr << "Replay speed must be positive" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
     setlocale(LC_ALL, "");
+
+    CommandLineOptions options;
+    if (!parseCommandLine(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (!options.hasSeed) {
+        options.seed = static_cast<uint64_t>(
+            chrono::high_resolution_clock::now().time_since_epoch().count());
+    }
+    options.headlessOptions.seed = options.seed;
+    options.headlessOptions.wallDensity = options.wallDensity;
+
+    // 스테이지 팩은 한 번만 매핑해서 모든 게임 / 스레드가 공유
+    shared_ptr<const StagePack> stagePack;
+    if (!options.stagesPath.empty()) {
+        try {
+            stagePack = make_shared<const StagePack>(options.stagesPath);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        options.headlessOptions.stagePack = stagePack;
+    }
+    int stageCount = stagePack ? stagePack->size() : Simulation::kFinalStage;
+    if (options.wallDensity > 0) stageCount = numeric_limits<int>::max();
+    if (options.headlessOptions.startStage < 1 || options.headlessOptions.startStage > stageCount) {
+        std::cerr << "Stage must be between 1 and " << stageCount << std::endl;
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // 아레나: 헤드리스면 봇끼리 최대 속도로 진행, 아니면 관전 / 플레이 화면
+    if (options.arenaSnakes > 0) {
+        ArenaOptions arenaOptions;
+        arenaOptions.snakeCount = options.arenaSnakes;
+        arenaOptions.boardHeight = options.headlessOptions.boardHeight;
+        arenaOptions.boardWidth = options.headlessOptions.boardWidth;
+        arenaOptions.stage = options.headlessOptions.startStage;
+        arenaOptions.wallDensity = options.wallDensity;
+        arenaOptions.seed = options.seed;
+        try {
+            if (options.headless) {
+                printArenaStats(runArenaHeadless(arenaOptions, options.headlessOptions.maxTicksPerGame),
+                                arenaOptions.snakeCount, std::cout);
+                return 0;
+            }
+            Arena arena(arenaOptions);
+            NcursesInitializer ncursesInitializer;
+            ArenaScreen screen(arena, options.autoplay ? -1 : 0);
+            screen.run();
+        } catch (const std::exception& e) {
+            std::cerr << "Arena error: " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // 리플레이 재생: 헤드리스면 최대 속도, 아니면 보드 화면으로
+    if (!options.replayPath.empty()) {
+        try {
+            ReplayReader replay(options.replayPath);
+            if (options.headless) {
+                printHeadlessStats(runReplayHeadless(replay, stagePack), std::cout);
+                return 0;
+            }
+            Game replayGame(replay.getSeed());
+            if (stagePack) replayGame.setStagePack(stagePack);
+            replayGame.playReplay(replay, options.replaySpeed, options.replayStart);
+        } catch (const std::exception& e) {
+            std::cerr << "Replay error: " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // 헤드리스 모드: ncurses를 전혀 초기화하지 않음
+    if (options.headless && options.rollouts > 0) {
+        // 스테이지를 돌아가며 (스테이지, 시드) 작업 생성
+        vector<RolloutJob> jobs(options.rollouts);
+        for (int i = 0; i < options.rollouts; ++i) {
+            jobs[i].stage = (options.headlessOptions.startStage - 1 + i) % stageCount + 1;
+            jobs[i].seed = options.seed + static_cast<uint64_t>(i);
+            jobs[i].boardHeight = options.headlessOptions.boardHeight;
+            jobs[i].boardWidth = options.headlessOptions.boardWidth;
+            jobs[i].stagePack = stagePack;
+            jobs[i].wallDensity = options.wallDensity;
+        }
+        RolloutRunner runner(options.threads);
+        RolloutSummary summary = runner.run(jobs, options.headlessOptions);
+        printRolloutSummary(summary, std::cout);
+        return 0;
+    }
+    if (options.headless) {
+        unique_ptr<TickProfiler> profiler;
+        if (!options.profilePath.empty()) {
+            profiler.reset(new TickProfiler(options.profilePath));
+            options.headlessOptions.profiler = profiler.get();
+        }
+        HeadlessStats stats = options.headlessOptions.batchSize > 0
+            ? runHeadlessBatch(options.headlessOptions)
+            : runHeadless(options.headlessOptions);
+        printHeadlessStats(stats, std::cout);
+        if (profiler && !profiler->writeReport()) {
+            std::cerr << "Cannot write profile: " << options.profilePath << std::endl;
+        }
+        return 0;
+    }
     
     try {
         NcursesInitializer ncursesInitializer;
@@ -218,7 +497,13 @@ int main() {
         
         int inputCharacter, menuOptionSelected = 1;
         int lastMenuOption = 0; // 이전 메뉴 옵션을 추적
-        Game gameInstance;
+        uint64_t nextGameSeed = options.seed;
+        // 게임을 여러 번 해도 하나의 측정기에 누적
+        unique_ptr<TickProfiler> profiler;
+        if (!options.profilePath.empty()) {
+            profiler.reset(new TickProfiler(options.profilePath));
+            TickProfiler::installDumpSignal();
+        }
         
         // 초기 메뉴 그리기
         drawMainMenu(menuOptionSelected);
@@ -234,20 +519,33 @@ int main() {
             
             switch(inputCharacter) {
                 case KEY_UP:
-                    menuOptionSelected = (menuOptionSelected > 1) ? menuOptionSelected - 1 : 3;
+                    menuOptionSelected = (menuOptionSelected > 1) ? menuOptionSelected - 1 : 4;
                     break;
                 case KEY_DOWN:
-                    menuOptionSelected = (menuOptionSelected < 3) ? menuOptionSelected + 1 : 1;
+                    menuOptionSelected = (menuOptionSelected < 4) ? menuOptionSelected + 1 : 1;
                     break;
                 case 10: // Enter key
-                    if(menuOptionSelected == 1) {
-                        gameInstance = Game();
-                        gameInstance.refreshScreen();
+                    if(menuOptionSelected == 1 || menuOptionSelected == 2) {
+                        {
+                            // 게임마다 새 인스턴스 (창과 렌더러 상태를 복사하지 않음)
+                            Game gameInstance(nextGameSeed++, options.headlessOptions.boardHeight,
+                                              options.headlessOptions.boardWidth);
+                            if (stagePack) gameInstance.setStagePack(stagePack);
+                            if (options.wallDensity > 0) gameInstance.setProceduralStages(options.wallDensity);
+                            gameInstance.setPacingReport(options.pacingStats);
+                            gameInstance.setProfiler(profiler.get());
+                            gameInstance.setAutoplay(options.autoplay || menuOptionSelected == 2);
+                            gameInstance.setCycleAutoplay(options.cycleSolver);
+                            if (!options.recordPath.empty()) {
+                                gameInstance.startRecording(options.recordPath);
+                            }
+                            gameInstance.refreshScreen();
+                        }
                         // 게임에서 돌아온 후 메뉴 다시 그리기
                         drawMainMenu(menuOptionSelected);
                         lastMenuOption = menuOptionSelected;
                     }
-                    else if(menuOptionSelected == 2) {
+                    else if(menuOptionSelected == 3) {
                         nodelay(stdscr, FALSE);
                         showHowToPlay();
                         nodelay(stdscr, TRUE);
@@ -255,7 +553,8 @@ int main() {
                         drawMainMenu(menuOptionSelected);
                         lastMenuOption = menuOptionSelected;
                     }
-                    else if(menuOptionSelected == 3) {
+                    else if(menuOptionSelected == 4) {
+                        if (profiler) profiler->writeReport();
                         return 0;
                     }
                     continue; // Enter 키 처리 후 메뉴 다시 그리기 건너뛰기
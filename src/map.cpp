@@ -0,0 +1,1108 @@
+#include "map.h"
+#include "stage_layouts.h"
+#include "stage_pack.h"
+
+namespace {
+// 절차적 맵 생성 작업 버퍼 (스레드마다 하나를 스테이지마다 다시 써서 생성 중 할당을 없앰)
+struct ProceduralScratch {
+    vector<uint64_t> wallBits;
+    vector<uint64_t> reachedBits;
+    vector<int64_t> seeds;
+    vector<int64_t> doors;
+    vector<int64_t> frontier;
+};
+thread_local ProceduralScratch proceduralScratch;
+// 이보다 큰 보드(약 2048x2048 이상)의 작업 버퍼는 생성 후 돌려줌 (생성 시간에 비해 할당 비용은 무시할 만함)
+const size_t kMaxRetainedScratchWords = size_t(1) << 16;
+
+// 타일 비트 배치 (Map::tiles 참고)
+const unsigned char kTerrainMask = 0x03;
+const int kBodyShift = 2;
+const int kBodySaturated = 63;
+}
+
+// void : 0, wall : 1, immune wall : -1, gate: 2, snake head: 3, snake body: 4
+
+Map::Map(int mapHeight, int mapWidth, int /*initialWallCount*/, MapType type, int stage,
+         uint64_t layoutSeed, int wallDensity)
+    : mapSize(mapHeight, mapWidth)
+    , gameGates(2)
+    , currentMapType(type)
+{
+    reset(mapHeight, mapWidth, type, stage, layoutSeed, wallDensity);
+}
+
+void Map::reset(int mapHeight, int mapWidth, MapType type, int stage, uint64_t layoutSeed, int wallDensity)
+{
+    // 기본 크기의 내장 스테이지는 컴파일 시간 표로 한 번 만든 원본을 복사
+    // (벽 생성과 빈 칸 / 게이트 후보 계산을 스테이지마다 반복하지 않음, 복사는 기존 저장 공간에 덮어쓰며
+    //  몸통 버퍼도 이전 스테이지에서 늘린 크기를 유지)
+    StageLayouts::Layout layout;
+    if (StageLayouts::findLayout(mapHeight, mapWidth, type, stage, layout)) {
+        *this = stagePrototype(layout);
+        return;
+    }
+    mapSize = MapDimensions(mapHeight, mapWidth);
+    currentMapType = type;
+    immuneWalls.clear();
+    regularWalls.clear();
+    gameGates.assign(2, Gate());
+    growthItemObject = GrowthItem();
+    poisonItemObject = PoisonItem();
+    timeItemObject = TimeItem();
+    staticCells = nullptr;
+    gateHints.clear();
+    placeSnake(mapHeight / 2, mapWidth / 2);
+    generateWalls(type, stage, layoutSeed, wallDensity);
+    buildCellGrid();
+}
+
+Map::Map(const StageLayouts::Layout& layout)
+    : mapSize(StageLayouts::kHeight, StageLayouts::kWidth)
+    , gameGates(2)
+    , currentMapType(layout.type)
+{
+    placeSnake(StageLayouts::kHeadRow, StageLayouts::kHeadCol);
+    immuneWalls.reserve(StageLayouts::kImmuneWallCount);
+    for (const auto& cell : StageLayouts::kImmuneWalls) {
+        immuneWalls.emplace_back(cell.row, cell.col);
+    }
+    regularWalls.reserve(static_cast<size_t>(layout.count));
+    for (int i = 0; i < layout.count; ++i) {
+        regularWalls.emplace_back(layout.walls[i].row, layout.walls[i].col, layout.walls[i].positionType);
+    }
+    buildCellGrid();
+}
+
+Map::Map(const StageView& stage)
+    : mapSize(stage.header->height, stage.header->width)
+    , gameGates(2)
+    , currentMapType(MapType::CUSTOM)
+    , staticCells(stage.cells)
+{
+    const StageHeader& header = *stage.header;
+    placeSnake(header.spawnRow, header.spawnCol);
+    immuneWalls.reserve(static_cast<size_t>(header.immuneWallCount));
+    for (int i = 0; i < header.immuneWallCount; ++i) {
+        immuneWalls.emplace_back(stage.immuneWalls[i].row, stage.immuneWalls[i].col);
+    }
+    regularWalls.reserve(static_cast<size_t>(header.regularWallCount));
+    for (int i = 0; i < header.regularWallCount; ++i) {
+        regularWalls.emplace_back(stage.walls[i].row, stage.walls[i].col, stage.walls[i].positionType);
+    }
+    for (int i = 0; i < header.gateHintCount; ++i) {
+        int index = stage.gateHints[i];
+        if (index >= 0 && index < header.regularWallCount) gateHints.push_back(index);
+    }
+    buildCellGrid();
+}
+
+const Map& Map::stagePrototype(const StageLayouts::Layout& layout)
+{
+    // 처음 쓰일 때 표마다 하나씩 만들어 둠 (함수 내 정적 변수 초기화는 스레드 안전)
+    static const vector<Map> prototypes = [] {
+        vector<Map> maps;
+        maps.reserve(StageLayouts::kPatternCount);
+        for (int i = 0; i < StageLayouts::kPatternCount; ++i) {
+            maps.push_back(Map(StageLayouts::layoutOf(static_cast<StageLayouts::Pattern>(i))));
+        }
+        return maps;
+    }();
+    return prototypes[layout.pattern];
+}
+
+void Map::placeSnake(int row, int col)
+{
+    // 몸통 버퍼는 작게 시작해 필요할 때 두 배씩 늘림 (최대 맵 셀 수, 이전 스테이지에서 늘린 버퍼는 그대로 사용)
+    snakeHeadObject.coord = {row, col};
+    snakeHeadObject.currentDirection = -1;
+    snakeHeadObject.snakeBodySegments.reset(static_cast<size_t>(mapSize.height) * mapSize.width);
+    bodyJournal.valid = false;
+    for(int i = 1; i <= 3; ++i) {
+        snakeHeadObject.snakeBodySegments.pushBack({row + i, col});
+    }
+}
+
+void Map::generateWalls(MapType type, int stage, uint64_t layoutSeed, int wallDensity)
+{
+    initializeWalls();
+    if (type == MapType::BASIC) {
+        // 내부 벽 없음 (테두리만)
+    } else if (type == MapType::MAZE) {
+        generateMazeMap();
+    } else if (type == MapType::ISLANDS) {
+        generateIslandsMap();
+    } else if (type == MapType::CROSS) {
+        int rotation = (stage - 1) % 4;
+        generateCrossMap(rotation);
+    }
+    regularWalls.erase(std::remove_if(regularWalls.begin(), regularWalls.end(),
+        [&](const Wall& w) { return isNearSnake(w.coord, snakeHeadObject); }), regularWalls.end());
+    // 절차적 벽은 놓을 때 스네이크 주변을 건너뜀
+    if (type == MapType::PROCEDURAL) generateProceduralWalls(layoutSeed, wallDensity);
+}
+
+void Map::buildCellGrid()
+{
+    gridRows = mapSize.height + 2;
+    gridCols = mapSize.width + 2;
+    tiles.reset(gridRows, gridCols, 0);
+    bodyOverflow.clear();
+    bodyOnWallCount = 0;
+    bodyOnImmuneWallCount = 0;
+
+    // 스테이지 팩 맵은 매핑된 셀 격자를 그대로 읽으므로 타일의 벽 층을 채우지 않음
+    if (!staticCells) {
+        for (const auto& wall : regularWalls) {
+            if (isInGrid(wall.coord)) {
+                tiles.set(wall.coord.row, wall.coord.col, static_cast<unsigned char>(CellType::WALL));
+            }
+        }
+        for (const auto& wall : immuneWalls) {
+            if (isInGrid(wall.coord)) {
+                tiles.set(wall.coord.row, wall.coord.col, static_cast<unsigned char>(CellType::IMMUNE_WALL));
+            }
+        }
+    }
+    buildFreeCells();
+    buildGateCandidates();
+    buildLayoutHash();
+    for (const auto& body : snakeHeadObject.snakeBodySegments) {
+        markBodyCell(body, +1);
+    }
+}
+
+bool Map::isSpawnEligible(const Coord& pos) const
+{
+    // 기존 generateRandCoord의 추출 범위(2..height, 2..width)와 "사방이 벽" 조건을 그대로 따름
+    if (pos.row < 2 || pos.row > mapSize.height || pos.col < 2 || pos.col > mapSize.width) return false;
+    if (cellAt(pos) != CellType::EMPTY) return false;
+    const int dr[4] = {-1, 1, 0, 0};
+    const int dc[4] = {0, 0, -1, 1};
+    int wallCount = 0;
+    for (int d = 0; d < 4; ++d) {
+        if (cellAt({pos.row + dr[d], pos.col + dc[d]}) == CellType::WALL) wallCount++;
+    }
+    return wallCount < 4;
+}
+
+void Map::buildFreeCells()
+{
+    // 구간마다 범위 안의 칸 수로 시작해, 스폰할 수 없는 칸(벽 칸과 사방이 벽인 빈 칸)만 뺀다.
+    // 그런 칸은 모두 벽이거나 벽의 이웃이므로 벽 수에 비례하는 시간에 끝난다.
+    const int h = mapSize.height;
+    const int w = mapSize.width;
+    spanCols = (gridCols + (1 << kSpanShift) - 1) >> kSpanShift;
+    eligibleInSpan.assign(static_cast<size_t>(gridRows) * spanCols, 0);
+    for (int row = 2; row <= h; ++row) {
+        for (int span = 0; span < spanCols; ++span) {
+            int low = max(2, span << kSpanShift);
+            int high = min(w, ((span + 1) << kSpanShift) - 1);
+            if (high >= low) eligibleInSpan[static_cast<size_t>(row) * spanCols + span] = static_cast<unsigned char>(high - low + 1);
+        }
+    }
+
+    vector<int64_t>& excluded = excludedScratch;
+    excluded.clear();
+    const int dr[5] = {0, -1, 1, 0, 0};
+    const int dc[5] = {0, 0, 0, -1, 1};
+    auto consider = [&](const Coord& wall) {
+        for (int d = 0; d < 5; ++d) {
+            Coord pos{wall.row + dr[d], wall.col + dc[d]};
+            if (pos.row < 2 || pos.row > h || pos.col < 2 || pos.col > w) continue;
+            if (!isSpawnEligible(pos)) excluded.push_back(cellIndex(pos));
+        }
+    };
+    for (const auto& wall : regularWalls) consider(wall.coord);
+    for (const auto& wall : immuneWalls) consider(wall.coord);
+    sort(excluded.begin(), excluded.end());
+    excluded.erase(unique(excluded.begin(), excluded.end()), excluded.end());
+    for (int64_t index : excluded) {
+        int row = static_cast<int>(index / gridCols);
+        int col = static_cast<int>(index % gridCols);
+        eligibleInSpan[static_cast<size_t>(row) * spanCols + (col >> kSpanShift)]--;
+    }
+    excluded.clear();
+
+    eligibleBeforeRow.assign(static_cast<size_t>(gridRows) + 1, 0);
+    freeRowTree.assign(static_cast<size_t>(gridRows) + 1, 0);
+    for (int row = 0; row < gridRows; ++row) {
+        int64_t rowCount = 0;
+        for (int span = 0; span < spanCols; ++span) {
+            rowCount += eligibleInSpan[static_cast<size_t>(row) * spanCols + span];
+        }
+        eligibleBeforeRow[row + 1] = eligibleBeforeRow[row] + rowCount;
+        freeRowTree[row + 1] = rowCount;
+    }
+    // 펜윅 트리 선형 구성
+    for (int i = 1; i <= gridRows; ++i) {
+        int parent = i + (i & -i);
+        if (parent <= gridRows) freeRowTree[parent] += freeRowTree[i];
+    }
+    freeInSpan = eligibleInSpan;
+    freeCellTotal = static_cast<size_t>(eligibleBeforeRow[gridRows]);
+}
+
+void Map::addFreeCell(const Coord& pos, int delta)
+{
+    freeInSpan[static_cast<size_t>(pos.row) * spanCols + (pos.col >> kSpanShift)] += delta;
+    for (int i = pos.row + 1; i <= gridRows; i += i & -i) {
+        freeRowTree[i] += delta;
+    }
+    freeCellTotal += delta;
+}
+
+Coord Map::selectEligibleCell(int64_t k) const
+{
+    int row = static_cast<int>(upper_bound(eligibleBeforeRow.begin(), eligibleBeforeRow.end(), k) -
+                               eligibleBeforeRow.begin()) - 1;
+    int64_t remaining = k - eligibleBeforeRow[row];
+    for (int span = 0; span < spanCols; ++span) {
+        int count = eligibleInSpan[static_cast<size_t>(row) * spanCols + span];
+        if (remaining >= count) {
+            remaining -= count;
+            continue;
+        }
+        int end = min(gridCols, (span + 1) << kSpanShift);
+        for (int col = span << kSpanShift; col < end; ++col) {
+            if (!isSpawnEligible({row, col})) continue;
+            if (remaining-- == 0) return {row, col};
+        }
+    }
+    return parkedCoord();
+}
+
+Coord Map::selectFreeCell(int64_t k) const
+{
+    // 펜윅 트리를 내려가며 누적 빈 셀 수가 k를 넘는 첫 행을 찾음
+    int row = 0;
+    int64_t remaining = k;
+    int step = 1;
+    while (step * 2 <= gridRows) step *= 2;
+    for (; step > 0; step /= 2) {
+        if (row + step <= gridRows && freeRowTree[row + step] <= remaining) {
+            row += step;
+            remaining -= freeRowTree[row];
+        }
+    }
+    for (int span = 0; span < spanCols; ++span) {
+        int count = freeInSpan[static_cast<size_t>(row) * spanCols + span];
+        if (remaining >= count) {
+            remaining -= count;
+            continue;
+        }
+        int end = min(gridCols, (span + 1) << kSpanShift);
+        for (int col = span << kSpanShift; col < end; ++col) {
+            if (!isFreeCell({row, col})) continue;
+            if (remaining-- == 0) return {row, col};
+        }
+    }
+    return parkedCoord();
+}
+
+void Map::buildLayoutHash()
+{
+    // FNV-1a (크기 + 벽 목록). 벽 목록이 셀 격자를 정하므로 칸을 모두 훑지 않고 벽 수에 비례하는 시간에 끝난다.
+    uint64_t hash = 1469598103934665603ULL;
+    auto mix = [&hash](uint64_t value) {
+        hash ^= value;
+        hash *= 1099511628211ULL;
+    };
+    mix(static_cast<uint64_t>(mapSize.height));
+    mix(static_cast<uint64_t>(mapSize.width));
+    for (const auto& wall : regularWalls) {
+        mix(static_cast<uint64_t>(cellIndex(wall.coord)));
+    }
+    mix(regularWalls.size());
+    for (const auto& wall : immuneWalls) {
+        mix(static_cast<uint64_t>(cellIndex(wall.coord)));
+    }
+    layoutHash = hash;
+}
+
+void Map::buildGateCandidates()
+{
+    // 벽 배치가 바뀌는 곳은 buildCellGrid뿐이므로 여기서 한 번만 계산 (벽 수 x 4방향)
+    const int dr[4] = {-1, 1, 0, 0};
+    const int dc[4] = {0, 0, -1, 1};
+    const int h = mapSize.height;
+    const int w = mapSize.width;
+    wallOpenings.assign(regularWalls.size(), WallOpenings());
+    for (auto& list : gateCandidateLists) list.clear();
+
+    for (size_t i = 0; i < regularWalls.size(); ++i) {
+        const Coord& pos = regularWalls[i].coord;
+        WallOpenings& open = wallOpenings[i];
+        for (int d = 0; d < 4; ++d) {
+            Coord adj{pos.row + dr[d], pos.col + dc[d]};
+            if (isWall(adj)) continue;
+            open.any++;
+            if (adj.row > 1 && adj.row < h && adj.col > 1 && adj.col < w) open.inner++;
+        }
+
+        int index = static_cast<int>(i);
+        if (pos.row > 2 && pos.row < h - 1 && pos.col > 2 && pos.col < w - 1 && open.inner >= 3) {
+            gateCandidateLists[static_cast<int>(GateTier::STRICT)].push_back(index);
+        }
+        if (pos.row > 2 && pos.row < h - 2 && pos.col > 2 && pos.col < w - 2 && open.any >= 1) {
+            gateCandidateLists[static_cast<int>(GateTier::RELAXED)].push_back(index);
+        }
+        if (((pos.row == 1 || pos.row == h) && pos.col > 5 && pos.col < w - 4) ||
+            ((pos.col == 1 || pos.col == w) && pos.row > 5 && pos.row < h - 4)) {
+            gateCandidateLists[static_cast<int>(GateTier::BORDER)].push_back(index);
+        }
+    }
+}
+
+bool Map::pickGateWalls(Rng& rng, int& wallIndex1, int& wallIndex2) const
+{
+    // 서로 다른 두 개를 한 번에 뽑음: 두 번째는 첫 번째를 뺀 나머지에서 추출
+    auto pickPair = [&](const vector<int>& list) {
+        uint32_t count = static_cast<uint32_t>(list.size());
+        uint32_t first = rng.nextBelow(count);
+        uint32_t second = rng.nextBelow(count - 1);
+        if (second >= first) second++;
+        wallIndex1 = list[first];
+        wallIndex2 = list[second];
+    };
+
+    // 스테이지 파일이 게이트 후보를 지정했으면 그중에서
+    if (gateHints.size() >= 2) {
+        pickPair(gateHints);
+        return true;
+    }
+    for (const auto& list : gateCandidateLists) {
+        if (list.size() >= 2) {
+            pickPair(list);
+            return true;
+        }
+    }
+    // 최종 보장: 아무 벽이나 두 개
+    if (regularWalls.size() < 2) return false;
+    uint32_t count = static_cast<uint32_t>(regularWalls.size());
+    uint32_t first = rng.nextBelow(count);
+    uint32_t second = rng.nextBelow(count - 1);
+    if (second >= first) second++;
+    wallIndex1 = static_cast<int>(first);
+    wallIndex2 = static_cast<int>(second);
+    return true;
+}
+
+bool Map::isFreeCell(const Coord& pos) const
+{
+    if (!isInGrid(pos)) return false;
+    return !hasBody(pos) && isSpawnEligible(pos);
+}
+
+bool Map::pickFreeCell(Rng& rng, Coord& out, const Coord* excluded, size_t excludedCount) const
+{
+    if (excludedCount > kMaxPickExcluded) excludedCount = kMaxPickExcluded;
+    auto isExcluded = [&](const Coord& pos) {
+        for (size_t i = 0; i < excludedCount; ++i) {
+            if (excluded[i] == pos) return true;
+        }
+        return false;
+    };
+
+    // 보드가 대부분 비어 있으면 스폰 가능 셀 중 몇 번 뽑는 것으로 끝남
+    const int kMaxAttempts = 16;
+    int64_t eligibleTotal = eligibleBeforeRow.empty() ? 0 : eligibleBeforeRow.back();
+    if (freeCellTotal > excludedCount) {
+        for (int attempt = 0; attempt < kMaxAttempts; ++attempt) {
+            Coord pos = selectEligibleCell(rng.nextBelow(static_cast<uint32_t>(eligibleTotal)));
+            if (!hasBody(pos) && !isExcluded(pos)) {
+                out = pos;
+                return true;
+            }
+        }
+    }
+
+    // 몸통이 보드 대부분을 덮은 경우: 제외 좌표를 뺀 빈 셀 중 순번으로 균등 추출
+    // 빈 제외 칸의 셀 번호는 스택 배열에 중복 없이 정렬해 둠 (최대 kMaxPickExcluded개라 삽입 정렬)
+    int64_t excludedFree[kMaxPickExcluded];
+    size_t excludedFreeCount = 0;
+    for (size_t i = 0; i < excludedCount; ++i) {
+        if (!isFreeCell(excluded[i])) continue;
+        int64_t index = cellIndex(excluded[i]);
+        size_t slot = excludedFreeCount;
+        while (slot > 0 && excludedFree[slot - 1] > index) slot--;
+        if (slot > 0 && excludedFree[slot - 1] == index) continue;
+        for (size_t j = excludedFreeCount; j > slot; --j) excludedFree[j] = excludedFree[j - 1];
+        excludedFree[slot] = index;
+        excludedFreeCount++;
+    }
+    int64_t* excludedEnd = excludedFree + excludedFreeCount;
+    int64_t candidateCount = static_cast<int64_t>(freeCellTotal) - static_cast<int64_t>(excludedFreeCount);
+    if (candidateCount <= 0) return false;
+    int64_t k = rng.nextBelow(static_cast<uint32_t>(candidateCount));
+
+    // k번째 후보 = 앞쪽 제외 칸 수만큼 밀린 빈 셀 (제외 칸은 최대 몇 개라 몇 번 안에 수렴)
+    int64_t target = k;
+    while (true) {
+        Coord pos = selectFreeCell(target);
+        int64_t index = cellIndex(pos);
+        int64_t before = lower_bound(excludedFree, excludedEnd, index) - excludedFree;
+        bool isSkipped = binary_search(excludedFree, excludedEnd, index);
+        if (!isSkipped && target - before == k) {
+            out = pos;
+            return true;
+        }
+        target = k + before + (isSkipped ? 1 : 0);
+    }
+}
+
+bool Map::isInGrid(const Coord& pos) const
+{
+    return pos.row >= 0 && pos.row < gridRows && pos.col >= 0 && pos.col < gridCols;
+}
+
+CellType Map::cellAt(const Coord& pos) const
+{
+    if (!isInGrid(pos)) return CellType::IMMUNE_WALL;
+    if (staticCells) return static_cast<CellType>(staticCells[cellIndex(pos)]);
+    return static_cast<CellType>(tiles.get(pos.row, pos.col) & kTerrainMask);
+}
+
+int Map::bodyCountAt(const Coord& pos) const
+{
+    if (!isInGrid(pos)) return 0;
+    int count = tiles.get(pos.row, pos.col) >> kBodyShift;
+    if (count == kBodySaturated) {
+        int64_t cell = cellIndex(pos);
+        for (const auto& entry : bodyOverflow) {
+            if (entry.cell == cell) return count + entry.extra;
+        }
+    }
+    return count;
+}
+
+bool Map::hasBody(const Coord& pos) const
+{
+    return (tiles.get(pos.row, pos.col) >> kBodyShift) != 0;
+}
+
+void Map::setBodyCount(const Coord& pos, unsigned char tile, int count)
+{
+    int stored = count < kBodySaturated ? count : kBodySaturated;
+    tiles.set(pos.row, pos.col, static_cast<unsigned char>((tile & kTerrainMask) | (stored << kBodyShift)));
+    if (count < kBodySaturated && bodyOverflow.empty()) return;
+    int64_t cell = cellIndex(pos);
+    for (size_t i = 0; i < bodyOverflow.size(); ++i) {
+        if (bodyOverflow[i].cell != cell) continue;
+        if (count >= kBodySaturated) {
+            bodyOverflow[i].extra = count - kBodySaturated;
+        } else {
+            bodyOverflow[i] = bodyOverflow.back();
+            bodyOverflow.pop_back();
+        }
+        return;
+    }
+    if (count >= kBodySaturated) bodyOverflow.push_back({cell, count - kBodySaturated});
+}
+
+void Map::markBodyCell(const Coord& pos, int delta)
+{
+    // 몸통이 벽 위에 놓인 개수를 함께 추적해 충돌 검사를 O(1)로 유지 (벽 층과 몸통 수를 같은 타일에서 읽음)
+    if (!isInGrid(pos)) {
+        bodyOnImmuneWallCount += delta; // 격자 밖은 무적벽
+        return;
+    }
+    unsigned char tile = tiles.get(pos.row, pos.col);
+    CellType cell = staticCells ? static_cast<CellType>(staticCells[cellIndex(pos)])
+                                : static_cast<CellType>(tile & kTerrainMask);
+    if (cell == CellType::WALL) bodyOnWallCount += delta;
+    else if (cell == CellType::IMMUNE_WALL) bodyOnImmuneWallCount += delta;
+    int before = tile >> kBodyShift;
+    if (before == kBodySaturated) before = bodyCountAt(pos);
+    int after = before + delta;
+    setBodyCount(pos, tile, after);
+    if ((before == 0) != (after == 0) && isSpawnEligible(pos)) {
+        addFreeCell(pos, after == 0 ? +1 : -1);
+    }
+}
+
+void Map::advanceSnake()
+{
+    SnakeHead& head = snakeHeadObject;
+    if (head.currentDirection < 1 || head.currentDirection > 4) {
+        return; // 방향이 없으면 몸통도 그대로
+    }
+    // 꼬리를 먼저 비우고 이전 머리 위치를 목으로 추가 (원형 버퍼라 O(1))
+    if (!head.snakeBodySegments.empty()) {
+        markBodyCell(head.snakeBodySegments.back(), -1);
+        if (journaling) journalBackRemoval(head.snakeBodySegments.back());
+        head.snakeBodySegments.popBack();
+    }
+    head.snakeBodySegments.pushFront(head.coord);
+    markBodyCell(head.coord, +1);
+    if (journaling) bodyJournal.frontAdded++;
+    head.move();
+}
+
+void Map::teleportSnakeHead(const Coord& pos)
+{
+    // 머리는 점유 격자에 포함되지 않으므로 좌표만 갱신
+    snakeHeadObject.coord = pos;
+}
+
+void Map::appendSnakeBody(const Coord& pos)
+{
+    if (!snakeHeadObject.snakeBodySegments.pushBack(pos)) {
+        return; // 버퍼가 가득 찬 경우 (맵 전체가 몸통)
+    }
+    markBodyCell(pos, +1);
+    if (journaling) bodyJournal.backAdded++;
+}
+
+bool Map::removeSnakeTail()
+{
+    auto& segments = snakeHeadObject.snakeBodySegments;
+    if (segments.empty()) return false;
+    markBodyCell(segments.back(), -1);
+    if (journaling) journalBackRemoval(segments.back());
+    segments.popBack();
+    return true;
+}
+
+void Map::beginBodyJournal()
+{
+    journaling = true;
+    bodyJournal.valid = true;
+    bodyJournal.frontAdded = 0;
+    bodyJournal.backAdded = 0;
+    bodyJournal.baseRemaining = snakeHeadObject.snakeBodySegments.size();
+    bodyJournal.backRemoved.clear();
+}
+
+void Map::journalBackRemoval(const Coord& pos)
+{
+    // 꼬리에서 빠지는 칸: 나중에 붙은 칸이면 그 추가를 상쇄하고, 아니면 시작 시점 몸통의 칸 (그것도 다 빠졌으면 앞쪽에 붙었던 칸)
+    BodyJournal& journal = bodyJournal;
+    if (journal.backAdded > 0) {
+        journal.backAdded--;
+    } else if (journal.baseRemaining > 0) {
+        journal.baseRemaining--;
+        journal.backRemoved.push_back(pos);
+    } else if (journal.frontAdded > 0) {
+        journal.frontAdded--;
+    }
+}
+
+void Map::resizeSnakeBody(size_t length)
+{
+    auto& segments = snakeHeadObject.snakeBodySegments;
+    while (segments.size() > length) {
+        removeSnakeTail();
+    }
+    while (segments.size() < length && !segments.full()) {
+        // 꼬리 방향으로 연장 (몸통이 1개 이하면 머리 아래로)
+        Coord tail = segments.empty() ? snakeHeadObject.coord : segments.back();
+        Coord prev = segments.size() >= 2 ? segments[segments.size() - 2]
+                   : (segments.empty() ? Coord{tail.row - 1, tail.col} : snakeHeadObject.coord);
+        appendSnakeBody({tail.row - (prev.row - tail.row), tail.col - (prev.col - tail.col)});
+    }
+}
+
+bool Map::findGateExit(const Gate& exitGate, int inDirection, Coord& exitPosition, int& exitDirection) const
+{
+    exitDirection = exitGate.exitDirection;
+    exitPosition = exitGate.coord;
+    
+    if (exitDirection == 6) // 자유 방향 (벽 중앙)
+    {
+        int inDir = inDirection;
+        int dirPriority[4];
+        dirPriority[0] = inDir; // 진입 방향과 일치하는 방향
+        // 시계 방향
+        dirPriority[1] = (inDir == 1) ? 3 : (inDir == 2) ? 1 : (inDir == 3) ? 4 : 2;
+        // 반시계 방향
+        dirPriority[2] = (inDir == 1) ? 2 : (inDir == 2) ? 4 : (inDir == 3) ? 1 : 3;
+        // 반대 방향
+        dirPriority[3] = (inDir == 1) ? 4 : (inDir == 2) ? 3 : (inDir == 3) ? 2 : 1;
+        
+        // 가능한 방향 찾기
+        for (int k = 0; k < 4; ++k) {
+            int d = dirPriority[k];
+            Coord testPos = exitGate.coord;
+            switch (d) {
+                case 1: testPos.row--; break;
+                case 2: testPos.col--; break;
+                case 3: testPos.col++; break;
+                case 4: testPos.row++; break;
+            }
+            
+            // 벽 충돌 검사
+            bool blocked = isWall(testPos);
+            
+            // 맵 경계 검사
+            if (testPos.row < 1 || testPos.row >= mapSize.height || 
+                testPos.col < 1 || testPos.col >= mapSize.width) {
+                blocked = true;
+            }
+            
+            if (!blocked) {
+                exitDirection = d;
+                exitPosition = testPos;
+                return true;
+            }
+        }
+        
+        // 유효한 출구를 찾지 못한 경우 게이트 위에 그대로 둠
+        exitDirection = inDir;
+        exitPosition = exitGate.coord;
+        return false;
+    }
+    
+    // 고정 방향인 경우에도 출구 위치 계산
+    switch (exitDirection) {
+        case 1: exitPosition.row--; break;
+        case 2: exitPosition.col--; break;
+        case 3: exitPosition.col++; break;
+        case 4: exitPosition.row++; break;
+    }
+    
+    // 출구 위치가 막혀있는지 검사
+    bool blocked = isWall(exitPosition);
+    
+    // 맵 경계 검사
+    if (exitPosition.row < 1 || exitPosition.row >= mapSize.height || 
+        exitPosition.col < 1 || exitPosition.col >= mapSize.width) {
+        blocked = true;
+    }
+    
+    // 출구가 막혀있으면 게이트 위에 그대로 둠
+    if (blocked) {
+        exitPosition = exitGate.coord;
+        return false;
+    }
+    return true;
+}
+
+void Map::restoreSnake(const Coord& head, int direction, const vector<Coord>& body)
+{
+    // 몸통 전체 교체는 기록하지 않고 기록을 무효로 둠
+    bool wasJournaling = journaling;
+    journaling = false;
+    while (removeSnakeTail()) {
+    }
+    for (const Coord& segment : body) {
+        appendSnakeBody(segment);
+    }
+    snakeHeadObject.coord = head;
+    snakeHeadObject.currentDirection = direction;
+    journaling = wasJournaling;
+    bodyJournal.valid = false;
+}
+
+void Map::initializeWalls()
+{
+    // 테두리 벽 (행 우선 순서 유지, 큰 보드에서도 테두리 길이에 비례)
+    const int h = mapSize.height;
+    const int w = mapSize.width;
+    for (int i = 1; i <= h; ++i) {
+        if (i == 1 || i == h) {
+            for (int j = 1; j <= w; ++j) {
+                if (j == 1 || j == w) {
+                    immuneWalls.emplace_back(i, j);
+                } else {
+                    regularWalls.emplace_back(i, j, (i == 1 ? 1 : 4));
+                }
+            }
+        } else {
+            regularWalls.emplace_back(i, 1, 2);
+            regularWalls.emplace_back(i, w, 3);
+        }
+    }
+}
+
+void Map::generateMapByType(MapType type)
+{
+    switch(type) {
+        case MapType::BASIC:
+            break;
+        case MapType::MAZE:
+            generateMazeMap();
+            break;
+        case MapType::ISLANDS:
+            generateIslandsMap();
+            break;
+        case MapType::CROSS:
+            generateCrossMap(0);
+            break;
+        case MapType::CUSTOM:
+            // 스테이지 팩 맵은 Map(const StageView&)로만 생성
+            break;
+        case MapType::PROCEDURAL:
+            // 시드가 필요하므로 generateWalls에서만 생성
+            break;
+    }
+}
+
+void Map::generateMazeMap()
+{
+    // ㄱ, ㄴ, └, ┐ 패턴의 벽을 가장자리에서 내부로 일부만 배치
+    int h = mapSize.height;
+    int w = mapSize.width;
+
+    // 좌상단 ㄱ자
+    for (int j = 2; j <= 6; ++j)
+        if (isPositionValid({2, j}) && !isNearSnake({2, j}, snakeHeadObject))
+            regularWalls.emplace_back(2, j);
+    for (int i = 2; i <= 5; ++i)
+        if (isPositionValid({i, 6}) && !isNearSnake({i, 6}, snakeHeadObject))
+            regularWalls.emplace_back(i, 6);
+
+    // 우상단 ㄴ자
+    for (int j = w-1; j >= w-5; --j)
+        if (isPositionValid({2, j}) && !isNearSnake({2, j}, snakeHeadObject))
+            regularWalls.emplace_back(2, j);
+    for (int i = 2; i <= 5; ++i)
+        if (isPositionValid({i, w-5}) && !isNearSnake({i, w-5}, snakeHeadObject))
+            regularWalls.emplace_back(i, w-5);
+
+    // 좌하단 └자
+    for (int i = h-1; i >= h-4; --i)
+        if (isPositionValid({i, 2}) && !isNearSnake({i, 2}, snakeHeadObject))
+            regularWalls.emplace_back(i, 2);
+    for (int j = 2; j <= 5; ++j)
+        if (isPositionValid({h-4, j}) && !isNearSnake({h-4, j}, snakeHeadObject))
+            regularWalls.emplace_back(h-4, j);
+
+    // 우하단 ┐자
+    for (int i = h-1; i >= h-4; --i)
+        if (isPositionValid({i, w-1}) && !isNearSnake({i, w-1}, snakeHeadObject))
+            regularWalls.emplace_back(i, w-1);
+    for (int j = w-1; j >= w-4; --j)
+        if (isPositionValid({h-4, j}) && !isNearSnake({h-4, j}, snakeHeadObject))
+            regularWalls.emplace_back(h-4, j);
+
+    // 중앙에 짧은 벽 추가(내부 공간 충분히 확보)
+    for (int j = w/2-2; j <= w/2+2; ++j)
+        if (isPositionValid({h/2, j}) && !isNearSnake({h/2, j}, snakeHeadObject))
+            regularWalls.emplace_back(h/2, j);
+}
+
+void Map::generateIslandsMap()
+{
+    // 중앙에 섬의 테두리만 벽으로 생성
+    int centerRow = mapSize.height / 2;
+    int centerCol = mapSize.width / 2;
+    int islandHalf = min(mapSize.height, mapSize.width) / 6; // 섬 크기 조절
+    int top = centerRow - islandHalf;
+    int bottom = centerRow + islandHalf;
+    int left = centerCol - islandHalf;
+    int right = centerCol + islandHalf;
+    for (int i = top; i <= bottom; ++i) {
+        for (int j = left; j <= right; ++j) {
+            if (i == top || i == bottom || j == left || j == right) {
+                Coord pos{i, j};
+                if (isPositionValid(pos) && !isNearSnake(pos, snakeHeadObject)) {
+                    regularWalls.emplace_back(i, j);
+                }
+            }
+        }
+    }
+}
+
+void Map::generateCrossMap(int rotation)
+{
+    int centerRow = mapSize.height / 2;
+    int centerCol = mapSize.width / 2;
+    int crossSize = min(mapSize.height, mapSize.width) / 3;
+    if (rotation % 2 == 0) {
+        // + 모양 (수직/수평)
+        for(int i = -crossSize; i <= crossSize; i++) {
+            Coord pos1{centerRow+i, centerCol};
+            Coord pos2{centerRow, centerCol+i};
+            if(isPositionValid(pos1) && !isNearSnake(pos1, snakeHeadObject)) regularWalls.emplace_back(pos1.row, pos1.col);
+            if(isPositionValid(pos2) && !isNearSnake(pos2, snakeHeadObject)) regularWalls.emplace_back(pos2.row, pos2.col);
+        }
+    } else {
+        // × 모양 (대각선)
+        for(int i = -crossSize; i <= crossSize; i++) {
+            Coord pos1{centerRow+i, centerCol+i};
+            Coord pos2{centerRow+i, centerCol-i};
+            if(isPositionValid(pos1) && !isNearSnake(pos1, snakeHeadObject)) regularWalls.emplace_back(pos1.row, pos1.col);
+            if(isPositionValid(pos2) && !isNearSnake(pos2, snakeHeadObject)) regularWalls.emplace_back(pos2.row, pos2.col);
+        }
+    }
+}
+
+bool Map::isNearSnake(const Coord& pos, const SnakeHead& snakeHead) const
+{
+    // 머리와 몸통 + 8방향 1칸 이내. 벽을 만드는 시점의 스네이크는 placeSnake가 놓은 세로 일직선이므로
+    // 머리 ~ 꼬리를 감싸는 직사각형을 사방으로 한 칸 넓힌 영역과 같다 (몸통 길이와 무관하게 O(1)).
+    const Coord& head = snakeHead.coord;
+    const Coord& tail = snakeHead.snakeBodySegments.empty() ? head : snakeHead.snakeBodySegments.back();
+    return pos.row >= min(head.row, tail.row) - 1 && pos.row <= max(head.row, tail.row) + 1 &&
+           pos.col >= min(head.col, tail.col) - 1 && pos.col <= max(head.col, tail.col) + 1;
+}
+
+int64_t Map::proceduralWallTarget(int mapHeight, int mapWidth, int wallDensity)
+{
+    const int64_t interiorCells = static_cast<int64_t>(max(0, mapHeight - 2)) * max(0, mapWidth - 2);
+    const int density = max(0, min(wallDensity, static_cast<int>(kMaxWallDensity)));
+    return min(interiorCells * density / 100, static_cast<int64_t>(kMaxProceduralWalls));
+}
+
+void Map::generateProceduralWalls(uint64_t layoutSeed, int wallDensity)
+{
+    // 칸마다 2비트(벽 / 도달)만 쓰는 격자로 작업하므로 큰 보드에서도 임시 메모리가 칸 수 / 4 바이트
+    const int h = mapSize.height;
+    const int w = mapSize.width;
+    const int64_t cols = w + 2;
+    const int64_t cellCount = static_cast<int64_t>(h + 2) * cols;
+    vector<uint64_t>& wallBits = proceduralScratch.wallBits;
+    vector<uint64_t>& reachedBits = proceduralScratch.reachedBits;
+    wallBits.assign(static_cast<size_t>((cellCount + 63) / 64), 0);
+    reachedBits.assign(wallBits.size(), 0);
+    auto test = [](const vector<uint64_t>& bits, int64_t i) { return (bits[static_cast<size_t>(i >> 6)] >> (i & 63)) & 1; };
+    auto set = [](vector<uint64_t>& bits, int64_t i) { bits[static_cast<size_t>(i >> 6)] |= uint64_t(1) << (i & 63); };
+    auto clear = [](vector<uint64_t>& bits, int64_t i) { bits[static_cast<size_t>(i >> 6)] &= ~(uint64_t(1) << (i & 63)); };
+    // 테두리 안쪽 칸 (행 2..h-1, 열 2..w-1)만 벽을 놓거나 탐색
+    auto isInterior = [&](int row, int col) { return row >= 2 && row <= h - 1 && col >= 2 && col <= w - 1; };
+
+    // 1. 목표 밀도까지 길이 3~8의 직선 벽 조각을 놓음 (벽 수와 시도 횟수에 상한을 두어 작업량 고정)
+    Rng rng(layoutSeed);
+    const int64_t interiorCells = static_cast<int64_t>(h - 2) * (w - 2);
+    const int64_t target = proceduralWallTarget(h, w, wallDensity);
+    const int64_t maxSegments = target / 2 + 64;
+    int64_t placed = 0;
+    for (int64_t segment = 0; segment < maxSegments && placed < target; ++segment) {
+        int row = rng.range(2, h - 1);
+        int col = rng.range(2, w - 1);
+        int length = rng.range(3, 8);
+        int direction = rng.range(1, 4);
+        for (int i = 0; i < length && placed < target; ++i) {
+            if (!isInterior(row, col)) break;
+            int64_t index = row * cols + col;
+            if (!test(wallBits, index) && !isNearSnake({row, col}, snakeHeadObject)) {
+                set(wallBits, index);
+                regularWalls.emplace_back(row, col);
+                placed++;
+            }
+            switch (direction) {
+                case 1: row--; break; // Up
+                case 2: col--; break; // Left
+                case 3: col++; break; // Right
+                case 4: row++; break; // Down
+            }
+        }
+    }
+
+    // 테두리 고리(행 1 / h, 열 1 / w)는 벽이면서 도달한 칸으로 표시해 탐색과 문 판정에서 빠지게 한다
+    for (int col = 1; col <= w; ++col) {
+        for (int64_t index : {cols + col, h * cols + col}) {
+            set(wallBits, index);
+            set(reachedBits, index);
+        }
+    }
+    for (int row = 1; row <= h; ++row) {
+        for (int64_t index : {row * cols + 1, row * cols + w}) {
+            set(wallBits, index);
+            set(reachedBits, index);
+        }
+    }
+
+    // 2. 머리에서 한 번 채우기. 가로 구간 단위로 64칸씩 비트 연산하므로 빈 영역은 칸 수 / 64에 비례
+    auto blocked = [&](size_t word) { return wallBits[word] | reachedBits[word]; };
+    auto nextBlocked = [&](int64_t p) {
+        size_t word = static_cast<size_t>(p >> 6);
+        uint64_t bits = blocked(word) & (~uint64_t(0) << (p & 63));
+        while (bits == 0) bits = blocked(++word);   // 테두리에서 반드시 멈춤
+        return static_cast<int64_t>(word << 6) + __builtin_ctzll(bits);
+    };
+    auto prevBlocked = [&](int64_t p) {
+        size_t word = static_cast<size_t>(p >> 6);
+        int bit = static_cast<int>(p & 63);
+        uint64_t bits = blocked(word) & (bit == 63 ? ~uint64_t(0) : (uint64_t(1) << (bit + 1)) - 1);
+        while (bits == 0) bits = blocked(--word);
+        return static_cast<int64_t>(word << 6) + 63 - __builtin_clzll(bits);
+    };
+    // [p, limit]에서 막히지 않은 첫 칸 (없으면 limit + 1)
+    auto nextOpen = [&](int64_t p, int64_t limit) {
+        if (p > limit) return limit + 1;
+        size_t word = static_cast<size_t>(p >> 6);
+        uint64_t bits = ~blocked(word) & (~uint64_t(0) << (p & 63));
+        while (bits == 0) {
+            if (static_cast<int64_t>(++word << 6) > limit) return limit + 1;
+            bits = ~blocked(word);
+        }
+        int64_t found = static_cast<int64_t>(word << 6) + __builtin_ctzll(bits);
+        return found <= limit ? found : limit + 1;
+    };
+    auto markSpan = [&](int64_t left, int64_t right) {
+        for (int64_t word = left >> 6; word <= right >> 6; ++word) {
+            int low = word == (left >> 6) ? static_cast<int>(left & 63) : 0;
+            int high = word == (right >> 6) ? static_cast<int>(right & 63) : 63;
+            uint64_t mask = (high == 63 ? ~uint64_t(0) : (uint64_t(1) << (high + 1)) - 1) & (~uint64_t(0) << low);
+            reachedBits[static_cast<size_t>(word)] |= mask;
+        }
+    };
+
+    int64_t reachedCount = 0;
+    vector<int64_t>& seeds = proceduralScratch.seeds;
+    seeds.assign(1, snakeHeadObject.coord.row * cols + snakeHeadObject.coord.col);
+    while (!seeds.empty()) {
+        int64_t p = seeds.back();
+        seeds.pop_back();
+        if (test(wallBits, p) || test(reachedBits, p)) continue;
+        int64_t left = prevBlocked(p) + 1;
+        int64_t right = nextBlocked(p) - 1;
+        markSpan(left, right);
+        reachedCount += right - left + 1;
+        for (int64_t offset : {-cols, cols}) {
+            int64_t limit = right + offset;
+            for (int64_t q = nextOpen(left + offset, limit); q <= limit; q = nextOpen(nextBlocked(q), limit)) {
+                seeds.push_back(q);
+            }
+        }
+    }
+
+    // 3. 닿은 칸과 닿지 않은 빈 칸 사이의 벽(문)을 하나 열고 그 너머를 칸 단위로 탐색하며 새 문 후보를 모은다.
+    //    각 칸은 한 번만 방문하고 각 벽은 이웃 수만큼만 문 후보가 되므로 벽 수 + 막힌 칸 수에 비례.
+    const int64_t offsets[4] = {-cols, cols, -1, 1};
+    auto isReachedOpen = [&](int64_t i) { return test(reachedBits, i) && !test(wallBits, i); };
+    vector<int64_t>& doors = proceduralScratch.doors;
+    doors.clear();
+    for (const Wall& wall : regularWalls) {
+        if (!isInterior(wall.coord.row, wall.coord.col)) continue;
+        int64_t index = wall.coord.row * cols + wall.coord.col;
+        for (int64_t offset : offsets) {
+            if (isReachedOpen(index + offset)) {
+                doors.push_back(index);
+                break;
+            }
+        }
+    }
+    // 칸 단위 탐색 대기열 (앞에서부터 읽고, 문 하나의 탐색이 끝나면 비움)
+    vector<int64_t>& frontier = proceduralScratch.frontier;
+    while (!doors.empty()) {
+        int64_t door = doors.back();
+        doors.pop_back();
+        if (!test(wallBits, door)) continue;
+        bool leadsOutside = false;
+        for (int64_t offset : offsets) {
+            int64_t beyond = door + offset;
+            if (!test(wallBits, beyond) && !test(reachedBits, beyond)) leadsOutside = true;
+        }
+        if (!leadsOutside) continue;
+        clear(wallBits, door);
+        set(reachedBits, door);
+        placed--;
+        reachedCount++;
+        frontier.assign(1, door);
+        for (size_t head = 0; head < frontier.size(); ++head) {
+            int64_t index = frontier[head];
+            for (int64_t offset : offsets) {
+                int64_t next = index + offset;
+                if (test(reachedBits, next)) continue;
+                if (test(wallBits, next)) {
+                    doors.push_back(next);
+                } else {
+                    set(reachedBits, next);
+                    frontier.push_back(next);
+                    reachedCount++;
+                }
+            }
+        }
+    }
+
+    // 4. 연 문은 벽 목록에서 빼고 (순서 유지), 문 하나로 닿지 않는 두꺼운 벽 안쪽 칸은 벽으로 채움
+    regularWalls.erase(remove_if(regularWalls.begin(), regularWalls.end(),
+        [&](const Wall& wall) {
+            return isInterior(wall.coord.row, wall.coord.col) &&
+                   !test(wallBits, wall.coord.row * cols + wall.coord.col);
+        }), regularWalls.end());
+    if (reachedCount < interiorCells - placed) {
+        for (int row = 2; row <= h - 1; ++row) {
+            for (int col = 2; col <= w - 1; ++col) {
+                int64_t index = row * cols + col;
+                if (!test(wallBits, index) && !test(reachedBits, index)) regularWalls.emplace_back(row, col);
+            }
+        }
+    }
+    if (wallBits.size() > kMaxRetainedScratchWords) proceduralScratch = ProceduralScratch();
+}
+
+bool Map::isPositionValid(const Coord& pos) const
+{
+    return pos.row >= 1 && pos.row < mapSize.height && 
+           pos.col >= 1 && pos.col < mapSize.width;
+}
+
+bool Map::isPositionOccupied(const Coord& pos) const
+{
+    if (snakeHeadObject.coord == pos) return true;
+    if (bodyCountAt(pos) > 0) return true;
+    return cellAt(pos) == CellType::WALL;
+}
+
+void Map::print_map() const
+{
+    // 맵의 현재 상태를 출력
+    for (int i = 0; i < mapSize.height + 2; i++) {
+        for (int j = 0; j < mapSize.width + 2; j++) {
+            Coord pos{i, j};
+            bool printed = false;
+
+            // 테두리 출력
+            if (i == 0 || i == mapSize.height + 1 || j == 0 || j == mapSize.width + 1) {
+                cout << "#";
+                printed = true;
+                continue;
+            }
+
+            // 스네이크 헤드 출력
+            if (snakeHeadObject.coord == pos) {
+                cout << "H";
+                printed = true;
+                continue;
+            }
+
+            // 스네이크 바디 출력
+            if (bodyCountAt(pos) > 0) {
+                cout << "B";
+                continue;
+            }
+
+            // 게이트 출력
+            for (const auto& gate : gameGates) {
+                if (gate.coord == pos && gate.isActive) {
+                    cout << "G";
+                    printed = true;
+                    break;
+                }
+            }
+            if (printed) continue;
+
+            // 아이템 출력
+            if (growthItemObject.coord == pos) {
+                cout << "+";
+                printed = true;
+            } else if (poisonItemObject.coord == pos) {
+                cout << "-";
+                printed = true;
+            } else if (timeItemObject.coord == pos) {
+                cout << "T";
+                printed = true;
+            }
+            if (printed) continue;
+
+            // 벽 / 무적 벽 출력
+            CellType cell = cellAt(pos);
+            if (cell == CellType::WALL) {
+                cout << "W";
+                continue;
+            }
+            if (cell == CellType::IMMUNE_WALL) {
+                cout << "I";
+                continue;
+            }
+
+            // 빈 공간 출력
+            cout << " ";
+        }
+        cout << endl;
+    }
+}
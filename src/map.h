@@ -5,14 +5,38 @@
 #include <vector>
 #include <algorithm>
 #include "block.h" // Assuming block.h is already modified
+#include "rng.h"
+#include "chunked_grid.h"
+#include <cstdint>
 
 using namespace std;
 
+namespace StageLayouts {
+struct Layout;
+}
+struct StageView;
+
 enum class MapType {
     BASIC,      // 기본 맵
     MAZE,       // 미로형 맵
     ISLANDS,    // 섬형 맵
-    CROSS       // 십자형 맵
+    CROSS,      // 십자형 맵
+    CUSTOM,     // 스테이지 팩에서 읽은 맵 (stage_pack.h)
+    PROCEDURAL  // 시드로 무작위 생성한 맵 (빈 칸이 모두 이어지도록 보정)
+};
+
+// 셀의 벽 층 종류 (타일 하위 2비트, 스네이크 몸통 수는 같은 타일의 상위 비트)
+enum class CellType : unsigned char {
+    EMPTY = 0,
+    WALL = 1,
+    IMMUNE_WALL = 2
+};
+
+// 게이트 후보 벽의 엄격도 (앞 단계 후보가 2개 미만일 때 다음 단계 사용)
+enum class GateTier : unsigned char {
+    STRICT = 0,     // 가장자리에서 떨어져 있고 내부 방향 3곳 이상이 열린 벽
+    RELAXED = 1,    // 안쪽 벽 중 한 방향이라도 열린 벽
+    BORDER = 2      // 모서리에서 떨어진 테두리 벽
 };
 
 struct MapDimensions
@@ -35,336 +59,166 @@ public:
     TimeItem timeItemObject;
     MapType currentMapType;
 
-    Map(int mapHeight = 21, int mapWidth = 21, int initialWallCount = 0, MapType type = MapType::BASIC, int stage = 1);
+    // 절차적 맵 내부 벽 밀도 (내부 칸 대비 %)
+    static const int kDefaultWallDensity = 15;
+    static const int kMaxWallDensity = 40;
+    // 절차적 맵 내부 벽 수 상한: 생성 시간과 벽 목록 메모리를 보드 크기와 무관하게 묶어 둔다.
+    // 목표 벽 수가 이를 넘는 큰 보드는 상한만큼만 놓으므로 실제 밀도가 요청보다 낮다.
+    static const int64_t kMaxProceduralWalls = int64_t(1) << 18;
+    // 내부 칸 수 x 밀도(%) / 100을 상한으로 자른 목표 벽 수
+    static int64_t proceduralWallTarget(int mapHeight, int mapWidth, int wallDensity);
+
+    // PROCEDURAL이면 layoutSeed / wallDensity로 벽을 만들고, 그 밖의 종류는 두 값을 무시
+    Map(int mapHeight = 21, int mapWidth = 21, int initialWallCount = 0, MapType type = MapType::BASIC, int stage = 1,
+        uint64_t layoutSeed = 0, int wallDensity = kDefaultWallDensity);
+    // 생성자와 같은 맵으로 제자리에서 다시 만듦. 벽 목록 / 격자 / 몸통 버퍼의 저장 공간을 그대로 다시 쓰므로
+    // 같은 크기의 스테이지를 반복해서 시작하면 (처음 몇 번 이후) 힙 할당이 없다.
+    void reset(int mapHeight, int mapWidth, MapType type, int stage,
+               uint64_t layoutSeed = 0, int wallDensity = kDefaultWallDensity);
+    // 스테이지 팩의 맵: 매핑된 셀 격자를 그대로 정적 층으로 사용 (팩이 맵보다 오래 살아 있어야 함)
+    explicit Map(const StageView& stage);
     Map(const Map &m) = default;
     Map& operator=(const Map &m) = default;
+    Map(Map &&m) = default;
+    Map& operator=(Map &&m) = default;
     ~Map() = default;
 
     void print_map() const;
     bool isPositionValid(const Coord& pos) const;
     bool isPositionOccupied(const Coord& pos) const;
 
+    // O(1) 셀 조회 (격자 밖은 무적벽으로 취급)
+    CellType cellAt(const Coord& pos) const;
+    bool isWall(const Coord& pos) const { return cellAt(pos) != CellType::EMPTY; }
+    int bodyCountAt(const Coord& pos) const;
+    bool isBodyOnWall() const { return bodyOnWallCount > 0; }
+    bool isBodyOnImmuneWall() const { return bodyOnImmuneWallCount > 0; }
+
+    // 스네이크 변경은 점유 격자와 함께 갱신되도록 반드시 아래 함수를 통해서만 수행
+    void advanceSnake();
+    void teleportSnakeHead(const Coord& pos);
+    void appendSnakeBody(const Coord& pos);
+    bool removeSnakeTail();
+    void resizeSnakeBody(size_t length);
+    // 저장된 상태 복원용: 몸통 전체와 머리를 한 번에 교체
+    void restoreSnake(const Coord& head, int direction, const vector<Coord>& body);
+
+    // 몸통 변경 기록 (되감기용): beginBodyJournal 이후의 앞쪽 추가 / 뒤쪽 추가 / 뒤쪽 제거를 그 자리에서 상쇄해
+    // 시작 시점 몸통과의 차이만 남긴다. 한 번 시작하면 이 맵의 몸통 변경마다 O(1)로 갱신되고,
+    // 몸통이 통째로 바뀌면 (restoreSnake / 스테이지 초기화) valid가 false가 된다.
+    struct BodyJournal {
+        bool valid = false;
+        size_t frontAdded = 0;        // 앞쪽에 새로 붙은 수
+        size_t backAdded = 0;         // 뒤쪽에 새로 붙어 남아 있는 수
+        size_t baseRemaining = 0;     // 시작 시점 몸통 중 남아 있는 수
+        vector<Coord> backRemoved;    // 시작 시점 몸통에서 뒤쪽으로 제거된 좌표 (제거 순서 = 꼬리부터)
+    };
+    void beginBodyJournal();
+    const BodyJournal& getBodyJournal() const { return bodyJournal; }
+    // 아레나처럼 Map 밖에서 관리하는 스네이크의 몸통 칸을 점유 격자 / 빈 셀 집합에 반영
+    // (자기 스네이크는 restoreSnake(parkedCoord(), -1, {})로 비워 두고 사용)
+    void occupyCell(const Coord& pos) { markBodyCell(pos, +1); }
+    void vacateCell(const Coord& pos) { markBodyCell(pos, -1); }
+
+    // exitGate로 나올 때의 위치와 방향 (inDirection = 진입 방향). 출구가 막혀 게이트 위에 남으면 false
+    bool findGateExit(const Gate& exitGate, int inDirection, Coord& exitPosition, int& exitDirection) const;
+
+    // 아이템을 놓을 수 있는 빈 셀 집합 (벽 / 몸통이 없고 상하좌우가 모두 벽은 아닌 내부 셀)
+    // 몸통 변경 시 O(log 행 수)로 갱신되며, 머리 / 아이템처럼 자주 바뀌는 좌표는 excluded로 넘겨 제외한다.
+    size_t freeCellCount() const { return freeCellTotal; }
+    bool isSpawnEligible(const Coord& pos) const;
+    bool isFreeCell(const Coord& pos) const;
+    // 균등하게 하나를 골라 out에 기록 (남은 셀이 없으면 false)
+    // 제외 좌표는 최대 kMaxPickExcluded개 (머리 + 아이템 3종, 넘는 것은 무시)
+    static const size_t kMaxPickExcluded = 4;
+    bool pickFreeCell(Rng& rng, Coord& out, const Coord* excluded, size_t excludedCount) const;
+
+    // 놓을 곳이 없는 아이템이 머무는 보드 밖 좌표
+    static Coord parkedCoord() { return {0, 0}; }
+    static bool isPlaced(const Coord& pos) { return pos.row > 0 && pos.col > 0; }
+
+    // 게이트 후보 벽 목록 (regularWalls 인덱스, 벽 배치가 확정될 때 한 번 계산)
+    const vector<int>& gateCandidates(GateTier tier) const { return gateCandidateLists[static_cast<int>(tier)]; }
+    // 조건을 만족하는 가장 엄격한 단계에서 서로 다른 두 벽을 균등하게 선택 (벽이 2개 미만이면 false)
+    bool pickGateWalls(Rng& rng, int& wallIndex1, int& wallIndex2) const;
+
+    // 벽 배치 해시 (크기 + 벽 / 면역 벽 좌표, 벽 배치가 정해질 때 한 번 계산). 배치가 같으면 같은 값
+    uint64_t getLayoutHash() const { return layoutHash; }
+
+    // 타일 격자가 실제로 차지하는 바이트 (쓰인 조각 + 겹친 몸통 보조 표)
+    size_t gridMemoryBytes() const { return tiles.allocatedBytes() + bodyOverflow.size() * sizeof(BodyOverflow); }
+
 private:
+    // 셀 단위 타일 격자: (height + 2) x (width + 2), 칸당 1바이트.
+    // 하위 2비트 = 벽 층(CellType), 상위 6비트 = 그 칸에 놓인 몸통 조각 수. 벽 충돌과 몸통 충돌을 한 번의 읽기로 판정하며,
+    // 큰 보드에서도 쓰인 조각만 할당되도록 조각 단위로 저장한다.
+    // 몸통이 한 칸에 63개 이상 겹치면 (사실상 없음) 타일에는 63을 두고 넘친 수를 bodyOverflow에 기록한다.
+    struct BodyOverflow {
+        int64_t cell;   // cellIndex
+        int extra;      // 63을 넘는 몸통 수
+    };
+    int gridRows = 0;
+    int gridCols = 0;
+    ChunkedGrid<unsigned char> tiles;
+    vector<BodyOverflow> bodyOverflow;
+    int bodyOnWallCount = 0;
+    int bodyOnImmuneWallCount = 0;
+    // 스테이지 팩 맵이면 매핑된 셀 격자 (타일의 벽 층 대신 사용, 몸통 수는 타일에 기록), 아니면 nullptr
+    const unsigned char* staticCells = nullptr;
+    vector<int> gateHints;               // 스테이지 파일이 지정한 게이트 우선 후보 (regularWalls 인덱스)
+    bool journaling = false;             // beginBodyJournal 이후 몸통 변경을 bodyJournal에 기록
+    BodyJournal bodyJournal;
+    void journalBackRemoval(const Coord& pos);
+
+    // 빈 셀 = 스폰 가능 셀 중 몸통이 없는 셀. 추출은 스폰 가능 셀을 칸 번호 오름차순으로 센 순번으로 하므로
+    // 결과가 몸통 변경 이력과 무관하다 (저장 / 복원한 상태에서도 같은 좌표가 나옴).
+    // 셀 목록 대신 (행, 64열 구간)별 개수만 두어 k번째 칸을 행 → 구간 → 칸 순으로 찾는다.
+    static const int kSpanShift = 6;
+    int spanCols = 0;                    // 행당 64열 구간 수
+    vector<unsigned char> eligibleInSpan; // 행 x 구간별 스폰 가능 셀 수 (벽 배치로 고정)
+    vector<int64_t> eligibleBeforeRow;   // 행 이전까지의 스폰 가능 셀 누적 수 (gridRows + 1개)
+    vector<unsigned char> freeInSpan;    // 행 x 구간별 빈 셀 수
+    vector<int64_t> freeRowTree;         // 행별 빈 셀 수의 펜윅 트리 (1부터)
+    size_t freeCellTotal = 0;            // 현재 비어 있는 스폰 가능 셀 수
+    vector<int64_t> excludedScratch;     // buildFreeCells 작업 버퍼 (끝나면 비워 두어 복사되지 않음)
+
+    // 게이트 후보: 벽별 열린 이웃 수와 단계별 후보 목록
+    struct WallOpenings {
+        unsigned char inner = 0; // 테두리 안쪽의 빈 이웃 수 (STRICT 기준)
+        unsigned char any = 0;   // 벽이 아닌 이웃 수 (RELAXED 기준)
+    };
+    vector<WallOpenings> wallOpenings;   // regularWalls와 같은 순서
+    vector<int> gateCandidateLists[3];
+    uint64_t layoutHash = 0;
+
+    bool isInGrid(const Coord& pos) const;
+    int64_t cellIndex(const Coord& pos) const { return static_cast<int64_t>(pos.row) * gridCols + pos.col; }
+    void buildCellGrid();
+    void markBodyCell(const Coord& pos, int delta);
+    bool hasBody(const Coord& pos) const;
+    void setBodyCount(const Coord& pos, unsigned char tile, int count);
+    void buildFreeCells();
+    void addFreeCell(const Coord& pos, int delta);
+    // 칸 번호 오름차순으로 k번째 (0부터) 스폰 가능 셀 / 빈 셀
+    Coord selectEligibleCell(int64_t k) const;
+    Coord selectFreeCell(int64_t k) const;
+    void buildGateCandidates();
+    void buildLayoutHash();
+
+    // 기본 크기 내장 스테이지: 컴파일 시간 벽 표로 만든 원본 (표마다 한 번만 생성)
+    explicit Map(const StageLayouts::Layout& layout);
+    static const Map& stagePrototype(const StageLayouts::Layout& layout);
+    void placeSnake(int row, int col);
+    // 그 밖의 크기: 테두리 + 맵 종류별 패턴을 실행 시간에 생성하고 스네이크 주변을 비움
+    void generateWalls(MapType type, int stage, uint64_t layoutSeed, int wallDensity);
     void initializeWalls();
-    void generateRandomWalls(int count);
+    // 절차적 맵: 무작위 벽 조각을 놓은 뒤 빈 칸이 하나로 이어지도록 벽을 열거나 막힌 칸을 채움
+    void generateProceduralWalls(uint64_t layoutSeed, int wallDensity);
     void generateMazeMap();
     void generateIslandsMap();
     void generateCrossMap(int rotation);
     void generateMapByType(MapType type);
-    bool isNearSnake(const Coord& pos, const SnakeHead& snakeHead);
+    bool isNearSnake(const Coord& pos, const SnakeHead& snakeHead) const;
 };
 
-// void : 0, wall : 1, immune wall : -1, gate: 2, snake head: 3, snake body: 4
-
-Map::Map(int mapHeight, int mapWidth, int /*initialWallCount*/, MapType type, int stage)
-    : mapSize(mapHeight, mapWidth)
-    , gameGates(2)
-    , currentMapType(type)
-{
-    initializeWalls();
-    snakeHeadObject = SnakeHead(mapHeight / 2, mapWidth / 2);
-    for(int i = 1; i <= 3; ++i) {
-        snakeHeadObject.snakeBodySegments.emplace_back(mapHeight / 2 + i, mapWidth / 2);
-    }
-    if (type == MapType::BASIC) {
-        // 내부 벽 없음 (테두리만)
-    } else if (type == MapType::MAZE) {
-        generateMazeMap();
-    } else if (type == MapType::ISLANDS) {
-        generateIslandsMap();
-    } else if (type == MapType::CROSS) {
-        int rotation = (stage - 1) % 4;
-        generateCrossMap(rotation);
-    }
-    std::vector<Coord> snakeCoords;
-    for (int dr = -1; dr <= 1; ++dr) {
-        for (int dc = -1; dc <= 1; ++dc) {
-            snakeCoords.push_back({snakeHeadObject.coord.row + dr, snakeHeadObject.coord.col + dc});
-        }
-    }
-    for (const auto& body : snakeHeadObject.snakeBodySegments) {
-        for (int dr = -1; dr <= 1; ++dr) {
-            for (int dc = -1; dc <= 1; ++dc) {
-                snakeCoords.push_back({body.coord.row + dr, body.coord.col + dc});
-            }
-        }
-    }
-    regularWalls.erase(std::remove_if(regularWalls.begin(), regularWalls.end(),
-        [&](const Wall& w) {
-            for(const auto& sc : snakeCoords) if (w.coord == sc) return true;
-            return false;
-        }), regularWalls.end());
-}
-
-void Map::initializeWalls()
-{
-    // Create border walls
-    for (int i = 1; i <= mapSize.height; ++i) {
-        for (int j = 1; j <= mapSize.width; ++j) {
-            if (i == 1 || i == mapSize.height) {
-                if (j == 1 || j == mapSize.width) {
-                    immuneWalls.emplace_back(i, j);
-                } else {
-                    regularWalls.emplace_back(i, j, (i == 1 ? 1 : 4));
-                }
-            } else if (j == 1 || j == mapSize.width) {
-                regularWalls.emplace_back(i, j, (j == 1 ? 2 : 3));
-            }
-        }
-    }
-}
-
-void Map::generateMapByType(MapType type)
-{
-    switch(type) {
-        case MapType::BASIC:
-            break;
-        case MapType::MAZE:
-            generateMazeMap();
-            break;
-        case MapType::ISLANDS:
-            generateIslandsMap();
-            break;
-        case MapType::CROSS:
-            generateCrossMap(0);
-            break;
-    }
-}
-
-void Map::generateMazeMap()
-{
-    // ㄱ, ㄴ, └, ┐ 패턴의 벽을 가장자리에서 내부로 일부만 배치
-    int h = mapSize.height;
-    int w = mapSize.width;
-
-    // 좌상단 ㄱ자
-    for (int j = 2; j <= 6; ++j)
-        if (isPositionValid({2, j}) && !isNearSnake({2, j}, snakeHeadObject))
-            regularWalls.emplace_back(2, j);
-    for (int i = 2; i <= 5; ++i)
-        if (isPositionValid({i, 6}) && !isNearSnake({i, 6}, snakeHeadObject))
-            regularWalls.emplace_back(i, 6);
-
-    // 우상단 ㄴ자
-    for (int j = w-1; j >= w-5; --j)
-        if (isPositionValid({2, j}) && !isNearSnake({2, j}, snakeHeadObject))
-            regularWalls.emplace_back(2, j);
-    for (int i = 2; i <= 5; ++i)
-        if (isPositionValid({i, w-5}) && !isNearSnake({i, w-5}, snakeHeadObject))
-            regularWalls.emplace_back(i, w-5);
-
-    // 좌하단 └자
-    for (int i = h-1; i >= h-4; --i)
-        if (isPositionValid({i, 2}) && !isNearSnake({i, 2}, snakeHeadObject))
-            regularWalls.emplace_back(i, 2);
-    for (int j = 2; j <= 5; ++j)
-        if (isPositionValid({h-4, j}) && !isNearSnake({h-4, j}, snakeHeadObject))
-            regularWalls.emplace_back(h-4, j);
-
-    // 우하단 ┐자
-    for (int i = h-1; i >= h-4; --i)
-        if (isPositionValid({i, w-1}) && !isNearSnake({i, w-1}, snakeHeadObject))
-            regularWalls.emplace_back(i, w-1);
-    for (int j = w-1; j >= w-4; --j)
-        if (isPositionValid({h-4, j}) && !isNearSnake({h-4, j}, snakeHeadObject))
-            regularWalls.emplace_back(h-4, j);
-
-    // 중앙에 짧은 벽 추가(내부 공간 충분히 확보)
-    for (int j = w/2-2; j <= w/2+2; ++j)
-        if (isPositionValid({h/2, j}) && !isNearSnake({h/2, j}, snakeHeadObject))
-            regularWalls.emplace_back(h/2, j);
-}
-
-void Map::generateIslandsMap()
-{
-    // 중앙에 섬의 테두리만 벽으로 생성
-    int centerRow = mapSize.height / 2;
-    int centerCol = mapSize.width / 2;
-    int islandHalf = min(mapSize.height, mapSize.width) / 6; // 섬 크기 조절
-    int top = centerRow - islandHalf;
-    int bottom = centerRow + islandHalf;
-    int left = centerCol - islandHalf;
-    int right = centerCol + islandHalf;
-    for (int i = top; i <= bottom; ++i) {
-        for (int j = left; j <= right; ++j) {
-            if (i == top || i == bottom || j == left || j == right) {
-                Coord pos{i, j};
-                if (isPositionValid(pos) && !isNearSnake(pos, snakeHeadObject)) {
-                    regularWalls.emplace_back(i, j);
-                }
-            }
-        }
-    }
-}
-
-void Map::generateCrossMap(int rotation)
-{
-    int centerRow = mapSize.height / 2;
-    int centerCol = mapSize.width / 2;
-    int crossSize = min(mapSize.height, mapSize.width) / 3;
-    if (rotation % 2 == 0) {
-        // + 모양 (수직/수평)
-        for(int i = -crossSize; i <= crossSize; i++) {
-            Coord pos1{centerRow+i, centerCol};
-            Coord pos2{centerRow, centerCol+i};
-            if(isPositionValid(pos1) && !isNearSnake(pos1, snakeHeadObject)) regularWalls.emplace_back(pos1.row, pos1.col);
-            if(isPositionValid(pos2) && !isNearSnake(pos2, snakeHeadObject)) regularWalls.emplace_back(pos2.row, pos2.col);
-        }
-    } else {
-        // × 모양 (대각선)
-        for(int i = -crossSize; i <= crossSize; i++) {
-            Coord pos1{centerRow+i, centerCol+i};
-            Coord pos2{centerRow+i, centerCol-i};
-            if(isPositionValid(pos1) && !isNearSnake(pos1, snakeHeadObject)) regularWalls.emplace_back(pos1.row, pos1.col);
-            if(isPositionValid(pos2) && !isNearSnake(pos2, snakeHeadObject)) regularWalls.emplace_back(pos2.row, pos2.col);
-        }
-    }
-}
-
-bool Map::isNearSnake(const Coord& pos, const SnakeHead& snakeHead) {
-    // 머리와 몸통 + 8방향 1칸 이내
-    for (int dr = -1; dr <= 1; ++dr) {
-        for (int dc = -1; dc <= 1; ++dc) {
-            Coord check = {snakeHead.coord.row + dr, snakeHead.coord.col + dc};
-            if (pos == check) return true;
-        }
-    }
-    for (const auto& body : snakeHead.snakeBodySegments) {
-        for (int dr = -1; dr <= 1; ++dr) {
-            for (int dc = -1; dc <= 1; ++dc) {
-                Coord check = {body.coord.row + dr, body.coord.col + dc};
-                if (pos == check) return true;
-            }
-        }
-    }
-    return false;
-}
-
-void Map::generateRandomWalls(int count)
-{
-    while (count--) {
-        int row = rand() % (mapSize.height - 2) + 2;
-        int col = rand() % (mapSize.width - 2) + 2;
-        int length = rand() % 6 + 4;
-        int direction = rand() % 4 + 1;
-
-        for (int i = 0; i < length; ++i) {
-            Coord pos{row, col};
-            if (isPositionValid(pos) && !isPositionOccupied(pos) && !isNearSnake(pos, snakeHeadObject)) {
-                regularWalls.emplace_back(row, col);
-            }
-
-            switch (direction) {
-                case 1: row--; break; // Up
-                case 2: col--; break; // Left
-                case 3: col++; break; // Right
-                case 4: row++; break; // Down
-            }
-        }
-    }
-}
-
-bool Map::isPositionValid(const Coord& pos) const
-{
-    return pos.row >= 1 && pos.row < mapSize.height && 
-           pos.col >= 1 && pos.col < mapSize.width;
-}
-
-bool Map::isPositionOccupied(const Coord& pos) const
-{
-    if (snakeHeadObject.coord == pos) return true;
-    
-    for (const auto& body : snakeHeadObject.snakeBodySegments) {
-        if (body.coord == pos) return true;
-    }
-    
-    for (const auto& wall : regularWalls) {
-        if (wall.coord == pos) return true;
-    }
-    
-    return false;
-}
-
-void Map::print_map() const
-{
-    // 맵의 현재 상태를 출력
-    for (int i = 0; i < mapSize.height + 2; i++) {
-        for (int j = 0; j < mapSize.width + 2; j++) {
-            Coord pos{i, j};
-            bool printed = false;
-
-            // 테두리 출력
-            if (i == 0 || i == mapSize.height + 1 || j == 0 || j == mapSize.width + 1) {
-                cout << "#";
-                printed = true;
-                continue;
-            }
-
-            // 스네이크 헤드 출력
-            if (snakeHeadObject.coord == pos) {
-                cout << "H";
-                printed = true;
-                continue;
-            }
-
-            // 스네이크 바디 출력
-            for (const auto& body : snakeHeadObject.snakeBodySegments) {
-                if (body.coord == pos) {
-                    cout << "B";
-                    printed = true;
-                    break;
-                }
-            }
-            if (printed) continue;
-
-            // 게이트 출력
-            for (const auto& gate : gameGates) {
-                if (gate.coord == pos && gate.isActive) {
-                    cout << "G";
-                    printed = true;
-                    break;
-                }
-            }
-            if (printed) continue;
-
-            // 아이템 출력
-            if (growthItemObject.coord == pos) {
-                cout << "+";
-                printed = true;
-            } else if (poisonItemObject.coord == pos) {
-                cout << "-";
-                printed = true;
-            } else if (timeItemObject.coord == pos) {
-                cout << "T";
-                printed = true;
-            }
-            if (printed) continue;
-
-            // 벽 출력
-            for (const auto& wall : regularWalls) {
-                if (wall.coord == pos) {
-                    cout << "W";
-                    printed = true;
-                    break;
-                }
-            }
-            if (printed) continue;
-
-            // 무적 벽 출력
-            for (const auto& wall : immuneWalls) {
-                if (wall.coord == pos) {
-                    cout << "I";
-                    printed = true;
-                    break;
-                }
-            }
-            if (printed) continue;
-
-            // 빈 공간 출력
-            cout << " ";
-        }
-        cout << endl;
-    }
-}
-
-#endif
\ No newline at end of file
+#endif
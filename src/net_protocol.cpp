@@ -0,0 +1,290 @@
+#include "net_protocol.h"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+
+const char kWelcomeMagic[4] = {'S', 'N', 'K', 'N'};
+const size_t kFrameHeaderSize = 5;
+const size_t kReadChunk = 64 * 1024;
+
+#ifdef MSG_NOSIGNAL
+const int kSendFlags = MSG_NOSIGNAL;
+#else
+const int kSendFlags = 0;
+#endif
+
+runtime_error socketError(const string& what, const NetAddress& address)
+{
+    return runtime_error(what + " " + address.toString() + ": " + strerror(errno));
+}
+
+void setNonBlocking(int fd)
+{
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        throw runtime_error(string("Cannot make socket non-blocking: ") + strerror(errno));
+    }
+}
+
+// 입력 / 틱 메시지는 작으므로 묶어 보내기(Nagle)를 끄고, 닫힌 상대에 쓸 때 SIGPIPE를 받지 않게 함
+void configureSocket(int fd, bool tcp)
+{
+    setNonBlocking(fd);
+    int one = 1;
+    if (tcp) setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+#ifdef SO_NOSIGPIPE
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+}
+
+sockaddr_un unixAddress(const NetAddress& address)
+{
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (address.path.empty() || address.path.size() >= sizeof(addr.sun_path)) {
+        throw invalid_argument("Unix socket path is empty or too long: " + address.path);
+    }
+    memcpy(addr.sun_path, address.path.c_str(), address.path.size());
+    return addr;
+}
+
+sockaddr_in tcpAddress(const NetAddress& address)
+{
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(address.port));
+    if (inet_pton(AF_INET, address.host.c_str(), &addr.sin_addr) != 1) {
+        throw invalid_argument("TCP host must be an IPv4 address: " + address.host);
+    }
+    return addr;
+}
+
+} // namespace
+
+// ---- 메시지 ------------------------------------------------------------------
+
+void NetProtocol::writeWelcome(ByteWriter& w, int snakeIndex, const ArenaOptions& options, uint32_t tickMicros)
+{
+    for (char c : kWelcomeMagic) w.u8(static_cast<uint8_t>(c));
+    w.u16(kVersion);
+    w.i32(snakeIndex);
+    w.i32(options.snakeCount);
+    w.i32(options.boardHeight);
+    w.i32(options.boardWidth);
+    w.i32(options.stage);
+    w.i32(options.wallDensity);
+    w.u64(options.seed);
+    w.i32(options.itemsPerKind);
+    w.i32(options.respawnDelay);
+    w.u32(tickMicros);
+}
+
+void NetProtocol::readWelcome(ByteReader& r, int& snakeIndex, ArenaOptions& options, uint32_t& tickMicros)
+{
+    for (char c : kWelcomeMagic) {
+        if (r.u8() != static_cast<uint8_t>(c)) throw runtime_error("Not a snake tick server");
+    }
+    uint16_t version = r.u16();
+    if (version != kVersion) {
+        throw runtime_error("Unsupported protocol version " + to_string(version));
+    }
+    snakeIndex = r.i32();
+    options.snakeCount = r.i32();
+    options.boardHeight = r.i32();
+    options.boardWidth = r.i32();
+    options.stage = r.i32();
+    options.wallDensity = r.i32();
+    options.seed = r.u64();
+    options.itemsPerKind = r.i32();
+    options.respawnDelay = r.i32();
+    tickMicros = r.u32();
+}
+
+// ---- 주소 / 소켓 ------------------------------------------------------------
+
+string NetAddress::toString() const
+{
+    return unixSocket ? "unix:" + path : "tcp:" + host + ":" + to_string(port);
+}
+
+NetAddress parseNetAddress(const string& text)
+{
+    NetAddress address;
+    if (text.compare(0, 5, "unix:") == 0) {
+        address.unixSocket = true;
+        address.path = text.substr(5);
+        if (address.path.empty()) throw invalid_argument("Unix socket path is empty");
+        return address;
+    }
+    if (text.compare(0, 4, "tcp:") == 0) {
+        address.unixSocket = false;
+        string rest = text.substr(4);
+        size_t colon = rest.rfind(':');
+        string portText = rest;
+        if (colon != string::npos) {
+            address.host = rest.substr(0, colon);
+            portText = rest.substr(colon + 1);
+        }
+        char* end = nullptr;
+        long port = strtol(portText.c_str(), &end, 10);
+        if (portText.empty() || *end != '\0' || port < 1 || port > 65535) {
+            throw invalid_argument("TCP port must be between 1 and 65535: " + portText);
+        }
+        address.port = static_cast<int>(port);
+        return address;
+    }
+    throw invalid_argument("Address must look like unix:PATH or tcp:[HOST:]PORT");
+}
+
+int openListener(const NetAddress& address)
+{
+    int fd = socket(address.unixSocket ? AF_UNIX : AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) throw socketError("Cannot create socket for", address);
+    int result;
+    if (address.unixSocket) {
+        sockaddr_un addr = unixAddress(address);
+        struct stat info;
+        if (stat(address.path.c_str(), &info) == 0 && S_ISSOCK(info.st_mode)) unlink(address.path.c_str());
+        result = ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    } else {
+        int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        sockaddr_in addr = tcpAddress(address);
+        result = ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    }
+    if (result < 0 || listen(fd, 16) < 0) {
+        runtime_error error = socketError("Cannot listen on", address);
+        close(fd);
+        throw error;
+    }
+    setNonBlocking(fd);
+    return fd;
+}
+
+int connectTo(const NetAddress& address)
+{
+    int fd = socket(address.unixSocket ? AF_UNIX : AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) throw socketError("Cannot create socket for", address);
+    int result;
+    if (address.unixSocket) {
+        sockaddr_un addr = unixAddress(address);
+        result = ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    } else {
+        sockaddr_in addr = tcpAddress(address);
+        result = ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    }
+    if (result < 0) {
+        runtime_error error = socketError("Cannot connect to", address);
+        close(fd);
+        throw error;
+    }
+    configureSocket(fd, !address.unixSocket);
+    return fd;
+}
+
+int acceptConnection(int listenFd)
+{
+    int fd = ::accept(listenFd, nullptr, nullptr);
+    if (fd < 0) return -1;
+    sockaddr_storage local;
+    socklen_t length = sizeof(local);
+    bool tcp = getsockname(fd, reinterpret_cast<sockaddr*>(&local), &length) == 0 && local.ss_family == AF_INET;
+    try {
+        configureSocket(fd, tcp);
+    } catch (const runtime_error&) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// ---- 연결 --------------------------------------------------------------------
+
+NetConnection::NetConnection(int fd) : socketFd(fd) {}
+
+NetConnection::~NetConnection()
+{
+    if (socketFd >= 0) close(socketFd);
+}
+
+bool NetConnection::receive()
+{
+    while (!broken) {
+        // 이미 처리한 앞부분은 버퍼가 절반 넘게 찼을 때만 당겨 옴
+        if (inputOffset > 0 && inputOffset * 2 >= input.size()) {
+            input.erase(input.begin(), input.begin() + static_cast<ptrdiff_t>(inputOffset));
+            inputOffset = 0;
+        }
+        size_t used = input.size();
+        input.resize(used + kReadChunk);
+        ssize_t received = ::recv(socketFd, input.data() + used, kReadChunk, 0);
+        input.resize(used + (received > 0 ? static_cast<size_t>(received) : 0));
+        if (received > 0) continue;
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;
+        if (received < 0 && errno == EINTR) continue;
+        broken = true; // 0 = 상대가 닫음
+    }
+    return false;
+}
+
+bool NetConnection::nextFrame(uint8_t& type, vector<uint8_t>& body)
+{
+    size_t available = input.size() - inputOffset;
+    if (available < kFrameHeaderSize) return false;
+    ByteReader header(input.data() + inputOffset, kFrameHeaderSize);
+    uint32_t length = header.u32();
+    if (length > NetProtocol::kMaxFrameBytes) {
+        broken = true;
+        return false;
+    }
+    if (available < kFrameHeaderSize + length) return false;
+    type = header.u8();
+    const uint8_t* start = input.data() + inputOffset + kFrameHeaderSize;
+    body.assign(start, start + length);
+    inputOffset += kFrameHeaderSize + length;
+    return true;
+}
+
+void NetConnection::send(uint8_t type, const vector<uint8_t>& body)
+{
+    if (broken) return;
+    ByteWriter w(output);
+    w.u32(static_cast<uint32_t>(body.size()));
+    w.u8(type);
+    output.insert(output.end(), body.begin(), body.end());
+    flush();
+}
+
+bool NetConnection::flush()
+{
+    while (!broken && outputOffset < output.size()) {
+        ssize_t sent = ::send(socketFd, output.data() + outputOffset, output.size() - outputOffset, kSendFlags);
+        if (sent > 0) {
+            outputOffset += static_cast<size_t>(sent);
+            continue;
+        }
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (sent < 0 && errno == EINTR) continue;
+        broken = true;
+    }
+    if (outputOffset == output.size()) {
+        output.clear();
+        outputOffset = 0;
+    }
+    return !broken;
+}
@@ -0,0 +1,89 @@
+#ifndef NET_PROTOCOL_H
+#define NET_PROTOCOL_H
+
+#include "arena.h"
+#include "byte_io.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// 틱 서버(tick_server.h)와 터미널 클라이언트(tools/snake_client.cpp) 사이의 메시지 형식과 소켓 도우미
+// 유닉스 도메인 소켓 또는 TCP 루프백 위의 바이트 스트림을 길이 접두 프레임으로 나눈다 (리틀 엔디언).
+//   프레임 : u32 본문 길이 | u8 종류 | 본문
+// 서버 → 클라이언트
+//   'W' 환영     : "SNKN" | u16 버전 | i32 조종할 스네이크 (-1 = 관전) | 아레나 옵션 | u32 틱 간격(µs)
+//   'K' 키프레임 : Arena::encodeKeyframe (접속 직후 / 재동기화 요청 시)
+//   'T' 틱       : u32 상태 요약값 | Arena::encodeTick (매 틱 모든 클라이언트에 같은 내용)
+//   'A' 입력 확인 : u32 입력 번호 | u64 목표 틱 | u64 적용한 틱 | u32 서버 대기 시간(µs)
+// 클라이언트 → 서버
+//   'I' 입력     : u32 입력 번호 | u64 목표 틱 (마지막으로 받은 틱 + 1) | u8 방향 (1~4)
+//   'R' 재동기화 : 본문 없음 (복제 상태가 어긋났을 때 키프레임 요청)
+namespace NetProtocol {
+const uint16_t kVersion = 1;
+const uint8_t kWelcome = 'W';
+const uint8_t kKeyframe = 'K';
+const uint8_t kTick = 'T';
+const uint8_t kInputAck = 'A';
+const uint8_t kInput = 'I';
+const uint8_t kResync = 'R';
+const uint32_t kMaxFrameBytes = 64u << 20;
+
+void writeWelcome(ByteWriter& w, int snakeIndex, const ArenaOptions& options, uint32_t tickMicros);
+// 매직 / 버전이 맞지 않으면 runtime_error
+void readWelcome(ByteReader& r, int& snakeIndex, ArenaOptions& options, uint32_t& tickMicros);
+}
+
+// 접속 주소: "unix:PATH", "tcp:HOST:PORT", "tcp:PORT"(127.0.0.1)
+struct NetAddress {
+    bool unixSocket = true;
+    string path;             // 유닉스 소켓 경로
+    string host = "127.0.0.1";
+    int port = 0;
+
+    string toString() const;
+};
+
+// 형식이 틀리면 invalid_argument
+NetAddress parseNetAddress(const string& text);
+// 논블로킹 수신 소켓 / 연결 (실패 시 runtime_error). 유닉스 소켓은 남아 있던 같은 경로를 지우고 만든다.
+int openListener(const NetAddress& address);
+int connectTo(const NetAddress& address);
+// 논블로킹 수신 소켓에서 대기 중인 연결 하나를 받음 (없으면 -1)
+int acceptConnection(int listenFd);
+
+// 한 연결의 송수신 버퍼 (논블로킹 소켓 기준, 소멸 시 소켓을 닫음)
+class NetConnection
+{
+public:
+    explicit NetConnection(int fd);
+    ~NetConnection();
+    NetConnection(const NetConnection&) = delete;
+    NetConnection& operator=(const NetConnection&) = delete;
+
+    int fd() const { return socketFd; }
+    // 지금 읽을 수 있는 만큼 읽음 (상대가 닫았거나 오류, 너무 큰 프레임이면 false)
+    bool receive();
+    // 완성된 프레임이 있으면 하나 꺼냄
+    bool nextFrame(uint8_t& type, vector<uint8_t>& body);
+    // 프레임을 보낼 버퍼에 넣고 보낼 수 있는 만큼 바로 보냄
+    void send(uint8_t type, const vector<uint8_t>& body);
+    // 남은 출력을 보낼 수 있는 만큼 보냄 (오류면 false)
+    bool flush();
+    size_t pendingOutputBytes() const { return output.size() - outputOffset; }
+    bool failed() const { return broken; }
+    // 더 주고받지 않음 (소켓은 소멸 시 닫힘)
+    void abandon() { broken = true; }
+
+private:
+    int socketFd;
+    bool broken = false;
+    vector<uint8_t> input;
+    size_t inputOffset = 0;
+    vector<uint8_t> output;
+    size_t outputOffset = 0;
+};
+
+#endif
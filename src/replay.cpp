@@ -0,0 +1,406 @@
+#include "replay.h"
+#include "byte_io.h"
+#include "stage_pack.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+
+const char kHeaderMagic[4] = {'S', 'N', 'K', 'R'};
+const char kTrailerMagic[4] = {'S', 'N', 'K', 'I'};
+const uint16_t kFormatVersion = 1;
+const size_t kHeaderSize = 16;
+const size_t kTrailerSize = 12;
+const uint8_t kChunkInput = 'I';
+const uint8_t kChunkKeyframe = 'K';
+const uint8_t kChunkStateJump = 'J';
+const uint8_t kChunkIndex = 'X';
+const uint8_t kIdleRunFlag = 0x80;
+const int kMaxIdleRun = 128;
+
+void writeState(ByteWriter& w, const SimulationState& s)
+{
+    w.u64(s.rngSeed);
+    w.u64(s.rngState);
+    w.u64(s.rngIncrement);
+    w.i32(s.mapHeight);
+    w.i32(s.mapWidth);
+    w.u8(static_cast<uint8_t>(s.mapType));
+    w.i32(s.stage);
+    // 절차적 맵의 생성 정보는 해당 맵일 때만 기록 (이전 파일과 같은 형식 유지)
+    if (s.mapType == MapType::PROCEDURAL) {
+        w.u64(s.layoutSeed);
+        w.i32(s.wallDensity);
+    }
+    w.coord(s.head);
+    w.i32(s.direction);
+    w.u32(static_cast<uint32_t>(s.body.size()));
+    for (const Coord& c : s.body) w.coord(c);
+    w.coord(s.growthItem);
+    w.coord(s.poisonItem);
+    w.coord(s.timeItem);
+    for (int i = 0; i < 2; ++i) {
+        w.coord(s.gates[i]);
+        w.i32(s.gateExit[i]);
+        w.u8(s.gateActive[i] ? 1 : 0);
+    }
+    w.i32(s.gateActiveDuration);
+    w.i32(s.growthItemCount);
+    w.i32(s.poisonItemCount);
+    w.i32(s.gatesUsedCount);
+    w.i32(s.maxSnakeLength);
+    w.i32(s.gameTimerSeconds);
+    w.f64(s.elapsedMilliseconds);
+    w.i32(s.gameSpeedDelay);
+    w.f32(s.speedMultiplier);
+    w.i32(s.speedBoostTimer);
+    w.i32(s.growthItemTimer);
+    w.i32(s.poisonItemTimer);
+    w.i32(s.timeItemTimer);
+    for (int i = 0; i < 4; ++i) w.u8(static_cast<uint8_t>(s.missionStatus[i]));
+    w.u8(s.allMissionsCompleted ? 1 : 0);
+    w.u8(s.boardFull ? 1 : 0);
+}
+
+// 테두리 벽을 포함한 맵 격자 (0..height + 1, 0..width + 1) 안의 좌표인지 (보드 밖에 놓인 아이템은 (0, 0))
+bool inMapGrid(const SimulationState& s, const Coord& c)
+{
+    return c.row >= 0 && c.row <= s.mapHeight + 1 && c.col >= 0 && c.col <= s.mapWidth + 1;
+}
+
+void readState(ByteReader& r, SimulationState& s)
+{
+    s.rngSeed = r.u64();
+    s.rngState = r.u64();
+    s.rngIncrement = r.u64();
+    s.mapHeight = r.i32();
+    s.mapWidth = r.i32();
+    s.mapType = static_cast<MapType>(r.u8());
+    // 스테이지 팩 맵은 팩이 허용하는 더 작은 크기도 가능
+    int minSize = s.mapType == MapType::CUSTOM ? kMinStageSize : Simulation::kMinBoardSize;
+    if (s.mapHeight < minSize || s.mapWidth < minSize ||
+        s.mapHeight > Simulation::kMaxBoardSize || s.mapWidth > Simulation::kMaxBoardSize) {
+        throw runtime_error("Replay keyframe has an invalid board size");
+    }
+    s.stage = r.i32();
+    if (s.mapType == MapType::PROCEDURAL) {
+        s.layoutSeed = r.u64();
+        s.wallDensity = r.i32();
+    }
+    s.head = r.coord();
+    s.direction = r.i32();
+    uint32_t bodySize = r.u32();
+    // 좌표당 8바이트: 잘린 청크가 남은 바이트보다 큰 버퍼를 먼저 잡지 않도록 함께 확인
+    if (bodySize > static_cast<uint64_t>(s.mapHeight) * static_cast<uint64_t>(s.mapWidth) ||
+        bodySize > r.remaining() / 8) {
+        throw runtime_error("Replay keyframe has an invalid body length");
+    }
+    s.body.resize(bodySize);
+    for (Coord& c : s.body) c = r.coord();
+    s.growthItem = r.coord();
+    s.poisonItem = r.coord();
+    s.timeItem = r.coord();
+    for (int i = 0; i < 2; ++i) {
+        s.gates[i] = r.coord();
+        s.gateExit[i] = r.i32();
+        s.gateActive[i] = r.u8() != 0;
+    }
+    bool inside = inMapGrid(s, s.head) && inMapGrid(s, s.growthItem) && inMapGrid(s, s.poisonItem) &&
+                  inMapGrid(s, s.timeItem) && inMapGrid(s, s.gates[0]) && inMapGrid(s, s.gates[1]);
+    for (const Coord& c : s.body) inside = inside && inMapGrid(s, c);
+    if (!inside) {
+        throw runtime_error("Replay keyframe has a position outside the board");
+    }
+    s.gateActiveDuration = r.i32();
+    s.growthItemCount = r.i32();
+    s.poisonItemCount = r.i32();
+    s.gatesUsedCount = r.i32();
+    s.maxSnakeLength = r.i32();
+    s.gameTimerSeconds = r.i32();
+    s.elapsedMilliseconds = r.f64();
+    s.gameSpeedDelay = r.i32();
+    s.speedMultiplier = r.f32();
+    s.speedBoostTimer = r.i32();
+    s.growthItemTimer = r.i32();
+    s.poisonItemTimer = r.i32();
+    s.timeItemTimer = r.i32();
+    for (int i = 0; i < 4; ++i) s.missionStatus[i] = static_cast<char>(r.u8());
+    s.allMissionsCompleted = r.u8() != 0;
+    s.boardFull = r.u8() != 0;
+}
+
+} // namespace
+
+void applyReplayInput(Simulation& sim, uint8_t input)
+{
+    if (input >= 1 && input <= 4) {
+        sim.applyDirection(input);
+    } else if (input == kReplayCompleteMissions) {
+        sim.completeMissionsForDebug();
+    } else if ((input & 0xF0) == kReplayJumpStage) {
+        int stage = input & 0x07;
+        if (stage >= 1 && stage <= sim.getStageCount()) sim.jumpToStage(stage);
+    }
+}
+
+StepStatus applyReplayTick(Simulation& sim, uint8_t input)
+{
+    applyReplayInput(sim, input);
+    return sim.tick();
+}
+
+void finishReplayTick(Simulation& sim, StepStatus status)
+{
+    // Game의 결과 화면에서 'R'을 눌렀을 때와 같은 처리
+    if (status == StepStatus::STAGE_CLEAR) {
+        sim.goToNextStage();
+    } else if (status == StepStatus::GAME_OVER) {
+        sim.resetCurrentStage();
+    }
+}
+
+ReplayWriter::ReplayWriter(const string& path, const Simulation& sim, int keyframeInterval)
+    : out(path, ios::binary | ios::trunc)
+    , keyframeInterval(keyframeInterval > 0 ? keyframeInterval : 256)
+{
+    if (!out) {
+        throw runtime_error("Cannot open replay file for writing: " + path);
+    }
+    vector<uint8_t> header;
+    ByteWriter w(header);
+    for (char c : kHeaderMagic) w.u8(static_cast<uint8_t>(c));
+    w.u16(kFormatVersion);
+    w.u16(static_cast<uint16_t>(this->keyframeInterval));
+    w.u64(sim.getSeed());
+    out.write(reinterpret_cast<const char*>(header.data()), static_cast<streamsize>(header.size()));
+    writeKeyframe(sim);
+}
+
+ReplayWriter::~ReplayWriter()
+{
+    try {
+        finish();
+    } catch (...) {
+        // 소멸자에서는 예외를 밖으로 던지지 않음
+    }
+}
+
+void ReplayWriter::recordTick(uint8_t input)
+{
+    if (finished) return;
+    if (input == kReplayNoInput) {
+        if (++idleRun == kMaxIdleRun) flushIdleRun();
+    } else {
+        flushIdleRun();
+        inputBuffer.push_back(input);
+    }
+    tickCount++;
+}
+
+void ReplayWriter::recordStateJump(const Simulation& sim)
+{
+    if (finished) return;
+    writeStateChunk(kChunkStateJump, sim);
+}
+
+void ReplayWriter::checkpoint(const Simulation& sim)
+{
+    if (finished) return;
+    if (tickCount % keyframeInterval == 0 && tickCount != lastKeyframeTick) {
+        writeKeyframe(sim);
+    }
+}
+
+void ReplayWriter::finish()
+{
+    if (finished) return;
+    finished = true;
+    flushInputs();
+
+    uint64_t indexOffset = static_cast<uint64_t>(out.tellp());
+    vector<uint8_t> payload;
+    ByteWriter w(payload);
+    w.u32(static_cast<uint32_t>(tickCount));
+    w.u32(static_cast<uint32_t>(keyframeIndex.size()));
+    for (const auto& entry : keyframeIndex) {
+        w.u32(entry.first);
+        w.u64(entry.second);
+    }
+    writeChunk(kChunkIndex, payload);
+
+    vector<uint8_t> trailer;
+    ByteWriter t(trailer);
+    t.u64(indexOffset);
+    for (char c : kTrailerMagic) t.u8(static_cast<uint8_t>(c));
+    out.write(reinterpret_cast<const char*>(trailer.data()), static_cast<streamsize>(trailer.size()));
+    out.close();
+}
+
+void ReplayWriter::flushIdleRun()
+{
+    if (idleRun == 0) return;
+    inputBuffer.push_back(static_cast<uint8_t>(kIdleRunFlag | (idleRun - 1)));
+    idleRun = 0;
+}
+
+void ReplayWriter::flushInputs()
+{
+    flushIdleRun();
+    if (inputBuffer.empty()) return;
+    writeChunk(kChunkInput, inputBuffer);
+    inputBuffer.clear();
+}
+
+void ReplayWriter::writeKeyframe(const Simulation& sim)
+{
+    keyframeIndex.emplace_back(static_cast<uint32_t>(tickCount), 0);
+    writeStateChunk(kChunkKeyframe, sim);
+    lastKeyframeTick = tickCount;
+}
+
+void ReplayWriter::writeStateChunk(uint8_t type, const Simulation& sim)
+{
+    // 상태 앞까지의 입력을 먼저 내보내야 청크 순서 = 틱 순서가 유지됨
+    flushInputs();
+    SimulationState state;
+    sim.saveState(state);
+    vector<uint8_t> payload;
+    ByteWriter w(payload);
+    w.u32(static_cast<uint32_t>(tickCount));
+    writeState(w, state);
+    if (type == kChunkKeyframe) keyframeIndex.back().second = static_cast<uint64_t>(out.tellp());
+    writeChunk(type, payload);
+}
+
+void ReplayWriter::writeChunk(uint8_t type, const vector<uint8_t>& payload)
+{
+    vector<uint8_t> header;
+    ByteWriter w(header);
+    w.u8(type);
+    w.u32(static_cast<uint32_t>(payload.size()));
+    out.write(reinterpret_cast<const char*>(header.data()), static_cast<streamsize>(header.size()));
+    out.write(reinterpret_cast<const char*>(payload.data()), static_cast<streamsize>(payload.size()));
+    if (!out) {
+        throw runtime_error("Failed to write replay file");
+    }
+}
+
+ReplayReader::ReplayReader(const string& path)
+{
+    ifstream in(path, ios::binary);
+    if (!in) {
+        throw runtime_error("Cannot open replay file: " + path);
+    }
+    vector<uint8_t> data((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    if (data.size() < kHeaderSize + kTrailerSize ||
+        !equal(kHeaderMagic, kHeaderMagic + 4, data.begin()) ||
+        !equal(kTrailerMagic, kTrailerMagic + 4, data.end() - 4)) {
+        throw runtime_error("Not a replay file (or recording was not finished): " + path);
+    }
+
+    ByteReader header(data.data(), kHeaderSize);
+    header.skip(4);
+    if (header.u16() != kFormatVersion) {
+        throw runtime_error("Unsupported replay format version");
+    }
+    keyframeInterval = header.u16();
+    seed = header.u64();
+
+    // 꼬리 → 색인 청크: 총 틱 수와 키프레임 위치
+    ByteReader trailer(data.data() + data.size() - kTrailerSize, kTrailerSize);
+    uint64_t indexOffset = trailer.u64();
+    if (indexOffset < kHeaderSize || indexOffset >= data.size() - kTrailerSize) {
+        throw runtime_error("Replay index offset is out of range");
+    }
+    ByteReader index(data.data() + indexOffset, data.size() - kTrailerSize - indexOffset);
+    if (index.u8() != kChunkIndex) {
+        throw runtime_error("Replay index chunk is missing");
+    }
+    index.u32(); // 길이
+    uint32_t totalTicks = index.u32();
+    uint32_t keyframeCount = index.u32();
+    for (uint32_t i = 0; i < keyframeCount; ++i) {
+        long tick = static_cast<long>(index.u32());
+        uint64_t offset = index.u64();
+        if (offset + 5 > indexOffset) throw runtime_error("Replay keyframe offset is out of range");
+        ByteReader chunk(data.data() + offset, indexOffset - offset);
+        if (chunk.u8() != kChunkKeyframe) throw runtime_error("Replay keyframe chunk is missing");
+        chunk.u32();
+        if (static_cast<long>(chunk.u32()) != tick) throw runtime_error("Replay keyframe tick mismatch");
+        SimulationState state;
+        readState(chunk, state);
+        keyframes.emplace_back(tick, std::move(state));
+    }
+    if (keyframes.empty() || keyframes.front().first != 0) {
+        throw runtime_error("Replay has no initial keyframe");
+    }
+
+    // 입력 청크를 순서대로 풀어 틱별 입력 배열 구성 (상태 교체 청크도 함께 수집)
+    inputs.reserve(totalTicks);
+    ByteReader chunks(data.data() + kHeaderSize, indexOffset - kHeaderSize);
+    while (!chunks.atEnd()) {
+        uint8_t type = chunks.u8();
+        uint32_t length = chunks.u32();
+        if (type == kChunkStateJump) {
+            size_t start = chunks.position();
+            long tick = static_cast<long>(chunks.u32());
+            SimulationState state;
+            readState(chunks, state);
+            if (chunks.position() - start != length) throw runtime_error("Replay state chunk is malformed");
+            stateJumps.emplace_back(tick, std::move(state));
+            continue;
+        }
+        if (type != kChunkInput) {
+            chunks.skip(length);
+            continue;
+        }
+        for (uint32_t i = 0; i < length; ++i) {
+            uint8_t code = chunks.u8();
+            if (code & kIdleRunFlag) {
+                inputs.insert(inputs.end(), static_cast<size_t>(code & 0x7F) + 1, kReplayNoInput);
+            } else {
+                inputs.push_back(code);
+            }
+        }
+    }
+    if (inputs.size() != totalTicks) {
+        throw runtime_error("Replay input stream does not match its tick count");
+    }
+    for (const auto& jump : stateJumps) {
+        if (jump.first >= getTickCount() || inputAt(jump.first) != kReplayStateJump) {
+            throw runtime_error("Replay state chunk does not match its input");
+        }
+    }
+}
+
+StepStatus ReplayReader::applyTick(Simulation& sim, long tick) const
+{
+    uint8_t input = inputAt(tick);
+    if (input == kReplayStateJump) {
+        auto it = lower_bound(stateJumps.begin(), stateJumps.end(), tick,
+            [](const pair<long, SimulationState>& entry, long value) { return entry.first < value; });
+        if (it == stateJumps.end() || it->first != tick) {
+            throw runtime_error("Replay state chunk is missing");
+        }
+        sim.loadState(it->second);
+        return sim.tick();
+    }
+    return applyReplayTick(sim, input);
+}
+
+void ReplayReader::seek(Simulation& sim, long tick) const
+{
+    tick = max(0L, min(tick, getTickCount()));
+    // tick 이하의 마지막 키프레임
+    auto it = upper_bound(keyframes.begin(), keyframes.end(), tick,
+        [](long value, const pair<long, SimulationState>& entry) { return value < entry.first; });
+    --it;
+    sim.loadState(it->second);
+    for (long t = it->first; t < tick; ++t) {
+        finishReplayTick(sim, applyTick(sim, t));
+    }
+}
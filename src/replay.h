@@ -0,0 +1,96 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "simulation.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// 틱별 입력 코드 (Game::processInput이 만드는 행동과 1:1 대응)
+enum ReplayInput : uint8_t {
+    kReplayNoInput = 0,           // 1~4: 방향
+    kReplayCompleteMissions = 0x10, // 디버그 'D'
+    kReplayJumpStage = 0x20,      // 디버그 '1'~'4' (하위 3비트 = 스테이지)
+    kReplayStateJump = 0x30       // 되감기: 같은 틱의 'J' 청크 상태로 교체
+};
+
+// 입력 코드를 시뮬레이션에 반영 (실제 게임과 리플레이가 같은 경로를 사용)
+void applyReplayInput(Simulation& sim, uint8_t input);
+// 입력 반영 후 한 틱 진행
+StepStatus applyReplayTick(Simulation& sim, uint8_t input);
+// 틱 결과에 따른 후속 처리 (클리어 → 다음 스테이지, 게임 오버 → 재시작)
+void finishReplayTick(Simulation& sim, StepStatus status);
+
+// 리플레이 파일 형식 (모든 정수는 리틀 엔디언)
+//   헤더 : "SNKR" | u16 버전 | u16 키프레임 간격 | u64 시드
+//   청크 : u8 종류 | u32 길이 | 본문
+//          'I' 입력 스트림 - 0x80|n: 입력 없는 틱 n+1개, 그 외: 입력 코드 1개 + 틱 1개
+//          'K' 키프레임   - u32 틱 | 전체 상태 (해당 틱의 입력 적용 전)
+//          'J' 상태 교체  - u32 틱 | 전체 상태 (되감기로 복원된 상태, 해당 틱 입력 = kReplayStateJump)
+//          'X' 색인       - u32 총 틱 수 | u32 개수 | (u32 틱, u64 청크 오프셋) * 개수
+//   꼬리 : u64 색인 청크 오프셋 | "SNKI"
+class ReplayWriter
+{
+public:
+    // 생성 시점의 상태를 0번 키프레임으로 기록
+    ReplayWriter(const string& path, const Simulation& sim, int keyframeInterval = 256);
+    ~ReplayWriter();
+
+    ReplayWriter(const ReplayWriter&) = delete;
+    ReplayWriter& operator=(const ReplayWriter&) = delete;
+
+    // 한 틱의 입력 기록 (틱 직후, 결과 처리 전에 호출)
+    void recordTick(uint8_t input);
+    // 되감기 등으로 상태가 입력과 무관하게 바뀐 경우: recordTick(kReplayStateJump) 전에 호출
+    void recordStateJump(const Simulation& sim);
+    // 틱 결과 처리까지 끝난 뒤 호출: 간격마다 키프레임 기록
+    void checkpoint(const Simulation& sim);
+    // 남은 입력과 색인을 쓰고 파일을 닫음 (여러 번 호출해도 안전)
+    void finish();
+
+    long getTickCount() const { return tickCount; }
+
+private:
+    ofstream out;
+    int keyframeInterval;
+    long tickCount = 0;
+    long lastKeyframeTick = -1;
+    int idleRun = 0;
+    vector<uint8_t> inputBuffer;
+    vector<pair<uint32_t, uint64_t>> keyframeIndex;
+    bool finished = false;
+
+    void flushIdleRun();
+    void flushInputs();
+    void writeKeyframe(const Simulation& sim);
+    void writeStateChunk(uint8_t type, const Simulation& sim);
+    void writeChunk(uint8_t type, const vector<uint8_t>& payload);
+};
+
+class ReplayReader
+{
+public:
+    explicit ReplayReader(const string& path);
+
+    uint64_t getSeed() const { return seed; }
+    long getTickCount() const { return static_cast<long>(inputs.size()); }
+    int getKeyframeInterval() const { return keyframeInterval; }
+    uint8_t inputAt(long tick) const { return inputs[static_cast<size_t>(tick)]; }
+
+    // tick번째 틱의 입력을 반영하고 한 틱 진행 (상태 교체 입력 처리 포함)
+    StepStatus applyTick(Simulation& sim, long tick) const;
+    // sim을 tick번째 틱 직전 상태로 맞춘다 (가장 가까운 이전 키프레임에서 최대 간격만큼 재시뮬레이션)
+    void seek(Simulation& sim, long tick) const;
+
+private:
+    uint64_t seed = 0;
+    int keyframeInterval = 0;
+    vector<uint8_t> inputs;                            // 틱별 입력 코드
+    vector<pair<long, SimulationState>> keyframes;     // 틱 오름차순
+    vector<pair<long, SimulationState>> stateJumps;    // 틱 오름차순
+};
+
+#endif
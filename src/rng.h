@@ -0,0 +1,79 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstdint>
+
+// 게임 인스턴스마다 하나씩 갖는 빠른 의사난수 생성기 (PCG32, XSH-RR)
+// 전역 rand()와 달리 공유 상태가 없어 스레드별로 독립적이며,
+// 같은 시드로 만들면 언제나 같은 수열을 재현한다.
+class Rng
+{
+public:
+    explicit Rng(uint64_t seed = 0) { reseed(seed); }
+
+    void reseed(uint64_t newSeed) {
+        seed = newSeed;
+        // splitmix64로 시드를 상태와 스트림 번호로 펼침
+        uint64_t mixed = newSeed;
+        state = splitmix64(mixed);
+        increment = splitmix64(mixed) | 1u;
+        next();
+    }
+
+    uint64_t getSeed() const { return seed; }
+
+    uint32_t next() {
+        uint64_t old = state;
+        state = old * 6364136223846793005ULL + increment;
+        uint32_t xorshifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+        uint32_t rot = static_cast<uint32_t>(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+    }
+
+    uint64_t next64() {
+        uint64_t high = next();
+        return (high << 32) | next();
+    }
+
+    // [0, bound) 범위의 균등 정수 (Lemire 방식, 편향 제거)
+    uint32_t nextBelow(uint32_t bound) {
+        if (bound == 0) return 0;
+        uint64_t product = static_cast<uint64_t>(next()) * bound;
+        uint32_t low = static_cast<uint32_t>(product);
+        if (low < bound) {
+            uint32_t threshold = static_cast<uint32_t>(-bound) % bound;
+            while (low < threshold) {
+                product = static_cast<uint64_t>(next()) * bound;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+    // [low, high] 범위의 균등 정수
+    int range(int low, int high) {
+        return low + static_cast<int>(nextBelow(static_cast<uint32_t>(high - low + 1)));
+    }
+
+    // 리플레이 / 스냅샷용 원시 상태
+    uint64_t getState() const { return state; }
+    uint64_t getIncrement() const { return increment; }
+    void setState(uint64_t newState, uint64_t newIncrement) {
+        state = newState;
+        increment = newIncrement | 1u;
+    }
+
+private:
+    uint64_t seed = 0;
+    uint64_t state = 0;
+    uint64_t increment = 1;
+
+    static uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+};
+
+#endif
@@ -0,0 +1,146 @@
+#include "rollout_runner.h"
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+// 워커 하나의 작업 덱: 주인은 뒤에서, 도둑은 앞에서 꺼낸다
+struct WorkQueue {
+    mutex lock;
+    deque<size_t> jobs;
+
+    bool popOwn(size_t& job) {
+        lock_guard<mutex> guard(lock);
+        if (jobs.empty()) return false;
+        job = jobs.back();
+        jobs.pop_back();
+        return true;
+    }
+
+    bool steal(size_t& job) {
+        lock_guard<mutex> guard(lock);
+        if (jobs.empty()) return false;
+        job = jobs.front();
+        jobs.pop_front();
+        return true;
+    }
+};
+
+}
+
+RolloutRunner::RolloutRunner(int threadCount)
+    : threads(threadCount)
+{
+    if (threads <= 0) {
+        threads = static_cast<int>(thread::hardware_concurrency());
+    }
+    if (threads <= 0) {
+        threads = 1;
+    }
+}
+
+RolloutResult RolloutRunner::runJob(const RolloutJob& job, const HeadlessOptions& baseOptions)
+{
+    RolloutResult result;
+    result.job = job;
+
+    HeadlessOptions options = baseOptions;
+    options.startStage = job.stage;
+    options.profiler = nullptr;
+
+    HeadlessStats stats;
+    Simulation sim(job.seed, job.boardHeight, job.boardWidth);
+    if (job.stagePack) sim.setStagePack(job.stagePack);
+    if (job.wallDensity > 0) sim.setProceduralStages(job.wallDensity);
+    sim.jumpToStage(job.stage);
+    runHeadlessGame(sim, options, stats);
+
+    result.ticks = stats.ticks;
+    result.finalStage = sim.getCurrentStage();
+    result.stagesCleared = static_cast<int>(stats.stagesCleared);
+    result.maxLength = stats.bestLength;
+    result.allStagesCleared = stats.allStagesCleared > 0;
+    result.timedOut = stats.timeouts > 0;
+    result.boardFilled = stats.boardsFilled > 0;
+    result.gameOverReason = sim.getGameOverReason();
+    return result;
+}
+
+RolloutSummary RolloutRunner::run(const vector<RolloutJob>& jobs, const HeadlessOptions& options) const
+{
+    RolloutSummary summary;
+    summary.results.resize(jobs.size());
+    summary.workers.resize(threads);
+
+    // 작업을 라운드 로빈으로 초기 배분
+    vector<unique_ptr<WorkQueue>> queues;
+    for (int w = 0; w < threads; ++w) {
+        queues.emplace_back(new WorkQueue());
+    }
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        queues[i % threads]->jobs.push_back(i);
+    }
+
+    auto begin = chrono::steady_clock::now();
+
+    // 각 워커는 결과를 자기 구역(results의 해당 인덱스, workers[w])에만 기록
+    auto worker = [&](int self) {
+        RolloutWorkerStats& stats = summary.workers[self];
+        while (true) {
+            size_t index;
+            bool found = queues[self]->popOwn(index);
+            for (int k = 1; !found && k < threads; ++k) {
+                if (queues[(self + k) % threads]->steal(index)) {
+                    found = true;
+                    stats.jobsStolen++;
+                }
+            }
+            // 새 작업이 추가되지 않으므로 모든 덱이 비면 종료
+            if (!found) break;
+
+            summary.results[index] = runJob(jobs[index], options);
+            stats.jobsRun++;
+            stats.ticks += summary.results[index].ticks;
+        }
+    };
+
+    vector<thread> pool;
+    for (int w = 1; w < threads; ++w) {
+        pool.emplace_back(worker, w);
+    }
+    worker(0);
+    for (auto& t : pool) {
+        t.join();
+    }
+
+    // 스레드별 결과 병합
+    HeadlessStats& totals = summary.totals;
+    for (const auto& result : summary.results) {
+        totals.games++;
+        totals.ticks += result.ticks;
+        totals.stagesCleared += result.stagesCleared;
+        if (result.allStagesCleared) totals.allStagesCleared++;
+        else if (result.timedOut) totals.timeouts++;
+        else if (result.boardFilled) totals.boardsFilled++;
+        else totals.gameOvers++;
+        if (result.maxLength > totals.bestLength) totals.bestLength = result.maxLength;
+    }
+    totals.elapsedSeconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+    return summary;
+}
+
+void printRolloutSummary(const RolloutSummary& summary, ostream& out)
+{
+    printHeadlessStats(summary.totals, out);
+    for (size_t w = 0; w < summary.workers.size(); ++w) {
+        const RolloutWorkerStats& stats = summary.workers[w];
+        out << "worker " << w << ": jobs " << stats.jobsRun
+            << ", stolen " << stats.jobsStolen
+            << ", ticks " << stats.ticks << "\n";
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef ROLLOUT_RUNNER_H
+#define ROLLOUT_RUNNER_H
+
+#include "headless.h"
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// 롤아웃 하나: 시작 스테이지와 시드 쌍
+struct RolloutJob {
+    int stage = 1;
+    uint64_t seed = 0;
+    int boardHeight = Simulation::kDefaultBoardHeight;
+    int boardWidth = Simulation::kDefaultBoardWidth;
+    shared_ptr<const StagePack> stagePack;  // 설정 시 팩의 스테이지로 진행 (스레드 간 공유, 읽기 전용)
+    int wallDensity = 0;                    // 0보다 크면 절차적 스테이지
+};
+
+// 롤아웃 하나의 결과
+struct RolloutResult {
+    RolloutJob job;
+    long ticks = 0;
+    int finalStage = 1;      // 게임이 끝났을 때의 스테이지
+    int stagesCleared = 0;
+    int maxLength = 0;
+    bool allStagesCleared = false;
+    bool timedOut = false;
+    bool boardFilled = false; // 빈 칸이 없어 끝남 (게임 오버 아님)
+    string gameOverReason;
+};
+
+// 워커 스레드별 통계
+struct RolloutWorkerStats {
+    long jobsRun = 0;
+    long jobsStolen = 0;
+    long ticks = 0;
+};
+
+// 전체 실행 결과 (워커별 결과를 실행 후 병합)
+struct RolloutSummary {
+    vector<RolloutResult> results;       // 입력 작업 순서와 동일
+    vector<RolloutWorkerStats> workers;
+    HeadlessStats totals;
+};
+
+// 완주형 헤드리스 게임을 작업 훔치기(work-stealing) 스레드 풀에서 실행
+// 게임 길이가 제각각이라 정적 분할 대신, 각 워커가 자기 덱을 비우면
+// 다른 워커 덱의 반대쪽 끝에서 작업을 가져온다.
+class RolloutRunner
+{
+public:
+    // threadCount가 0이면 하드웨어 스레드 수 사용
+    explicit RolloutRunner(int threadCount = 0);
+
+    int threadCount() const { return threads; }
+
+    // options의 게임당 최대 틱과 봇 종류(autopilot / cycleSolver)를 모든 작업에 적용
+    // (시작 스테이지 / 시드 / 보드는 작업별 값 사용, 프로파일러는 스레드 간에 공유하지 않으므로 무시)
+    RolloutSummary run(const vector<RolloutJob>& jobs, const HeadlessOptions& options) const;
+
+    // 한 작업을 현재 스레드에서 실행
+    static RolloutResult runJob(const RolloutJob& job, const HeadlessOptions& options);
+
+private:
+    int threads;
+};
+
+void printRolloutSummary(const RolloutSummary& summary, ostream& out);
+
+#endif
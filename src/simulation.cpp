@@ -0,0 +1,635 @@
+#include "simulation.h"
+#include "stage_pack.h"
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+Simulation::Simulation(uint64_t seed, int boardHeight, int boardWidth)
+    : rng(seed), boardHeight(boardHeight), boardWidth(boardWidth)
+{
+    if (boardHeight < kMinBoardSize || boardWidth < kMinBoardSize ||
+        boardHeight > kMaxBoardSize || boardWidth > kMaxBoardSize) {
+        throw std::invalid_argument("Board size must be between " + to_string(kMinBoardSize) +
+                                    " and " + to_string(kMaxBoardSize));
+    }
+    gameMap.reset(boardHeight, boardWidth, MapType::BASIC, 1);
+    generateItems();
+    generateGate();
+
+    // 초기 게임 속도를 0.2초(200ms)로 설정
+    gameSpeedDelay = 200;
+}
+
+StepStatus Simulation::step(int action)
+{
+    if (action >= 1 && action <= 4) {
+        applyDirection(action);
+    }
+    return tick();
+}
+
+StepStatus Simulation::tick()
+{
+    ProfileScope scope(profiler, TickPhase::SIMULATION);
+    int previousDirection = gameMap.snakeHeadObject.currentDirection;
+
+    if (allMissionsCompleted) {
+        return StepStatus::STAGE_CLEAR;
+    }
+
+    if (!update(growthItemTimer, poisonItemTimer, timeItemTimer, previousDirection)) {
+        return StepStatus::GAME_OVER;
+    }
+
+    // 스네이크가 방향을 가지고 있을 때만 타이머 업데이트 (실제로 움직일 때만)
+    if (gameMap.snakeHeadObject.currentDirection != -1) {
+        updateTimers(growthItemTimer, poisonItemTimer, timeItemTimer);
+        gameTimerSeconds++;
+        elapsedMilliseconds += getTickPeriodMs();
+    }
+    return StepStatus::RUNNING;
+}
+
+void Simulation::applyDirection(int newDirection)
+{
+    int currentDir = gameMap.snakeHeadObject.currentDirection;
+
+    // 1. 같은 방향 키 입력은 무시
+    if (currentDir == newDirection) {
+        return;
+    }
+
+    // 2. 역방향 이동 검사 (현재 방향이 설정되어 있을 때만)
+    if (currentDir != -1) {
+        bool isOpposite = false;
+        switch (currentDir) {
+            case 1: isOpposite = (newDirection == 4); break; // 위 ↔ 아래
+            case 2: isOpposite = (newDirection == 3); break; // 왼쪽 ↔ 오른쪽
+            case 3: isOpposite = (newDirection == 2); break; // 오른쪽 ↔ 왼쪽
+            case 4: isOpposite = (newDirection == 1); break; // 아래 ↔ 위
+        }
+
+        if (isOpposite) {
+            // 역방향 이동 시도를 표시하기 위해 특별한 값 설정
+            gameMap.snakeHeadObject.currentDirection = -2; // 역방향 시도 표시
+            return;
+        }
+    }
+
+    // 3. 유효한 방향 변경
+    gameMap.snakeHeadObject.currentDirection = newDirection;
+}
+
+void Simulation::goToNextStage()
+{
+    currentStage++;
+    if(currentStage > getStageCount()) {
+        onAllStagesCleared();
+        currentStage = 1;
+    }
+    resetCurrentStage();
+}
+
+void Simulation::setStagePack(shared_ptr<const StagePack> pack)
+{
+    stagePack = move(pack);
+    proceduralDensity = 0;
+    currentStage = 1;
+    if (!stagePack) {
+        boardHeight = kDefaultBoardHeight;
+        boardWidth = kDefaultBoardWidth;
+    }
+    resetCurrentStage();
+}
+
+void Simulation::setProceduralStages(int wallDensity)
+{
+    stagePack.reset();
+    proceduralDensity = max(0, min(wallDensity, static_cast<int>(Map::kMaxWallDensity)));
+    currentStage = 1;
+    resetCurrentStage();
+}
+
+int Simulation::getStageCount() const
+{
+    if (stagePack) return stagePack->size();
+    return isEndless() ? numeric_limits<int>::max() : kFinalStage;
+}
+
+string Simulation::getStageName() const
+{
+    if (stagePack) return stagePack->stageName(currentStage - 1);
+    if (isEndless()) return "PROCEDURAL";
+    switch (currentStage) {
+        case 1: return "BASIC";
+        case 2: return "MAZE";
+        case 3: return "ISLANDS";
+        case 4: return "CROSS";
+        default: return "";
+    }
+}
+
+void Simulation::jumpToStage(int stage)
+{
+    currentStage = stage;
+    resetCurrentStage();
+}
+
+void Simulation::saveState(SimulationState& state, bool withBody) const
+{
+    state.rngSeed = rng.getSeed();
+    state.rngState = rng.getState();
+    state.rngIncrement = rng.getIncrement();
+
+    state.mapHeight = gameMap.mapSize.height;
+    state.mapWidth = gameMap.mapSize.width;
+    state.mapType = gameMap.currentMapType;
+    state.stage = currentStage;
+    state.layoutSeed = layoutSeed;
+    state.wallDensity = proceduralDensity;
+
+    const SnakeHead& head = gameMap.snakeHeadObject;
+    state.head = head.coord;
+    state.direction = head.currentDirection;
+    state.body.clear();
+    if (withBody) {
+        for (const Coord& segment : head.snakeBodySegments) {
+            state.body.push_back(segment);
+        }
+    }
+    state.growthItem = gameMap.growthItemObject.coord;
+    state.poisonItem = gameMap.poisonItemObject.coord;
+    state.timeItem = gameMap.timeItemObject.coord;
+    for (int i = 0; i < 2; ++i) {
+        state.gates[i] = gameMap.gameGates[i].coord;
+        state.gateExit[i] = gameMap.gameGates[i].exitDirection;
+        state.gateActive[i] = gameMap.gameGates[i].isActive;
+    }
+
+    state.gateActiveDuration = gateActiveDuration;
+    state.growthItemCount = growthItemCount;
+    state.poisonItemCount = poisonItemCount;
+    state.gatesUsedCount = gatesUsedCount;
+    state.maxSnakeLength = maxSnakeLength;
+    state.gameTimerSeconds = gameTimerSeconds;
+    state.elapsedMilliseconds = elapsedMilliseconds;
+    state.gameSpeedDelay = gameSpeedDelay;
+    state.speedMultiplier = speedMultiplier;
+    state.speedBoostTimer = speedBoostTimer;
+    state.growthItemTimer = growthItemTimer;
+    state.poisonItemTimer = poisonItemTimer;
+    state.timeItemTimer = timeItemTimer;
+    state.missionStatus[0] = missionSnakeLengthStatus;
+    state.missionStatus[1] = missionGrowthItemStatus;
+    state.missionStatus[2] = missionPoisonItemStatus;
+    state.missionStatus[3] = missionGateUseStatus;
+    state.allMissionsCompleted = allMissionsCompleted;
+    state.boardFull = boardFull;
+}
+
+void Simulation::loadState(const SimulationState& state)
+{
+    rng.reseed(state.rngSeed);
+    rng.setState(state.rngState, state.rngIncrement);
+
+    // 벽 배치는 크기 / 맵 종류 / 스테이지로 정해지므로 같으면 맵을 다시 만들지 않고 제자리 복원
+    bool sameLayout = state.mapHeight == gameMap.mapSize.height &&
+                      state.mapWidth == gameMap.mapSize.width &&
+                      state.mapType == gameMap.currentMapType && state.stage == currentStage &&
+                      (state.mapType != MapType::PROCEDURAL ||
+                       (state.layoutSeed == layoutSeed && state.wallDensity == proceduralDensity));
+    if (!sameLayout && state.mapType == MapType::CUSTOM &&
+        (!stagePack || state.stage < 1 || state.stage > stagePack->size())) {
+        throw runtime_error("Saved state needs the stage pack it was recorded with");
+    }
+    currentStage = state.stage;
+    if (state.mapType == MapType::PROCEDURAL) {
+        proceduralDensity = state.wallDensity;
+        layoutSeed = state.layoutSeed;
+    }
+    if (!sameLayout) {
+        if (state.mapType == MapType::CUSTOM) {
+            gameMap = stagePack->prototype(state.stage - 1);
+        } else if (state.mapType == MapType::PROCEDURAL) {
+            gameMap.reset(state.mapHeight, state.mapWidth, state.mapType, state.stage, layoutSeed, proceduralDensity);
+        } else {
+            gameMap.reset(state.mapHeight, state.mapWidth, state.mapType, state.stage);
+        }
+        boardHeight = state.mapHeight;
+        boardWidth = state.mapWidth;
+        mapGeneration++;
+    }
+    gameMap.restoreSnake(state.head, state.direction, state.body);
+    gameMap.growthItemObject = GrowthItem(state.growthItem.row, state.growthItem.col);
+    gameMap.poisonItemObject = PoisonItem(state.poisonItem.row, state.poisonItem.col);
+    gameMap.timeItemObject = TimeItem(state.timeItem.row, state.timeItem.col);
+    for (int i = 0; i < 2; ++i) {
+        gameMap.gameGates[i] = Gate(state.gates[i].row, state.gates[i].col);
+        gameMap.gameGates[i].exitDirection = state.gateExit[i];
+        gameMap.gameGates[i].isActive = state.gateActive[i];
+    }
+
+    gateActiveDuration = state.gateActiveDuration;
+    growthItemCount = state.growthItemCount;
+    poisonItemCount = state.poisonItemCount;
+    gatesUsedCount = state.gatesUsedCount;
+    maxSnakeLength = state.maxSnakeLength;
+    gameTimerSeconds = state.gameTimerSeconds;
+    elapsedMilliseconds = state.elapsedMilliseconds;
+    gameSpeedDelay = state.gameSpeedDelay;
+    speedMultiplier = state.speedMultiplier;
+    speedBoostTimer = state.speedBoostTimer;
+    growthItemTimer = state.growthItemTimer;
+    poisonItemTimer = state.poisonItemTimer;
+    timeItemTimer = state.timeItemTimer;
+    missionSnakeLengthStatus = state.missionStatus[0];
+    missionGrowthItemStatus = state.missionStatus[1];
+    missionPoisonItemStatus = state.missionStatus[2];
+    missionGateUseStatus = state.missionStatus[3];
+    allMissionsCompleted = state.allMissionsCompleted;
+    boardFull = state.boardFull;
+    gameOverReason = "";
+}
+
+void Simulation::completeMissionsForDebug()
+{
+    MissionTargets targets = getCurrentMissionTargets();
+    growthItemCount = targets.growthItems;
+    poisonItemCount = targets.poisonItems;
+    gatesUsedCount = targets.gateUses;
+    gameMap.resizeSnakeBody(targets.snakeLength);
+    checkMissions();
+}
+
+bool Simulation::isSnakeBodySizeValid(size_t requiredSize) const
+{
+    return gameMap.snakeHeadObject.snakeBodySegments.size() >= requiredSize;
+}
+
+void Simulation::safeAddSnakeBody()
+{
+    if (!isSnakeBodySizeValid(2)) {
+        // 몸통이 2개 미만이면 기본 위치에 추가
+        Coord headPos = gameMap.snakeHeadObject.coord;
+        gameMap.appendSnakeBody({headPos.row + 1, headPos.col});
+        return;
+    }
+    
+    const auto& segments = gameMap.snakeHeadObject.snakeBodySegments;
+    const Coord& last = segments.back();
+    const Coord& sec = segments[segments.size() - 2];
+    
+    gameMap.appendSnakeBody({
+        last.row - (sec.row - last.row),
+        last.col - (sec.col - last.col)
+    });
+}
+
+bool Simulation::safeRemoveSnakeBody()
+{
+    if (gameMap.snakeHeadObject.snakeBodySegments.size() <= 3) {
+        return false; // 최소 길이 유지
+    }
+    
+    return gameMap.removeSnakeTail();
+}
+
+void Simulation::updateTimers(int &growthItemTimer, int &poisonItemTimer, int &timeItemTimer)
+{
+    growthItemTimer++;
+    poisonItemTimer++;
+    timeItemTimer++;
+
+    if (speedBoostTimer > 0) {
+        speedBoostTimer--;
+        if (speedBoostTimer == 0) {
+            speedMultiplier = 1;
+        }
+    }
+}
+
+void Simulation::resetCurrentStage()
+{
+    // 초기 벽 개수 추출은 맵 생성에 쓰이지 않지만 시드별 진행을 바꾸지 않도록 RNG 순서를 유지
+    rng.range(2, 5);
+    if (stagePack) {
+        // 팩의 스테이지는 처음 한 번 만든 원본 맵을 복사 (셀 격자는 매핑된 팩을 공유)
+        gameMap = stagePack->prototype(currentStage - 1);
+        boardHeight = gameMap.mapSize.height;
+        boardWidth = gameMap.mapSize.width;
+    } else if (isEndless()) {
+        // 스테이지마다 새 시드로 생성 (시드는 상태에 저장되어 복원 / 리플레이에서 같은 맵을 다시 만듦)
+        layoutSeed = rng.next64();
+        gameMap.reset(boardHeight, boardWidth, MapType::PROCEDURAL, currentStage, layoutSeed, proceduralDensity);
+    } else {
+        gameMap.reset(boardHeight, boardWidth, getMapTypeForStage(currentStage), currentStage);
+    }
+    mapGeneration++;
+    gateActiveDuration = 0;
+    growthItemCount = 0;
+    poisonItemCount = 0;
+    gatesUsedCount = 0;
+    maxSnakeLength = 3;
+    gameTimerSeconds = 0;
+    elapsedMilliseconds = 0;
+    speedMultiplier = 1;
+    
+    // 아이템 타이머들 초기화
+    growthItemTimer = 0;
+    poisonItemTimer = 0;
+    timeItemTimer = 0;
+    
+    // 미션 상태 초기화
+    missionSnakeLengthStatus = ' ';
+    missionGrowthItemStatus = ' ';
+    missionPoisonItemStatus = ' ';
+    missionGateUseStatus = ' ';
+    allMissionsCompleted = false;
+    
+    // 게임 오버 이유 초기화
+    gameOverReason = "";
+    
+    generateItems();
+    generateGate();
+    
+    gameSpeedDelay = getStageTickDelay(currentStage);
+}
+
+void Simulation::checkMissions()
+{
+    MissionTargets targets = getCurrentMissionTargets();
+    
+    missionSnakeLengthStatus = (static_cast<int>(gameMap.snakeHeadObject.snakeBodySegments.size()) >= targets.snakeLength) ? 'v' : ' ';
+    missionGrowthItemStatus = (growthItemCount >= targets.growthItems) ? 'v' : ' ';
+    missionPoisonItemStatus = (poisonItemCount >= targets.poisonItems) ? 'v' : ' ';
+    missionGateUseStatus = (gatesUsedCount >= targets.gateUses) ? 'v' : ' ';
+
+    allMissionsCompleted = (missionSnakeLengthStatus == 'v' && 
+                          missionGrowthItemStatus == 'v' && 
+                          missionPoisonItemStatus == 'v' && 
+                          missionGateUseStatus == 'v');
+}
+
+bool Simulation::update(int &growthItemTimer, int &poisonItemTimer, int &timeItemTimer, int previousDirection)
+{
+    // 먼저 역방향 이동 검사
+    if (gameMap.snakeHeadObject.currentDirection == -2) {
+        gameOverReason = "Tried moving in the opposite direction.";
+        return false; // 게임 종료
+    }
+    
+    if (gateActiveDuration == 0)
+    {
+        gameMap.gameGates[0].isActive = false;
+        gameMap.gameGates[1].isActive = false;
+    }
+    else
+        gateActiveDuration--;
+    
+    // 몸통 이동과 머리 이동 (점유 격자 동시 갱신)
+    gameMap.advanceSnake();
+    
+    // 게이트 통과 처리
+    for (size_t i = 0; i < gameMap.gameGates.size(); i++)
+    {
+        auto it = gameMap.gameGates.begin() + i;
+        if (it->coord == gameMap.snakeHeadObject.coord)
+        {
+            it->isActive = true;
+            gateActiveDuration = static_cast<int>(gameMap.snakeHeadObject.snakeBodySegments.size());
+            auto other = (i == 0 ? gameMap.gameGates.begin() + 1 : gameMap.gameGates.begin());
+            
+            // 게이트 출구 방향 결정 및 안전한 출구 위치 계산
+            int exitDirection;
+            Coord exitPosition;
+            findGateExit(*other, gameMap.snakeHeadObject.currentDirection, exitPosition, exitDirection);
+            
+            // 스네이크를 안전한 출구 위치로 텔레포트
+            gameMap.teleportSnakeHead(exitPosition);
+            gameMap.snakeHeadObject.currentDirection = exitDirection;
+            
+            // 다른 게이트도 활성화
+            other->isActive = true;
+            
+            gatesUsedCount++;
+            break;
+        }
+    }
+
+    // 아이템 5초(50틱)마다 자동 재생성
+    if (growthItemTimer >= 50) { generateGItem(); growthItemTimer = 0; }
+    if (poisonItemTimer >= 50) { generatePItem(); poisonItemTimer = 0; }
+    if (timeItemTimer >= 50) { generateTItem(); timeItemTimer = 0; }
+
+    if (gameMap.snakeHeadObject.coord == gameMap.growthItemObject.coord)
+    {
+        onItemConsumed();
+        growthItemCount++;
+        generateGItem();
+        growthItemTimer = 0;
+        safeAddSnakeBody();
+    }
+    if (gameMap.snakeHeadObject.coord == gameMap.poisonItemObject.coord)
+    {
+        onItemConsumed();
+        poisonItemCount++;
+        generatePItem();
+        poisonItemTimer = 0;
+        if (!safeRemoveSnakeBody()) {
+            gameOverReason = "Length is less than 3.";
+            return false;
+        }
+    }
+    if (gameMap.snakeHeadObject.coord == gameMap.timeItemObject.coord)
+    {
+        onItemConsumed();
+        generateTItem();
+        timeItemTimer = 0;
+        speedMultiplier = 1.5;
+        speedBoostTimer = 40;
+    }
+
+    // mission
+    checkMissions();
+
+    // allMissionsCompleted
+    if (static_cast<int>(gameMap.snakeHeadObject.snakeBodySegments.size()) > maxSnakeLength)
+        maxSnakeLength = static_cast<int>(gameMap.snakeHeadObject.snakeBodySegments.size());
+
+    return isValid(previousDirection);
+}
+
+bool Simulation::findGateExit(const Gate& exitGate, int inDirection, Coord& exitPosition, int& exitDirection) const
+{
+    return gameMap.findGateExit(exitGate, inDirection, exitPosition, exitDirection);
+}
+
+bool Simulation::isValid(int /*previousDirection*/)
+{
+    ProfileScope scope(profiler, TickPhase::COLLISION);
+    // 역방향 이동 시도 검사
+    if (gameMap.snakeHeadObject.currentDirection == -2) {
+        gameOverReason = "Tried moving in the opposite direction.";
+        return false;
+    }
+    
+    // 게이트가 활성화된 상태인지 확인 (두 게이트 모두 확인)
+    bool isOnActiveGate = false;
+    for (const auto& gate : gameMap.gameGates) {
+        if (gate.coord == gameMap.snakeHeadObject.coord && gate.isActive) {
+            isOnActiveGate = true;
+            break;
+        }
+    }
+    
+    // 벽과의 충돌 검사 (활성화된 게이트 위에 있으면 벽 충돌 무시)
+    if (!isOnActiveGate) {
+        CellType headCell = gameMap.cellAt(gameMap.snakeHeadObject.coord);
+        if (headCell == CellType::WALL) {
+            gameOverReason = "Collided with the wall.";
+            return false;
+        }
+        if (headCell == CellType::IMMUNE_WALL) {
+            gameOverReason = "Collided with the immune wall.";
+            return false;
+        }
+    }
+    
+    // 몸통과 벽 충돌 검사 (점유 격자가 겹친 개수를 유지)
+    if (gameMap.isBodyOnWall()) {
+        gameOverReason = "Snake body overlapped with wall.";
+        return false;
+    }
+    if (gameMap.isBodyOnImmuneWall()) {
+        gameOverReason = "Snake body overlapped with immune wall.";
+        return false;
+    }
+    
+    // 자기 몸통과의 충돌 검사
+    if (gameMap.bodyCountAt(gameMap.snakeHeadObject.coord) > 0) {
+        gameOverReason = "Collided with the body.";
+        return false;
+    }
+    
+    // 최소 길이 검사
+    if (gameMap.snakeHeadObject.snakeBodySegments.size() < 3) {
+        gameOverReason = "Length is less than 3.";
+        return false;
+    }
+    
+    return true;
+}
+
+bool Simulation::generateRandCoord(int &row, int &col)
+{
+    ProfileScope scope(profiler, TickPhase::ITEM_RESPAWN);
+    // 맵이 관리하는 빈 셀 집합에서 균등 추출 (머리와 다른 아이템 위치는 제외)
+    const Coord excluded[4] = {
+        gameMap.snakeHeadObject.coord,
+        gameMap.growthItemObject.coord,
+        gameMap.poisonItemObject.coord,
+        gameMap.timeItemObject.coord
+    };
+    Coord picked;
+    if (!gameMap.pickFreeCell(rng, picked, excluded, 4)) {
+        boardFull = true;
+        return false;
+    }
+    boardFull = false;
+    row = picked.row;
+    col = picked.col;
+    return true;
+}
+
+void Simulation::generateGate()
+{
+    // 후보 벽 목록은 맵이 미리 단계별로 만들어 두므로 여기서는 추출만 수행
+    int wallIndex1, wallIndex2;
+    if (!gameMap.pickGateWalls(rng, wallIndex1, wallIndex2)) {
+        throw runtime_error("Not enough walls to place gates");
+    }
+    gameMap.gameGates[0] = Gate(gameMap.regularWalls[wallIndex1]);
+    gameMap.gameGates[1] = Gate(gameMap.regularWalls[wallIndex2]);
+}
+
+void Simulation::generateItems()
+    {
+        generateGItem();
+        generatePItem();
+        generateTItem();
+    }
+
+bool Simulation::generateTItem()
+{
+    Coord pos = Map::parkedCoord();
+    bool placed = generateRandCoord(pos.row, pos.col);
+    gameMap.timeItemObject = TimeItem(pos.row, pos.col);
+    return placed;
+}
+
+bool Simulation::generateGItem()
+{
+    Coord pos = Map::parkedCoord();
+    bool placed = generateRandCoord(pos.row, pos.col);
+    gameMap.growthItemObject = GrowthItem(pos.row, pos.col);
+    return placed;
+}
+
+bool Simulation::generatePItem()
+{
+    Coord pos = Map::parkedCoord();
+    bool placed = generateRandCoord(pos.row, pos.col);
+    gameMap.poisonItemObject = PoisonItem(pos.row, pos.col);
+    return placed;
+}
+
+MapType Simulation::getMapTypeForStage(int stage)
+{
+    switch(stage) {
+        case 1: return MapType::BASIC;
+        case 2: return MapType::MAZE;
+        case 3: return MapType::ISLANDS;
+        case 4: return MapType::CROSS;
+        default: return MapType::BASIC;
+    }
+}
+
+int Simulation::getStageTickDelay(int stage) const
+{
+    if (stagePack) return stagePack->stage(stage - 1).header->tickDelay;
+    if (isEndless()) stage = min(stage, static_cast<int>(kFinalStage));
+    // 스테이지별 게임 속도 설정 (점진적으로 빨라짐)
+    switch(stage) {
+        case 1: return 250; // 가장 느림 (쉬움)
+        case 2: return 200; // 중간
+        case 3: return 170; // 빠름
+        case 4: return 150; // 가장 빠름 (어려움)
+        default: return 200;
+    }
+}
+
+Simulation::MissionTargets Simulation::getCurrentMissionTargets() const
+{
+    if (stagePack) {
+        const StageHeader& header = *stagePack->stage(currentStage - 1).header;
+        return {header.snakeLength, header.growthItems, header.poisonItems, header.gateUses};
+    }
+    return getMissionTargets(isEndless() ? min(currentStage, static_cast<int>(kFinalStage)) : currentStage);
+}
+
+Simulation::MissionTargets Simulation::getMissionTargets(int stage)
+{
+    switch(stage) {
+        case 1: // 스테이지 1: 쉬운 입문 난이도
+            return {5, 3, 1, 1}; // 길이 5, +아이템 3개, -아이템 1개, 게이트 1회
+        case 2: // 스테이지 2: 중간 난이도 (미로)
+            return {7, 5, 2, 2}; // 길이 7, +아이템 5개, -아이템 2개, 게이트 2회
+        case 3: // 스테이지 3: 높은 난이도 (섬)
+            return {9, 7, 3, 3}; // 길이 9, +아이템 7개, -아이템 3개, 게이트 3회
+        case 4: // 스테이지 4: 최고 난이도 (십자형) - 플레이 가능한 수준
+            return {12, 8, 4, 2}; // 길이 12, +아이템 8개, -아이템 4개, 게이트 2회
+        default:
+            return {5, 3, 1, 1}; // 기본값
+    }
+}
@@ -0,0 +1,221 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "map.h"
+#include "block.h"
+#include "rng.h"
+#include "tick_profiler.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+using namespace std;
+
+class StagePack;
+
+// 한 틱 진행 결과
+enum class StepStatus {
+    RUNNING,        // 계속 진행
+    GAME_OVER,      // 충돌 등으로 게임 종료 (getGameOverReason 참고)
+    STAGE_CLEAR     // 현재 스테이지의 모든 미션 달성
+};
+
+// 시뮬레이션 전체 상태 (리플레이 키프레임 / 되감기용)
+// 벽 배치는 (맵 크기, 맵 종류, 스테이지, 절차적 맵이면 생성 시드와 밀도)로 결정되므로 저장하지 않고 복원 시 다시 만든다.
+struct SimulationState {
+    uint64_t rngSeed = 0;
+    uint64_t rngState = 0;
+    uint64_t rngIncrement = 1;
+
+    int mapHeight = 21;
+    int mapWidth = 41;
+    MapType mapType = MapType::BASIC;
+    int stage = 1;
+    uint64_t layoutSeed = 0;      // PROCEDURAL일 때만 의미 있음
+    int wallDensity = 0;
+
+    Coord head{0, 0};
+    int direction = -1;
+    vector<Coord> body;           // 0번 = 목
+    Coord growthItem{0, 0};
+    Coord poisonItem{0, 0};
+    Coord timeItem{0, 0};
+    Coord gates[2] = {{0, 0}, {0, 0}};
+    int gateExit[2] = {6, 6};
+    bool gateActive[2] = {false, false};
+
+    int gateActiveDuration = 0;
+    int growthItemCount = 0;
+    int poisonItemCount = 0;
+    int gatesUsedCount = 0;
+    int maxSnakeLength = 3;
+    int gameTimerSeconds = 0;
+    double elapsedMilliseconds = 0;
+    int gameSpeedDelay = 200;
+    float speedMultiplier = 1;
+    int speedBoostTimer = 0;
+    int growthItemTimer = 0;
+    int poisonItemTimer = 0;
+    int timeItemTimer = 0;
+    char missionStatus[4] = {' ', ' ', ' ', ' '};
+    bool allMissionsCompleted = false;
+    bool boardFull = false;
+};
+
+// 게임 규칙만 담당하는 시뮬레이션 코어 (ncurses 비의존)
+// 맵, 스네이크, 아이템, 게이트, 미션 상태를 보유하고 step()으로 한 틱씩 진행한다.
+class Simulation
+{
+public:
+    // 기본 보드 크기와 허용 범위 (테두리 벽 포함, 행 x 열)
+    static const int kDefaultBoardHeight = 21;
+    static const int kDefaultBoardWidth = 41;
+    static const int kMinBoardSize = 10;
+    static const int kMaxBoardSize = 16384;
+
+    // seed: 아이템 / 게이트 배치에 쓰이는 인스턴스 전용 난수 생성기의 시드
+    // boardHeight / boardWidth: 보드 크기 (범위를 벗어나면 invalid_argument)
+    explicit Simulation(uint64_t seed = 0, int boardHeight = kDefaultBoardHeight,
+                        int boardWidth = kDefaultBoardWidth);
+    virtual ~Simulation() = default;
+
+    // 방향(1=위, 2=왼쪽, 3=오른쪽, 4=아래, 0=입력 없음)을 적용한 뒤 한 틱 진행
+    StepStatus step(int action);
+    // 입력 없이 한 틱 진행 (방향은 applyDirection으로 미리 반영)
+    StepStatus tick();
+
+    // processInput과 동일한 방향 전환 규칙 (같은 방향 무시, 역방향은 -2로 표시)
+    void applyDirection(int newDirection);
+
+    bool update(int &growthItemTimer, int &poisonItemTimer, int &timeItemTimer, int previousDirection = 0);
+    bool isValid(int /*previousDirection*/);
+    // exitGate로 나올 때의 위치와 방향 (inDirection = 진입 방향). 출구가 막혀 게이트 위에 남으면 false
+    bool findGateExit(const Gate& exitGate, int inDirection, Coord& exitPosition, int& exitDirection) const;
+    // 빈 셀이 하나도 없으면 false를 반환하고 보드 가득 참 상태로 표시
+    bool generateRandCoord(int &row, int &col);
+    void generateGate();
+    void generateItems();
+    // 놓을 곳이 없으면 아이템은 Map::parkedCoord()에 머물고 false 반환
+    bool generateTItem();
+    bool generateGItem();
+    bool generatePItem();
+
+    // 내장 4개 스테이지 대신 스테이지 팩을 사용 (1스테이지부터 다시 시작, nullptr이면 내장 스테이지로 복귀)
+    void setStagePack(shared_ptr<const StagePack> pack);
+    const shared_ptr<const StagePack>& getStagePack() const { return stagePack; }
+    // 스테이지마다 새로 생성한 절차적 맵으로 끝없이 진행 (wallDensity: 내부 벽 밀도 %, 0이면 내장 스테이지)
+    // 미션 목표와 속도는 내장 스테이지 곡선을 따르고 4스테이지 이후로는 4스테이지 값을 유지
+    void setProceduralStages(int wallDensity);
+    bool isEndless() const { return proceduralDensity > 0; }
+
+    void resetCurrentStage();
+    void goToNextStage();
+    void jumpToStage(int stage);
+    void completeMissionsForDebug();
+
+    // 읽기 전용 접근자 (헤드리스 실행 / 봇용)
+    const Map& getMap() const { return gameMap; }
+    int getBoardHeight() const { return boardHeight; }
+    int getBoardWidth() const { return boardWidth; }
+    int getCurrentStage() const { return currentStage; }
+    // 스테이지 수와 현재 스테이지 이름 (스테이지 팩이 없으면 내장 스테이지, 절차적 맵은 int 최댓값)
+    int getStageCount() const;
+    string getStageName() const;
+    int getGrowthItemCount() const { return growthItemCount; }
+    int getPoisonItemCount() const { return poisonItemCount; }
+    int getGatesUsedCount() const { return gatesUsedCount; }
+    int getMaxSnakeLength() const { return maxSnakeLength; }
+    int getTickCount() const { return gameTimerSeconds; }
+    int getGameSpeedDelay() const { return gameSpeedDelay; }
+    float getSpeedMultiplier() const { return speedMultiplier; }
+    // 현재 한 틱의 실제 길이 (ms, 속도 아이템 배율 반영)
+    double getTickPeriodMs() const { return gameSpeedDelay / static_cast<double>(speedMultiplier); }
+    // 이동한 틱들의 길이를 합산한 게임 내 경과 시간
+    int getElapsedSeconds() const { return static_cast<int>(elapsedMilliseconds / 1000.0); }
+    bool isStageCleared() const { return allMissionsCompleted; }
+    // 마지막 아이템 생성 시 남은 빈 셀이 없었는지 여부
+    bool isBoardFull() const { return boardFull; }
+    // 맵이 새로 만들어질 때마다 증가 (화면 계층의 전체 다시 그리기 판단용)
+    unsigned long getMapGeneration() const { return mapGeneration; }
+    // 지금 몸통을 기준으로 몸통 변경 기록을 (다시) 시작 (Map::BodyJournal, 되감기 링용)
+    void beginBodyJournal() { gameMap.beginBodyJournal(); }
+    const string& getGameOverReason() const { return gameOverReason; }
+    uint64_t getSeed() const { return rng.getSeed(); }
+
+    // 구간별 시간 측정 (nullptr이면 측정하지 않음, 소유권은 호출자)
+    void setProfiler(TickProfiler* tickProfiler) { profiler = tickProfiler; }
+
+    // 난수 생성기를 새 시드로 재설정 (다음 스테이지 초기화부터 반영)
+    void reseed(uint64_t seed) { rng.reseed(seed); }
+
+    // 전체 상태 저장 / 복원 (벽 배치가 달라 맵을 새로 만든 경우에만 getMapGeneration이 증가)
+    // withBody가 false면 state.body는 비워 둠 (되감기 링처럼 몸통 변경을 따로 추적하는 쪽용)
+    void saveState(SimulationState& state, bool withBody = true) const;
+    void loadState(const SimulationState& state);
+
+    // 스테이지별 미션 목표 관리
+    struct MissionTargets {
+        int snakeLength;
+        int growthItems;
+        int poisonItems;
+        int gateUses;
+    };
+    // 내장 스테이지의 목표
+    static MissionTargets getMissionTargets(int stage);
+    // 현재 스테이지의 목표 (스테이지 팩이면 팩에 기록된 값)
+    MissionTargets getCurrentMissionTargets() const;
+
+    static const int kFinalStage = 4;
+
+protected:
+    Rng rng;
+    TickProfiler* profiler = nullptr;
+    Map gameMap;
+    shared_ptr<const StagePack> stagePack;
+    int proceduralDensity = 0;      // 0보다 크면 절차적 스테이지
+    uint64_t layoutSeed = 0;        // 현재 절차적 맵의 생성 시드
+    int boardHeight = kDefaultBoardHeight;
+    int boardWidth = kDefaultBoardWidth;
+    int currentStage = 1;
+    int gateActiveDuration = 0;
+    int growthItemCount = 0;
+    int poisonItemCount = 0;
+    int gatesUsedCount = 0;
+    int maxSnakeLength = 3;
+    int gameTimerSeconds = 0;
+    double elapsedMilliseconds = 0;
+    int gameSpeedDelay = 200;
+    float speedMultiplier = 1;
+    int speedBoostTimer = 0;
+
+    // 아이템 타이머들을 멤버 변수로 추가
+    int growthItemTimer = 0;
+    int poisonItemTimer = 0;
+    int timeItemTimer = 0;
+
+    char missionSnakeLengthStatus = ' ';
+    char missionGrowthItemStatus = ' ';
+    char missionPoisonItemStatus = ' ';
+    char missionGateUseStatus = ' ';
+    string gameOverReason = "";
+
+    bool allMissionsCompleted = false;
+    bool boardFull = false;
+    unsigned long mapGeneration = 0;
+
+    // 화면 / 사운드 계층이 재정의하는 이벤트 훅 (기본은 아무 동작 없음)
+    virtual void onItemConsumed() {}
+    virtual void onAllStagesCleared() {}
+
+    void checkMissions();
+    void updateTimers(int &growthItemTimer, int &poisonItemTimer, int &timeItemTimer);
+    MapType getMapTypeForStage(int stage);
+    int getStageTickDelay(int stage) const;
+
+    // 안전한 벡터 접근을 위한 헬퍼 함수들
+    bool isSnakeBodySizeValid(size_t requiredSize) const;
+    void safeAddSnakeBody();
+    bool safeRemoveSnakeBody();
+};
+
+#endif
@@ -0,0 +1,90 @@
+#include "snapshot_ring.h"
+#include <algorithm>
+
+using namespace std;
+
+SnapshotRing::SnapshotRing(size_t capacity)
+    : entries(capacity > 0 ? capacity : 1)
+{
+}
+
+void SnapshotRing::clear()
+{
+    count = 0;
+    hasLast = false;
+}
+
+void SnapshotRing::restart(Simulation& sim)
+{
+    count = 0;
+    sim.saveState(last, false);
+    sim.beginBodyJournal();
+    lastGeneration = sim.getMapGeneration();
+    hasLast = true;
+}
+
+void SnapshotRing::capture(Simulation& sim)
+{
+    const Map::BodyJournal& journal = sim.getMap().getBodyJournal();
+    if (!hasLast || sim.getMapGeneration() != lastGeneration || !journal.valid) {
+        // 맵이 바뀌면 벽 배치가 달라지고, 몸통이 통째로 바뀌면 델타를 만들 수 없으므로 이전 기록과 이어 붙이지 않음
+        restart(sim);
+        return;
+    }
+
+    // 직전 캡처 이후의 몸통 변경을 되돌리는 델타: 앞쪽에 붙은 칸과 뒤쪽에 붙은 칸을 버리고,
+    // 꼬리에서 빠진 칸을 원래 순서(꼬리 쪽이 마지막)로 다시 붙인다.
+    newest = (newest + 1) % entries.size();
+    Entry& entry = entries[newest];
+    entry.previous = last;
+    entry.dropFront = journal.frontAdded;
+    entry.dropBack = journal.backAdded;
+    entry.restoreBack.assign(journal.backRemoved.rbegin(), journal.backRemoved.rend());
+    count = min(count + 1, entries.size());
+
+    sim.saveState(last, false);
+    sim.beginBodyJournal();
+}
+
+void SnapshotRing::applyBodyDelta(vector<Coord>& body, size_t dropFront, size_t dropBack,
+                                  const vector<Coord>& restoreBack)
+{
+    body.erase(body.begin(), body.begin() + static_cast<ptrdiff_t>(dropFront));
+    body.resize(body.size() - dropBack);
+    body.insert(body.end(), restoreBack.begin(), restoreBack.end());
+}
+
+int SnapshotRing::rewind(Simulation& sim, int ticks)
+{
+    const Map::BodyJournal& journal = sim.getMap().getBodyJournal();
+    if (!hasLast || ticks <= 0 || count == 0 || !journal.valid || sim.getMapGeneration() != lastGeneration) {
+        return 0;
+    }
+
+    // 마지막 캡처 상태 = 저장해 둔 몸통 밖 상태 + 지금 몸통에서 캡처 이후의 변경을 되돌린 몸통
+    // (몸통 전체는 되감기할 때 한 번만 복사)
+    SimulationState& state = current;
+    sim.saveState(state);
+    vector<Coord> body;
+    body.swap(state.body);
+    vector<Coord> restoreBack(journal.backRemoved.rbegin(), journal.backRemoved.rend());
+    applyBodyDelta(body, journal.frontAdded, journal.backAdded, restoreBack);
+
+    int rewound = 0;
+    while (rewound < ticks && count > 0) {
+        const Entry& entry = entries[newest];
+        applyBodyDelta(body, entry.dropFront, entry.dropBack, entry.restoreBack);
+        newest = (newest + entries.size() - 1) % entries.size();
+        count--;
+        rewound++;
+    }
+    state = entries[(newest + 1) % entries.size()].previous;
+    state.body.swap(body);
+
+    sim.loadState(state);
+    // 복원한 상태를 새 기준으로 삼음 (남은 항목은 그대로 이어서 되감을 수 있음)
+    sim.saveState(last, false);
+    sim.beginBodyJournal();
+    lastGeneration = sim.getMapGeneration();
+    return rewound;
+}
@@ -0,0 +1,52 @@
+#ifndef SNAPSHOT_RING_H
+#define SNAPSHOT_RING_H
+
+#include "simulation.h"
+#include <cstddef>
+#include <vector>
+
+using namespace std;
+
+// 최근 틱들의 상태를 되감기용으로 보관하는 고정 크기 링
+// 현재 상태에서 한 틱 전으로 돌아가는 역방향 델타만 저장한다.
+//   - 몸통: 앞쪽에서 버릴 개수, 뒤쪽에서 버릴 개수, 뒤에 다시 붙일 좌표 (이동 한 번이면 좌표 1개)
+//     맵의 몸통 변경 기록(Map::BodyJournal: 앞쪽 추가 / 꼬리 제거 / 꼬리 성장)에서 바로 만들므로 몸통 길이와 무관하다.
+//   - 나머지 카운터 / 타이머 / 아이템 / 게이트 / 난수 상태: 몸통을 뺀 SimulationState 그대로
+// 맵이 새로 만들어지거나(스테이지 초기화 / 이동) 몸통이 통째로 바뀌면(상태 복원) 이전 기록은 버린다.
+class SnapshotRing
+{
+public:
+    explicit SnapshotRing(size_t capacity = 300);
+
+    void clear();
+    // 매 틱 처리가 끝난 뒤 호출 (시뮬레이션의 몸통 변경 기록을 다시 시작함)
+    void capture(Simulation& sim);
+    // 최대 ticks틱 전 상태를 sim에 복원하고 실제로 되돌린 틱 수를 반환
+    int rewind(Simulation& sim, int ticks);
+
+    size_t size() const { return count; }
+    size_t capacity() const { return entries.size(); }
+
+private:
+    struct Entry {
+        SimulationState previous;      // 한 틱 전 상태 (body는 비워 둠)
+        size_t dropFront = 0;          // 현재 몸통 앞쪽에서 제거할 개수
+        size_t dropBack = 0;           // 현재 몸통 뒤쪽에서 제거할 개수
+        vector<Coord> restoreBack;     // 그 뒤에 다시 붙일 좌표
+    };
+
+    vector<Entry> entries;
+    size_t newest = 0;   // 가장 최근 항목 위치
+    size_t count = 0;
+
+    bool hasLast = false;
+    unsigned long lastGeneration = 0;
+    SimulationState last;       // 직전 캡처 상태 (body는 비워 둠)
+    SimulationState current;    // 되감기용 임시 버퍼 (할당 재사용)
+
+    void restart(Simulation& sim);
+    static void applyBodyDelta(vector<Coord>& body, size_t dropFront, size_t dropBack,
+                               const vector<Coord>& restoreBack);
+};
+
+#endif
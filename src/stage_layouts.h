@@ -0,0 +1,243 @@
+#ifndef STAGE_LAYOUTS_H
+#define STAGE_LAYOUTS_H
+
+#include "map.h"
+
+using namespace std;
+
+// 기본 크기(21x41) 보드의 내장 스테이지 벽 배치를 컴파일 시간에 만든 표
+// Map 생성자의 실행 시간 생성 결과와 같은 벽을 같은 순서(테두리 → 패턴, 중복 포함)로 담고,
+// 스네이크 시작 위치 주변 제외도 미리 적용해 둔다. 벽 순서는 게이트 후보 추첨에 쓰이므로 그대로 유지한다.
+// 표를 만드는 함수는 C++11 constexpr 제약(함수 본문 = return 한 줄)에 맞춰 삼항 연산 / 재귀로 작성.
+namespace StageLayouts {
+
+const int kHeight = 21;
+const int kWidth = 41;
+
+struct WallCell {
+    int row;
+    int col;
+    int positionType;   // Wall::wallPositionType (테두리 1~4, 내부 -1)
+};
+
+enum Pattern {
+    BASIC_PATTERN,
+    MAZE_PATTERN,
+    ISLANDS_PATTERN,
+    CROSS_PLUS_PATTERN,      // 십자 맵 짝수 회전 (+)
+    CROSS_DIAGONAL_PATTERN   // 십자 맵 홀수 회전 (×)
+};
+
+// 스네이크 시작 위치: 머리 (h/2, w/2), 몸통은 그 아래 3칸
+constexpr int kHeadRow = kHeight / 2;
+constexpr int kHeadCol = kWidth / 2;
+constexpr int kBodyLength = 3;
+
+// Map::isNearSnake와 같은 조건 (머리 / 몸통의 8방향 1칸 이내)
+constexpr bool isNearSnake(int row, int col) {
+    return row >= kHeadRow - 1 && row <= kHeadRow + kBodyLength + 1 &&
+           col >= kHeadCol - 1 && col <= kHeadCol + 1;
+}
+
+// Map::isPositionValid와 같은 조건
+constexpr bool isPositionValid(int row, int col) {
+    return row >= 1 && row < kHeight && col >= 1 && col < kWidth;
+}
+
+// 테두리 일반 벽 (initializeWalls의 행 우선 순서)
+constexpr int kTopCount = kWidth - 2;
+constexpr int kSideCount = 2 * (kHeight - 2);
+constexpr int kBorderCount = 2 * kTopCount + kSideCount;
+
+constexpr WallCell borderWall(int n) {
+    return n < kTopCount ? WallCell{1, n + 2, 1}
+         : n < kTopCount + kSideCount
+             ? WallCell{(n - kTopCount) / 2 + 2,
+                        (n - kTopCount) % 2 ? kWidth : 1,
+                        (n - kTopCount) % 2 ? 3 : 2}
+             : WallCell{kHeight, n - kTopCount - kSideCount + 2, 4};
+}
+
+// 미로: generateMazeMap의 직선 9개 (시작 행, 시작 열, 행 증가, 열 증가, 길이)
+struct Segment {
+    int row;
+    int col;
+    int rowStep;
+    int colStep;
+    int length;
+};
+
+constexpr Segment kMazeSegments[] = {
+    {2, 2, 0, 1, 5},                             // 좌상단 ㄱ자
+    {2, 6, 1, 0, 4},
+    {2, kWidth - 1, 0, -1, 5},                   // 우상단 ㄴ자
+    {2, kWidth - 5, 1, 0, 4},
+    {kHeight - 1, 2, -1, 0, 4},                  // 좌하단 └자
+    {kHeight - 4, 2, 0, 1, 4},
+    {kHeight - 1, kWidth - 1, -1, 0, 4},         // 우하단 ┐자
+    {kHeight - 4, kWidth - 1, 0, -1, 4},
+    {kHeight / 2, kWidth / 2 - 2, 0, 1, 5},      // 중앙 짧은 벽
+};
+constexpr int kMazeSegmentCount = sizeof(kMazeSegments) / sizeof(kMazeSegments[0]);
+
+constexpr int segmentTotal(int s) {
+    return s >= kMazeSegmentCount ? 0 : kMazeSegments[s].length + segmentTotal(s + 1);
+}
+
+constexpr WallCell segmentCell(int s, int n) {
+    return n < kMazeSegments[s].length
+        ? WallCell{kMazeSegments[s].row + kMazeSegments[s].rowStep * n,
+                   kMazeSegments[s].col + kMazeSegments[s].colStep * n, -1}
+        : segmentCell(s + 1, n - kMazeSegments[s].length);
+}
+
+// 섬: generateIslandsMap의 정사각형 테두리 (행 우선)
+constexpr int kIslandHalf = (kHeight < kWidth ? kHeight : kWidth) / 6;
+constexpr int kIslandSide = 2 * kIslandHalf + 1;
+constexpr int kIslandTop = kHeight / 2 - kIslandHalf;
+constexpr int kIslandLeft = kWidth / 2 - kIslandHalf;
+
+constexpr WallCell islandCell(int n) {
+    return n < kIslandSide ? WallCell{kIslandTop, kIslandLeft + n, -1}
+         : n < kIslandSide + 2 * (kIslandSide - 2)
+             ? WallCell{kIslandTop + 1 + (n - kIslandSide) / 2,
+                        kIslandLeft + ((n - kIslandSide) % 2 ? kIslandSide - 1 : 0), -1}
+             : WallCell{kIslandTop + kIslandSide - 1,
+                        kIslandLeft + n - kIslandSide - 2 * (kIslandSide - 2), -1};
+}
+
+// 십자: generateCrossMap의 i = -크기..크기 순서로 두 칸씩 번갈아
+constexpr int kCrossSize = (kHeight < kWidth ? kHeight : kWidth) / 3;
+
+constexpr WallCell crossCell(bool diagonal, int n) {
+    return n % 2 == 0
+        ? WallCell{kHeight / 2 - kCrossSize + n / 2,
+                   kWidth / 2 + (diagonal ? -kCrossSize + n / 2 : 0), -1}
+        : WallCell{kHeight / 2 + (diagonal ? -kCrossSize + n / 2 : 0),
+                   kWidth / 2 + (diagonal ? kCrossSize - n / 2 : -kCrossSize + n / 2), -1};
+}
+
+constexpr int patternCount(Pattern pattern) {
+    return pattern == MAZE_PATTERN ? segmentTotal(0)
+         : pattern == ISLANDS_PATTERN ? 4 * kIslandSide - 4
+         : pattern == BASIC_PATTERN ? 0
+         : 2 * (2 * kCrossSize + 1);
+}
+
+constexpr WallCell patternCell(Pattern pattern, int n) {
+    return pattern == MAZE_PATTERN ? segmentCell(0, n)
+         : pattern == ISLANDS_PATTERN ? islandCell(n)
+         : crossCell(pattern == CROSS_DIAGONAL_PATTERN, n);
+}
+
+// 제외 전 후보 전체 (테두리 → 패턴)
+constexpr int rawCount(Pattern pattern) { return kBorderCount + patternCount(pattern); }
+
+constexpr WallCell rawCell(Pattern pattern, int n) {
+    return n < kBorderCount ? borderWall(n) : patternCell(pattern, n - kBorderCount);
+}
+
+// 테두리는 스네이크 주변 제외만, 패턴 벽은 범위 검사도 함께 (생성자와 같은 필터)
+constexpr bool isKept(Pattern pattern, int n) {
+    return n < kBorderCount
+        ? !isNearSnake(rawCell(pattern, n).row, rawCell(pattern, n).col)
+        : isPositionValid(rawCell(pattern, n).row, rawCell(pattern, n).col) &&
+          !isNearSnake(rawCell(pattern, n).row, rawCell(pattern, n).col);
+}
+
+constexpr int keptCount(Pattern pattern, int n) {
+    return n >= rawCount(pattern) ? 0 : (isKept(pattern, n) ? 1 : 0) + keptCount(pattern, n + 1);
+}
+
+// 남는 벽 중 k번째의 후보 번호
+constexpr int keptIndex(Pattern pattern, int k, int n) {
+    return isKept(pattern, n) ? (k == 0 ? n : keptIndex(pattern, k - 1, n + 1))
+                              : keptIndex(pattern, k, n + 1);
+}
+
+constexpr WallCell keptCell(Pattern pattern, int k) {
+    return rawCell(pattern, keptIndex(pattern, k, 0));
+}
+
+// C++11에는 std::index_sequence가 없으므로 직접 정의
+template <int... I>
+struct IndexSequence {};
+
+template <int N, int... I>
+struct MakeIndexSequence : MakeIndexSequence<N - 1, N - 1, I...> {};
+
+template <int... I>
+struct MakeIndexSequence<0, I...> {
+    typedef IndexSequence<I...> type;
+};
+
+template <Pattern P, typename Sequence = typename MakeIndexSequence<keptCount(P, 0)>::type>
+struct Table;
+
+template <Pattern P, int... I>
+struct Table<P, IndexSequence<I...>> {
+    static constexpr int count = sizeof...(I);
+    static constexpr WallCell walls[sizeof...(I)] = {keptCell(P, I)...};
+};
+
+template <Pattern P, int... I>
+constexpr int Table<P, IndexSequence<I...>>::count;
+
+template <Pattern P, int... I>
+constexpr WallCell Table<P, IndexSequence<I...>>::walls[sizeof...(I)];
+
+// 네 모서리의 무적 벽 (initializeWalls 순서)
+constexpr WallCell kImmuneWalls[] = {
+    {1, 1, -1}, {1, kWidth, -1}, {kHeight, 1, -1}, {kHeight, kWidth, -1},
+};
+constexpr int kImmuneWallCount = sizeof(kImmuneWalls) / sizeof(kImmuneWalls[0]);
+
+static_assert(Table<BASIC_PATTERN>::count == kBorderCount, "snake start must not touch the border");
+
+const int kPatternCount = 5;
+
+struct Layout {
+    Pattern pattern;
+    MapType type;
+    const WallCell* walls;
+    int count;
+};
+
+inline Layout layoutOf(Pattern pattern)
+{
+    switch (pattern) {
+        case MAZE_PATTERN:
+            return {pattern, MapType::MAZE, Table<MAZE_PATTERN>::walls, Table<MAZE_PATTERN>::count};
+        case ISLANDS_PATTERN:
+            return {pattern, MapType::ISLANDS, Table<ISLANDS_PATTERN>::walls, Table<ISLANDS_PATTERN>::count};
+        case CROSS_PLUS_PATTERN:
+            return {pattern, MapType::CROSS, Table<CROSS_PLUS_PATTERN>::walls, Table<CROSS_PLUS_PATTERN>::count};
+        case CROSS_DIAGONAL_PATTERN:
+            return {pattern, MapType::CROSS, Table<CROSS_DIAGONAL_PATTERN>::walls, Table<CROSS_DIAGONAL_PATTERN>::count};
+        default:
+            return {BASIC_PATTERN, MapType::BASIC, Table<BASIC_PATTERN>::walls, Table<BASIC_PATTERN>::count};
+    }
+}
+
+// 기본 크기 보드의 맵 종류 / 스테이지에 해당하는 표 (다른 크기면 false → 실행 시간 생성)
+inline bool findLayout(int height, int width, MapType type, int stage, Layout& out)
+{
+    if (height != kHeight || width != kWidth) return false;
+    switch (type) {
+        case MapType::BASIC: out = layoutOf(BASIC_PATTERN); return true;
+        case MapType::MAZE: out = layoutOf(MAZE_PATTERN); return true;
+        case MapType::ISLANDS: out = layoutOf(ISLANDS_PATTERN); return true;
+        case MapType::CROSS:
+            // generateCrossMap(rotation = (stage - 1) % 4): 짝수 회전은 +, 홀수 회전은 ×
+            out = layoutOf(((stage - 1) % 4) % 2 == 0 ? CROSS_PLUS_PATTERN : CROSS_DIAGONAL_PATTERN);
+            return true;
+        case MapType::CUSTOM:
+        case MapType::PROCEDURAL:
+            return false;
+    }
+    return false;
+}
+
+} // namespace StageLayouts
+
+#endif
@@ -0,0 +1,369 @@
+#include "stage_pack.h"
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+
+const char kPackMagic[8] = {'S', 'N', 'K', 'S', 'T', 'G', 'P', '\0'};
+const uint32_t kPackVersion = 1;
+
+uint64_t alignUp(uint64_t value)
+{
+    return (value + 7) & ~static_cast<uint64_t>(7);
+}
+
+runtime_error stageError(const string& source, int line, const string& message)
+{
+    return runtime_error(source + ":" + to_string(line) + ": " + message);
+}
+
+// 경로에서 디렉터리와 확장자를 뺀 이름
+string baseName(const string& path)
+{
+    size_t slash = path.find_last_of('/');
+    string name = slash == string::npos ? path : path.substr(slash + 1);
+    size_t dot = name.find_last_of('.');
+    return dot == string::npos || dot == 0 ? name : name.substr(0, dot);
+}
+
+template <typename T>
+void appendRecords(vector<char>& block, const T* records, size_t count)
+{
+    block.resize(alignUp(block.size()), 0);
+    const char* bytes = reinterpret_cast<const char*>(records);
+    block.insert(block.end(), bytes, bytes + count * sizeof(T));
+}
+
+// 매핑한 스테이지의 내용 검증: Map(const StageView&)와 시뮬레이션이 그대로 믿고 쓰는 값들
+// (셀 종류, 벽 좌표와 그 칸의 셀, 게이트 후보 인덱스, 스폰과 몸통 칸, 틱 간격)
+bool stageContentValid(const StageView& view)
+{
+    const StageHeader& header = *view.header;
+    const int h = header.height;
+    const int w = header.width;
+    const size_t gridCols = static_cast<size_t>(w) + 2;
+    const size_t cellCount = (static_cast<size_t>(h) + 2) * gridCols;
+    const unsigned char maxCell = static_cast<unsigned char>(CellType::IMMUNE_WALL);
+    auto cellAt = [&](int row, int col) { return view.cells[static_cast<size_t>(row) * gridCols + col]; };
+    auto inBoard = [&](int row, int col) { return row >= 1 && row <= h && col >= 1 && col <= w; };
+
+    if (header.tickDelay < 10 || header.tickDelay > 5000) return false;
+    for (size_t i = 0; i < cellCount; ++i) {
+        if (view.cells[i] > maxCell) return false;
+    }
+    for (int i = 0; i < header.regularWallCount; ++i) {
+        const StageWallRecord& wall = view.walls[i];
+        int type = wall.positionType;
+        if (!inBoard(wall.row, wall.col) || cellAt(wall.row, wall.col) != static_cast<unsigned char>(CellType::WALL) ||
+            !(type == -1 || (type >= 1 && type <= 4))) {
+            return false;
+        }
+    }
+    for (int i = 0; i < header.immuneWallCount; ++i) {
+        const StageCoordRecord& wall = view.immuneWalls[i];
+        if (!inBoard(wall.row, wall.col) ||
+            cellAt(wall.row, wall.col) != static_cast<unsigned char>(CellType::IMMUNE_WALL)) {
+            return false;
+        }
+    }
+    for (int i = 0; i < header.gateHintCount; ++i) {
+        if (view.gateHints[i] < 0 || view.gateHints[i] >= header.regularWallCount) return false;
+    }
+    for (int i = 0; i <= 3; ++i) {
+        if (cellAt(header.spawnRow + i, header.spawnCol) != static_cast<unsigned char>(CellType::EMPTY)) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+StageSource parseStageText(istream& in, const string& sourceName)
+{
+    StageSource stage;
+    stage.name = baseName(sourceName);
+
+    vector<pair<int, string>> rows;   // (줄 번호, 격자 줄)
+    bool inGrid = false;
+    string line;
+    int lineNumber = 0;
+    while (getline(in, line)) {
+        ++lineNumber;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (inGrid) {
+            if (!line.empty()) rows.emplace_back(lineNumber, line);
+            continue;
+        }
+        if (line.empty() || line[0] == ';') continue;
+
+        istringstream words(line);
+        string key;
+        words >> key;
+        if (key == "name") {
+            getline(words >> ws, stage.name);
+        } else if (key == "missions") {
+            if (!(words >> stage.snakeLength >> stage.growthItems >> stage.poisonItems >> stage.gateUses) ||
+                stage.snakeLength < 0 || stage.growthItems < 0 || stage.poisonItems < 0 || stage.gateUses < 0) {
+                throw stageError(sourceName, lineNumber, "missions needs 4 non-negative numbers");
+            }
+        } else if (key == "delay") {
+            if (!(words >> stage.tickDelay) || stage.tickDelay < 10 || stage.tickDelay > 5000) {
+                throw stageError(sourceName, lineNumber, "delay must be between 10 and 5000 ms");
+            }
+        } else if (key == "map") {
+            inGrid = true;
+        } else {
+            throw stageError(sourceName, lineNumber, "unknown keyword '" + key + "'");
+        }
+    }
+    if (rows.empty()) throw stageError(sourceName, lineNumber, "missing map grid");
+    if (stage.name.empty() || stage.name.size() >= static_cast<size_t>(kStageNameLength)) {
+        throw stageError(sourceName, 1, "name must be 1.." + to_string(kStageNameLength - 1) + " bytes");
+    }
+
+    const int h = static_cast<int>(rows.size());
+    const int w = static_cast<int>(rows[0].second.size());
+    if (h < kMinStageSize || w < kMinStageSize || h > kMaxStageSize || w > kMaxStageSize) {
+        throw stageError(sourceName, rows[0].first, "map size must be between " + to_string(kMinStageSize) +
+                         " and " + to_string(kMaxStageSize));
+    }
+    stage.height = h;
+    stage.width = w;
+    const int gridCols = w + 2;
+    stage.cells.assign(static_cast<size_t>(h + 2) * gridCols, static_cast<unsigned char>(CellType::EMPTY));
+
+    bool hasSpawn = false;
+    for (int r = 1; r <= h; ++r) {
+        const string& row = rows[static_cast<size_t>(r - 1)].second;
+        int rowLine = rows[static_cast<size_t>(r - 1)].first;
+        if (static_cast<int>(row.size()) != w) {
+            throw stageError(sourceName, rowLine, "map rows must all be " + to_string(w) + " wide");
+        }
+        for (int c = 1; c <= w; ++c) {
+            char ch = row[static_cast<size_t>(c - 1)];
+            bool border = r == 1 || r == h || c == 1 || c == w;
+            unsigned char& cell = stage.cells[static_cast<size_t>(r) * gridCols + c];
+            switch (ch) {
+                case '#':
+                case 'G': {
+                    int positionType = r == 1 ? 1 : r == h ? 4 : c == 1 ? 2 : c == w ? 3 : -1;
+                    if (ch == 'G') stage.gateHints.push_back(static_cast<int32_t>(stage.walls.size()));
+                    stage.walls.push_back({r, c, positionType});
+                    cell = static_cast<unsigned char>(CellType::WALL);
+                    break;
+                }
+                case 'X':
+                    stage.immuneWalls.push_back({r, c});
+                    cell = static_cast<unsigned char>(CellType::IMMUNE_WALL);
+                    break;
+                case '@':
+                    if (hasSpawn) throw stageError(sourceName, rowLine, "more than one snake spawn '@'");
+                    hasSpawn = true;
+                    stage.spawn = {r, c};
+                    // fallthrough
+                case '.':
+                    if (border) throw stageError(sourceName, rowLine, "the outer border must be walls");
+                    break;
+                default:
+                    throw stageError(sourceName, rowLine, string("unknown map character '") + ch + "'");
+            }
+        }
+    }
+
+    int gridLine = rows[0].first;
+    if (!hasSpawn) throw stageError(sourceName, gridLine, "missing snake spawn '@'");
+    for (int i = 1; i <= 3; ++i) {
+        int row = stage.spawn.row + i;
+        if (row > h || stage.cells[static_cast<size_t>(row) * gridCols + stage.spawn.col] !=
+                           static_cast<unsigned char>(CellType::EMPTY)) {
+            throw stageError(sourceName, rows[static_cast<size_t>(stage.spawn.row - 1)].first,
+                             "the 3 cells below the spawn must be empty (snake body)");
+        }
+    }
+    if (stage.walls.size() < 2) throw stageError(sourceName, gridLine, "at least 2 walls are needed for gates");
+
+    const int dr[4] = {-1, 1, 0, 0};
+    const int dc[4] = {0, 0, -1, 1};
+    for (int32_t hint : stage.gateHints) {
+        const StageWallRecord& wall = stage.walls[static_cast<size_t>(hint)];
+        bool open = false;
+        for (int d = 0; d < 4; ++d) {
+            int row = wall.row + dr[d];
+            int col = wall.col + dc[d];
+            if (row >= 1 && row <= h && col >= 1 && col <= w &&
+                stage.cells[static_cast<size_t>(row) * gridCols + col] == static_cast<unsigned char>(CellType::EMPTY)) {
+                open = true;
+            }
+        }
+        if (!open) {
+            throw stageError(sourceName, rows[static_cast<size_t>(wall.row - 1)].first,
+                             "gate hint 'G' at column " + to_string(wall.col) + " has no open side");
+        }
+    }
+    return stage;
+}
+
+void writeStagePack(const string& path, const vector<StageSource>& stages)
+{
+    vector<vector<char>> blocks;
+    blocks.reserve(stages.size());
+    for (const StageSource& source : stages) {
+        StageHeader header;
+        memset(&header, 0, sizeof(header));
+        strncpy(header.name, source.name.c_str(), kStageNameLength - 1);
+        header.height = source.height;
+        header.width = source.width;
+        header.spawnRow = source.spawn.row;
+        header.spawnCol = source.spawn.col;
+        header.snakeLength = source.snakeLength;
+        header.growthItems = source.growthItems;
+        header.poisonItems = source.poisonItems;
+        header.gateUses = source.gateUses;
+        header.tickDelay = source.tickDelay;
+        header.regularWallCount = static_cast<int32_t>(source.walls.size());
+        header.immuneWallCount = static_cast<int32_t>(source.immuneWalls.size());
+        header.gateHintCount = static_cast<int32_t>(source.gateHints.size());
+
+        vector<char> block(sizeof(StageHeader), 0);
+        header.cellsOffset = alignUp(block.size());
+        appendRecords(block, source.cells.data(), source.cells.size());
+        header.wallsOffset = alignUp(block.size());
+        appendRecords(block, source.walls.data(), source.walls.size());
+        header.immuneOffset = alignUp(block.size());
+        appendRecords(block, source.immuneWalls.data(), source.immuneWalls.size());
+        header.hintsOffset = alignUp(block.size());
+        appendRecords(block, source.gateHints.data(), source.gateHints.size());
+        block.resize(alignUp(block.size()), 0);
+        memcpy(block.data(), &header, sizeof(header));
+        blocks.push_back(move(block));
+    }
+
+    StagePackHeader packHeader;
+    memcpy(packHeader.magic, kPackMagic, sizeof(kPackMagic));
+    packHeader.version = kPackVersion;
+    packHeader.stageCount = static_cast<uint32_t>(stages.size());
+    vector<StagePackEntry> entries(stages.size());
+    uint64_t offset = alignUp(sizeof(StagePackHeader) + entries.size() * sizeof(StagePackEntry));
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        entries[i].offset = offset;
+        entries[i].size = blocks[i].size();
+        offset += blocks[i].size();
+    }
+
+    ofstream out(path, ios::binary | ios::trunc);
+    if (!out) throw runtime_error("Cannot write stage pack: " + path);
+    out.write(reinterpret_cast<const char*>(&packHeader), sizeof(packHeader));
+    out.write(reinterpret_cast<const char*>(entries.data()),
+              static_cast<streamsize>(entries.size() * sizeof(StagePackEntry)));
+    uint64_t written = sizeof(StagePackHeader) + entries.size() * sizeof(StagePackEntry);
+    vector<char> padding(alignUp(written) - written, 0);
+    out.write(padding.data(), static_cast<streamsize>(padding.size()));
+    for (const auto& block : blocks) {
+        out.write(block.data(), static_cast<streamsize>(block.size()));
+    }
+    if (!out) throw runtime_error("Cannot write stage pack: " + path);
+}
+
+StagePack::StagePack(const string& path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw runtime_error("Cannot open stage pack: " + path);
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(StagePackHeader))) {
+        close(fd);
+        throw runtime_error("Not a stage pack: " + path);
+    }
+    mappingSize = static_cast<size_t>(info.st_size);
+    // 읽기 전용 공유 매핑: 같은 팩을 연 프로세스들이 페이지 캐시를 함께 사용
+    void* address = mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) throw runtime_error("Cannot map stage pack: " + path);
+    mapping = address;
+
+    try {
+        indexStages(path);
+    } catch (...) {
+        munmap(mapping, mappingSize);
+        throw;
+    }
+    prototypes.resize(stages.size());
+    prototypeOnce.reset(new once_flag[stages.size()]);
+}
+
+StagePack::~StagePack()
+{
+    if (mapping) munmap(mapping, mappingSize);
+}
+
+void StagePack::indexStages(const string& path)
+{
+    // 헤더 / 색인 / 각 블록의 범위를 확인한 뒤 스테이지 내용을 검증 (셀은 바이트 단위로 한 번 훑기만 하고 복사하지 않음)
+    // 손상된 팩은 여기서 runtime_error로 거부하므로 이후 Map(const StageView&)는 검증된 값만 받음
+    const char* base = static_cast<const char*>(mapping);
+    const StagePackHeader* packHeader = reinterpret_cast<const StagePackHeader*>(base);
+    if (memcmp(packHeader->magic, kPackMagic, sizeof(kPackMagic)) != 0 || packHeader->version != kPackVersion) {
+        throw runtime_error("Not a stage pack (or unsupported version): " + path);
+    }
+    uint64_t indexEnd = sizeof(StagePackHeader) + static_cast<uint64_t>(packHeader->stageCount) * sizeof(StagePackEntry);
+    if (packHeader->stageCount == 0 || indexEnd > mappingSize) {
+        throw runtime_error("Corrupt stage pack index: " + path);
+    }
+    const StagePackEntry* entries = reinterpret_cast<const StagePackEntry*>(base + sizeof(StagePackHeader));
+
+    for (uint32_t i = 0; i < packHeader->stageCount; ++i) {
+        const StagePackEntry& entry = entries[i];
+        string where = path + " stage " + to_string(i + 1);
+        if (entry.offset % 8 != 0 || entry.offset > mappingSize || entry.size > mappingSize - entry.offset ||
+            entry.size < sizeof(StageHeader)) {
+            throw runtime_error("Corrupt stage block: " + where);
+        }
+        const char* block = base + entry.offset;
+        const StageHeader* header = reinterpret_cast<const StageHeader*>(block);
+        auto fits = [&](uint64_t offset, uint64_t bytes, uint64_t alignment) {
+            return offset % alignment == 0 && offset <= entry.size && bytes <= entry.size - offset;
+        };
+        bool valid = memchr(header->name, '\0', kStageNameLength) != nullptr &&
+                     header->height >= kMinStageSize && header->height <= kMaxStageSize &&
+                     header->width >= kMinStageSize && header->width <= kMaxStageSize &&
+                     header->spawnRow >= 1 && header->spawnRow + 3 <= header->height &&
+                     header->spawnCol >= 1 && header->spawnCol <= header->width &&
+                     header->regularWallCount >= 2 && header->immuneWallCount >= 0 && header->gateHintCount >= 0;
+        if (valid) {
+            uint64_t cellCount = static_cast<uint64_t>(header->height + 2) * static_cast<uint64_t>(header->width + 2);
+            valid = fits(header->cellsOffset, cellCount, 1) &&
+                    fits(header->wallsOffset, static_cast<uint64_t>(header->regularWallCount) * sizeof(StageWallRecord), 4) &&
+                    fits(header->immuneOffset, static_cast<uint64_t>(header->immuneWallCount) * sizeof(StageCoordRecord), 4) &&
+                    fits(header->hintsOffset, static_cast<uint64_t>(header->gateHintCount) * sizeof(int32_t), 4);
+        }
+        if (!valid) throw runtime_error("Corrupt stage header: " + where);
+
+        StageView view;
+        view.header = header;
+        view.cells = reinterpret_cast<const unsigned char*>(block + header->cellsOffset);
+        view.walls = reinterpret_cast<const StageWallRecord*>(block + header->wallsOffset);
+        view.immuneWalls = reinterpret_cast<const StageCoordRecord*>(block + header->immuneOffset);
+        view.gateHints = reinterpret_cast<const int32_t*>(block + header->hintsOffset);
+        if (!stageContentValid(view)) throw runtime_error("Corrupt stage data: " + where);
+        stages.push_back(view);
+    }
+}
+
+string StagePack::stageName(int index) const
+{
+    const char* name = stage(index).header->name;
+    return string(name, strnlen(name, kStageNameLength));
+}
+
+const Map& StagePack::prototype(int index) const
+{
+    size_t i = static_cast<size_t>(index);
+    call_once(prototypeOnce[i], [&]() { prototypes[i].reset(new Map(stages[i])); });
+    return *prototypes[i];
+}
@@ -0,0 +1,137 @@
+#ifndef STAGE_PACK_H
+#define STAGE_PACK_H
+
+#include "map.h"
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// 커스텀 스테이지 파일
+// 스테이지는 텍스트(.stage)로 작성하고 tools/mapc로 여러 개를 하나의 바이너리 팩(.stgp)으로 컴파일한다.
+// 팩은 mmap으로 읽기 전용 매핑하고 셀 격자를 Map의 정적 층으로 그대로 쓰므로, 스테이지를 다시 시작해도
+// 파싱이 없고 같은 팩을 연 프로세스들은 같은 페이지를 공유한다.
+//
+// 텍스트 형식 (';'로 시작하는 줄은 주석):
+//   name 나선형           스테이지 이름 (생략 시 파일 이름)
+//   missions 10 5 2 2     미션 목표: 길이, +아이템, -아이템, 게이트 (생략 시 5 3 1 1)
+//   delay 180             틱 간격 ms (생략 시 200)
+//   map                   이후 줄은 모두 격자 (직사각형, 바깥 테두리는 벽)
+//   #######
+//   #..@..#               '#' 벽, 'X' 무적벽, 'G' 게이트 우선 후보 벽, '.' 빈 칸,
+//   #.....#               '@' 스네이크 머리 (몸통 3칸은 그 아래에 놓임)
+//   ...
+
+const int kMinStageSize = 5;
+const int kMaxStageSize = 16384;
+const int kStageNameLength = 32;
+
+// ---- 디스크 형식 (리틀 엔디언, 모든 블록은 8바이트 정렬) ----
+
+struct StagePackHeader {
+    char magic[8];          // "SNKSTGP"
+    uint32_t version;
+    uint32_t stageCount;
+    // 이어서 StagePackEntry * stageCount
+};
+
+struct StagePackEntry {
+    uint64_t offset;        // 팩 시작 기준 스테이지 블록 위치
+    uint64_t size;
+};
+
+struct StageHeader {
+    char name[kStageNameLength];
+    int32_t height;         // Map::mapSize (테두리 벽 포함)
+    int32_t width;
+    int32_t spawnRow;
+    int32_t spawnCol;
+    int32_t snakeLength;    // 미션 목표
+    int32_t growthItems;
+    int32_t poisonItems;
+    int32_t gateUses;
+    int32_t tickDelay;      // ms
+    int32_t regularWallCount;
+    int32_t immuneWallCount;
+    int32_t gateHintCount;
+    // 스테이지 블록 시작 기준 위치
+    uint64_t cellsOffset;   // uint8 CellType * (height + 2) * (width + 2), 행 우선
+    uint64_t wallsOffset;   // StageWallRecord * regularWallCount (행 우선, Map::regularWalls 순서)
+    uint64_t immuneOffset;  // StageCoordRecord * immuneWallCount
+    uint64_t hintsOffset;   // int32 * gateHintCount (regularWalls 인덱스)
+};
+
+struct StageWallRecord {
+    int32_t row;
+    int32_t col;
+    int32_t positionType;   // Wall::wallPositionType
+};
+
+struct StageCoordRecord {
+    int32_t row;
+    int32_t col;
+};
+
+// 매핑된 팩 안의 스테이지 하나 (포인터는 팩이 살아 있는 동안 유효)
+struct StageView {
+    const StageHeader* header = nullptr;
+    const unsigned char* cells = nullptr;
+    const StageWallRecord* walls = nullptr;
+    const StageCoordRecord* immuneWalls = nullptr;
+    const int32_t* gateHints = nullptr;
+};
+
+// 텍스트에서 읽은 스테이지 (팩으로 쓰기 전 단계)
+struct StageSource {
+    string name;
+    int height = 0;
+    int width = 0;
+    Coord spawn{0, 0};
+    int snakeLength = 5;
+    int growthItems = 3;
+    int poisonItems = 1;
+    int gateUses = 1;
+    int tickDelay = 200;
+    vector<unsigned char> cells;
+    vector<StageWallRecord> walls;
+    vector<StageCoordRecord> immuneWalls;
+    vector<int32_t> gateHints;
+};
+
+// 텍스트 스테이지를 읽고 검증 (오류 시 "원본:줄: 내용" 형식의 runtime_error)
+StageSource parseStageText(istream& in, const string& sourceName);
+// 스테이지들을 순서대로 하나의 팩 파일로 기록
+void writeStagePack(const string& path, const vector<StageSource>& stages);
+
+// 읽기 전용으로 매핑한 스테이지 팩
+class StagePack
+{
+public:
+    explicit StagePack(const string& path);
+    ~StagePack();
+    StagePack(const StagePack&) = delete;
+    StagePack& operator=(const StagePack&) = delete;
+
+    int size() const { return static_cast<int>(stages.size()); }
+    // index는 0부터 (스테이지 번호 - 1)
+    const StageView& stage(int index) const { return stages[static_cast<size_t>(index)]; }
+    string stageName(int index) const;
+
+    // 스테이지별로 처음 요청될 때 한 번 만든 맵 (스테이지 초기화는 이 맵을 복사, 여러 스레드에서 호출 가능)
+    const Map& prototype(int index) const;
+
+private:
+    void* mapping = nullptr;
+    size_t mappingSize = 0;
+    vector<StageView> stages;
+    mutable vector<unique_ptr<Map>> prototypes;
+    mutable unique_ptr<once_flag[]> prototypeOnce;
+
+    void indexStages(const string& path);
+};
+
+#endif
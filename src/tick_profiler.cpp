@@ -0,0 +1,146 @@
+#include "tick_profiler.h"
+#include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+
+using namespace std;
+
+namespace {
+
+volatile sig_atomic_t dumpRequested = 0;
+
+void onDumpSignal(int)
+{
+    dumpRequested = 1;
+}
+
+int highestBit(uint64_t value)
+{
+    int bit = 0;
+    while (value >>= 1) bit++;
+    return bit;
+}
+
+} // namespace
+
+const char* tickPhaseName(TickPhase phase)
+{
+    switch (phase) {
+        case TickPhase::INPUT: return "input";
+        case TickPhase::SIMULATION: return "simulation";
+        case TickPhase::COLLISION: return "collision";
+        case TickPhase::ITEM_RESPAWN: return "item_respawn";
+        case TickPhase::DRAW: return "draw";
+        case TickPhase::FLUSH: return "flush";
+        default: return "?";
+    }
+}
+
+int LatencyHistogram::bucketIndex(uint64_t ns)
+{
+    // 0..15는 그대로, 그 이상은 (최상위 비트 위치, 그 아래 4비트)로 칸을 정함
+    if (ns < static_cast<uint64_t>(kSubBuckets)) return static_cast<int>(ns);
+    int exponent = highestBit(ns);
+    int shift = exponent - kSubBucketBits;
+    int sub = static_cast<int>((ns >> shift) & (kSubBuckets - 1));
+    return (shift + 1) * kSubBuckets + sub;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(int index)
+{
+    if (index < kSubBuckets) return static_cast<uint64_t>(index);
+    int shift = index / kSubBuckets - 1;
+    uint64_t sub = static_cast<uint64_t>(index % kSubBuckets);
+    uint64_t lower = (static_cast<uint64_t>(kSubBuckets) + sub) << shift;
+    return lower + ((uint64_t(1) << shift) - 1);
+}
+
+void LatencyHistogram::record(uint64_t ns)
+{
+    buckets[bucketIndex(ns)]++;
+    total++;
+    sumValue += ns;
+    if (ns > maxValue) maxValue = ns;
+}
+
+void LatencyHistogram::clear()
+{
+    fill(buckets, buckets + kBucketCount, 0);
+    total = 0;
+    maxValue = 0;
+    sumValue = 0;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+    for (int i = 0; i < kBucketCount; ++i) buckets[i] += other.buckets[i];
+    total += other.total;
+    sumValue += other.sumValue;
+    if (other.maxValue > maxValue) maxValue = other.maxValue;
+}
+
+uint64_t LatencyHistogram::percentile(double p) const
+{
+    if (total == 0) return 0;
+    p = max(0.0, min(1.0, p));
+    uint64_t rank = static_cast<uint64_t>(p * static_cast<double>(total - 1)) + 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < kBucketCount; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) return min(bucketUpperBound(i), maxValue);
+    }
+    return maxValue;
+}
+
+TickProfiler::TickProfiler(const string& reportPath)
+    : reportPath(reportPath)
+{
+}
+
+void TickProfiler::clear()
+{
+    for (auto& histogram : histograms) histogram.clear();
+}
+
+void TickProfiler::printReport(ostream& out) const
+{
+    char line[160];
+    snprintf(line, sizeof(line), "%-14s %10s %12s %12s %12s %14s\n",
+             "phase", "count", "p50(us)", "p99(us)", "max(us)", "total(ms)");
+    out << line;
+    for (int i = 0; i < static_cast<int>(TickPhase::COUNT); ++i) {
+        const LatencyHistogram& h = histograms[i];
+        snprintf(line, sizeof(line), "%-14s %10llu %12.1f %12.1f %12.1f %14.1f\n",
+                 tickPhaseName(static_cast<TickPhase>(i)),
+                 static_cast<unsigned long long>(h.count()),
+                 h.percentile(0.50) / 1e3, h.percentile(0.99) / 1e3,
+                 h.maximum() / 1e3, h.sum() / 1e6);
+        out << line;
+    }
+}
+
+bool TickProfiler::writeReport() const
+{
+    if (reportPath.empty()) return false;
+    ofstream out(reportPath, ios::trunc);
+    if (!out) return false;
+    printReport(out);
+    return static_cast<bool>(out);
+}
+
+void TickProfiler::installDumpSignal()
+{
+    struct sigaction action = {};
+    action.sa_handler = onDumpSignal;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGUSR1, &action, nullptr);
+}
+
+bool TickProfiler::consumeDumpRequest()
+{
+    if (!dumpRequested) return false;
+    dumpRequested = 0;
+    return true;
+}
@@ -0,0 +1,113 @@
+#ifndef TICK_PROFILER_H
+#define TICK_PROFILER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+// 틱 루프의 구간 (게임 화면 루프와 Simulation::tick 내부)
+enum class TickPhase {
+    INPUT,          // getch + processInput
+    SIMULATION,     // update (아래 구간 제외)
+    COLLISION,      // isValid
+    ITEM_RESPAWN,   // generateRandCoord
+    DRAW,           // 보드 / 점수판 / 미션판 그리기
+    FLUSH,          // doupdate (터미널 출력)
+    COUNT
+};
+
+const char* tickPhaseName(TickPhase phase);
+
+// 로그-선형 히스토그램 (ns 단위)
+// 2의 거듭제곱 구간마다 16개의 균등 칸을 두어 상대 오차 6.25% 이내로 기록한다. 기록은 O(1), 할당 없음.
+class LatencyHistogram
+{
+public:
+    void record(uint64_t ns);
+    void clear();
+    // 다른 히스토그램의 기록을 모두 더함
+    void merge(const LatencyHistogram& other);
+
+    uint64_t count() const { return total; }
+    uint64_t maximum() const { return maxValue; }
+    uint64_t sum() const { return sumValue; }
+    // p(0~1) 분위수: 해당 칸의 상한값 (최대값을 넘지 않음)
+    uint64_t percentile(double p) const;
+
+    static const int kSubBucketBits = 4;
+    static const int kSubBuckets = 1 << kSubBucketBits;
+    static const int kBucketCount = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+private:
+    uint64_t buckets[kBucketCount] = {};
+    uint64_t total = 0;
+    uint64_t maxValue = 0;
+    uint64_t sumValue = 0;
+
+    static int bucketIndex(uint64_t ns);
+    static uint64_t bucketUpperBound(int index);
+};
+
+// 구간별 히스토그램 묶음
+// 구간은 중첩될 수 있으며 바깥 구간에는 안쪽 구간을 뺀 자기 시간만 기록된다
+// (예: SIMULATION 안에서 호출된 isValid 시간은 COLLISION으로만 집계).
+class TickProfiler
+{
+public:
+    explicit TickProfiler(const string& reportPath = "");
+
+    void record(TickPhase phase, uint64_t ns) { histograms[static_cast<int>(phase)].record(ns); }
+    const LatencyHistogram& histogram(TickPhase phase) const { return histograms[static_cast<int>(phase)]; }
+    void clear();
+
+    void printReport(ostream& out) const;
+    // 생성 시 받은 경로에 보고서를 덮어씀 (경로가 비어 있으면 무시)
+    bool writeReport() const;
+
+    // SIGUSR1을 받으면 보고서 요청 플래그를 세움 (시그널 처리기에서는 플래그만 설정)
+    static void installDumpSignal();
+    // 요청이 있었으면 플래그를 지우고 true
+    static bool consumeDumpRequest();
+
+private:
+    friend class ProfileScope;
+
+    string reportPath;
+    LatencyHistogram histograms[static_cast<int>(TickPhase::COUNT)];
+    uint64_t nestedNs = 0;   // 현재 열린 구간 안에서 끝난 하위 구간 시간 합
+};
+
+// 구간 측정용 RAII 타이머 (profiler가 nullptr이면 아무것도 하지 않음)
+class ProfileScope
+{
+public:
+    ProfileScope(TickProfiler* profiler, TickPhase phase) : profiler(profiler), phase(phase) {
+        if (!profiler) return;
+        outerNestedNs = profiler->nestedNs;
+        profiler->nestedNs = 0;
+        start = chrono::steady_clock::now();
+    }
+    ~ProfileScope() {
+        if (!profiler) return;
+        uint64_t elapsed = static_cast<uint64_t>(
+            chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+        uint64_t inner = profiler->nestedNs;
+        profiler->record(phase, elapsed > inner ? elapsed - inner : 0);
+        profiler->nestedNs = outerNestedNs + elapsed;
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    TickProfiler* profiler;
+    TickPhase phase;
+    uint64_t outerNestedNs = 0;
+    chrono::steady_clock::time_point start;
+};
+
+#endif
@@ -0,0 +1,283 @@
+#include "tick_server.h"
+#include <algorithm>
+#include <poll.h>
+#include <unistd.h>
+
+using namespace std;
+
+TickServer::TickServer(const TickServerOptions& serverOptions)
+    : options(serverOptions)
+    , arena(serverOptions.arena)
+{
+    humanControlled.assign(arena.size(), 0);
+    actions.assign(arena.size(), 0);
+    listenFd = openListener(options.address);
+}
+
+TickServer::~TickServer()
+{
+    clients.clear();
+    if (listenFd >= 0) close(listenFd);
+    if (options.address.unixSocket) unlink(options.address.path.c_str());
+}
+
+void TickServer::run(const volatile sig_atomic_t* stopFlag)
+{
+    bool started = false;
+    Clock::time_point deadline = Clock::now();
+    while (!(stopFlag && *stopFlag) && (options.maxTicks <= 0 || arena.getTickCount() < options.maxTicks)) {
+        if (!started) {
+            if (static_cast<int>(clients.size()) < options.minClients) {
+                poll(100);
+                continue;
+            }
+            started = true;
+            deadline = Clock::now();
+        }
+        Clock::time_point now = Clock::now();
+        if (now < deadline) {
+            // 마감까지 소켓을 기다림 (poll은 ms 단위라 올림: 마감을 최대 1ms 넘길 수 있음)
+            long remaining = static_cast<long>(chrono::duration_cast<chrono::microseconds>(deadline - now).count());
+            poll(static_cast<int>((remaining + 999) / 1000));
+            continue;
+        }
+        // 틱 직전에 도착한 입력까지 받고 나서 틱 시각을 잡음 (대기 시간이 음수가 되지 않게)
+        poll(0);
+        now = Clock::now();
+        runTick(now);
+
+        // 마감을 누적해 나가고, 3틱 넘게 밀리면 현재 시각으로 재설정 (FrameClock과 같은 규칙)
+        chrono::microseconds period(static_cast<long>(tickPeriodMs() * 1000.0));
+        deadline += period;
+        if (now - deadline > period * 3) deadline = now + period;
+    }
+
+    // 마지막 틱 메시지가 나가도록 잠시 비움
+    Clock::time_point drainEnd = Clock::now() + chrono::milliseconds(500);
+    while (Clock::now() < drainEnd) {
+        bool pending = false;
+        for (Client& client : clients) {
+            client.connection->flush();
+            if (client.connection->pendingOutputBytes() > 0 && !client.connection->failed()) pending = true;
+        }
+        if (!pending) break;
+        poll(10);
+    }
+}
+
+void TickServer::poll(int timeoutMs)
+{
+    vector<pollfd> fds;
+    fds.reserve(clients.size() + 1);
+    fds.push_back({listenFd, POLLIN, 0});
+    for (const Client& client : clients) {
+        short events = POLLIN;
+        if (client.connection->pendingOutputBytes() > 0) events |= POLLOUT;
+        fds.push_back({client.connection->fd(), events, 0});
+    }
+    if (::poll(fds.data(), fds.size(), timeoutMs) <= 0) return;
+
+    // 새 클라이언트는 이번 poll 결과에 없으므로 기존 클라이언트부터 처리
+    size_t existing = clients.size();
+    for (size_t i = 0; i < existing; ++i) {
+        short revents = fds[i + 1].revents;
+        if (revents & (POLLIN | POLLHUP | POLLERR)) readClient(i);
+        if (revents & POLLOUT) clients[i].connection->flush();
+    }
+    if (fds[0].revents & POLLIN) acceptClients();
+    dropClosedClients();
+}
+
+void TickServer::acceptClients()
+{
+    int fd;
+    while ((fd = acceptConnection(listenFd)) >= 0) {
+        addClient(fd);
+    }
+}
+
+void TickServer::addClient(int fd)
+{
+    Client client;
+    client.connection.reset(new NetConnection(fd));
+    client.statsIndex = clientStats.size();
+
+    ClientInputStats stats;
+    stats.id = nextClientId++;
+    for (int i = 0; i < arena.size(); ++i) {
+        if (!humanControlled[i]) {
+            humanControlled[i] = 1;
+            stats.snakeIndex = i;
+            break;
+        }
+    }
+    clientStats.push_back(stats);
+
+    vector<uint8_t> welcome;
+    ByteWriter w(welcome);
+    NetProtocol::writeWelcome(w, stats.snakeIndex, arena.getOptions(),
+                              static_cast<uint32_t>(tickPeriodMs() * 1000.0));
+    client.connection->send(NetProtocol::kWelcome, welcome);
+    sendKeyframe(client);
+    clients.push_back(move(client));
+}
+
+void TickServer::sendKeyframe(Client& client)
+{
+    scratch.clear();
+    ByteWriter w(scratch);
+    arena.encodeKeyframe(w);
+    client.connection->send(NetProtocol::kKeyframe, scratch);
+    clientStats[client.statsIndex].bytesSent += static_cast<long>(scratch.size());
+}
+
+void TickServer::readClient(size_t index)
+{
+    Client& client = clients[index];
+    ClientInputStats& stats = clientStats[client.statsIndex];
+    client.connection->receive();
+    uint8_t type;
+    while (client.connection->nextFrame(type, frameBody)) {
+        if (type == NetProtocol::kResync) {
+            stats.resyncs++;
+            sendKeyframe(client);
+            continue;
+        }
+        if (type != NetProtocol::kInput) continue;
+        PendingInput input;
+        try {
+            ByteReader r(frameBody.data(), frameBody.size(), "Client input is truncated");
+            input.sequence = r.u32();
+            input.targetTick = static_cast<long>(r.u64());
+            input.direction = r.u8();
+        } catch (const runtime_error&) {
+            continue;
+        }
+        input.arrival = Clock::now();
+        stats.inputsReceived++;
+        if (stats.snakeIndex < 0 || input.direction < 1 || input.direction > 4) continue;
+        if (client.inputs.size() >= kMaxQueuedInputs) {
+            stats.droppedInputs++;
+            continue;
+        }
+        client.inputs.push_back(input);
+    }
+}
+
+void TickServer::dropClosedClients()
+{
+    for (size_t i = 0; i < clients.size();) {
+        Client& client = clients[i];
+        if (!client.connection->failed()) {
+            ++i;
+            continue;
+        }
+        ClientInputStats& stats = clientStats[client.statsIndex];
+        stats.connected = false;
+        if (stats.snakeIndex >= 0) humanControlled[stats.snakeIndex] = 0;
+        clients.erase(clients.begin() + static_cast<ptrdiff_t>(i));
+    }
+    retireDisconnectedStats();
+}
+
+void TickServer::retireDisconnectedStats()
+{
+    size_t disconnected = 0;
+    for (const ClientInputStats& stats : clientStats) disconnected += !stats.connected;
+    while (disconnected > kMaxRetainedDisconnected) {
+        // 가장 오래된 끊긴 클라이언트를 합계로 접고, 뒤쪽 항목을 가리키던 접속 중 클라이언트의 번호를 당김
+        size_t oldest = 0;
+        while (clientStats[oldest].connected) ++oldest;
+        const ClientInputStats& stats = clientStats[oldest];
+        retiredStats.inputsReceived += stats.inputsReceived;
+        retiredStats.inputsApplied += stats.inputsApplied;
+        retiredStats.lateInputs += stats.lateInputs;
+        retiredStats.maxLateTicks = max(retiredStats.maxLateTicks, stats.maxLateTicks);
+        retiredStats.droppedInputs += stats.droppedInputs;
+        retiredStats.resyncs += stats.resyncs;
+        retiredStats.updatesSent += stats.updatesSent;
+        retiredStats.bytesSent += stats.bytesSent;
+        retiredStats.waitNs.merge(stats.waitNs);
+        retiredClients++;
+        clientStats.erase(clientStats.begin() + static_cast<ptrdiff_t>(oldest));
+        for (Client& client : clients) {
+            if (client.statsIndex > oldest) client.statsIndex--;
+        }
+        disconnected--;
+    }
+}
+
+void TickServer::runTick(Clock::time_point now)
+{
+    long tick = arena.getTickCount() + 1;
+    arena.greedyActions(actions.data());
+    for (Client& client : clients) {
+        ClientInputStats& stats = clientStats[client.statsIndex];
+        client.hasAck = false;
+        if (stats.snakeIndex < 0) continue;
+        actions[stats.snakeIndex] = 0; // 사람이 맡은 스네이크는 입력이 없으면 방향 유지
+        if (client.inputs.empty() || client.inputs.front().targetTick > tick) continue;
+
+        PendingInput input = client.inputs.front();
+        client.inputs.pop_front();
+        actions[stats.snakeIndex] = input.direction;
+        stats.inputsApplied++;
+        long late = tick - input.targetTick;
+        if (late > 0) {
+            stats.lateInputs++;
+            stats.maxLateTicks = max(stats.maxLateTicks, late);
+        }
+        uint64_t waitNs = static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(now - input.arrival).count());
+        stats.waitNs.record(waitNs);
+
+        client.ack.clear();
+        ByteWriter w(client.ack);
+        w.u32(input.sequence);
+        w.u64(static_cast<uint64_t>(input.targetTick));
+        w.u64(static_cast<uint64_t>(tick));
+        w.u32(static_cast<uint32_t>(waitNs / 1000));
+        client.hasAck = true;
+    }
+    arena.step(actions.data());
+
+    // 틱 메시지는 한 번만 만들어 모든 클라이언트에 보냄
+    tickMessage.clear();
+    ByteWriter w(tickMessage);
+    w.u32(arena.stateChecksum());
+    arena.encodeTick(w);
+    for (Client& client : clients) {
+        ClientInputStats& stats = clientStats[client.statsIndex];
+        client.connection->send(NetProtocol::kTick, tickMessage);
+        stats.updatesSent++;
+        stats.bytesSent += static_cast<long>(tickMessage.size());
+        if (client.hasAck) client.connection->send(NetProtocol::kInputAck, client.ack);
+        // 읽지 않는 클라이언트: 버퍼가 끝없이 자라지 않도록 연결을 끊음
+        if (client.connection->pendingOutputBytes() > kMaxPendingOutputBytes) client.connection->abandon();
+    }
+    dropClosedClients();
+}
+
+void TickServer::printStats(ostream& out) const
+{
+    const ArenaStats& stats = arena.getStats();
+    out << "ticks: " << stats.ticks << "\n"
+        << "snakes: " << arena.size() << " (alive " << arena.aliveCount() << ")\n"
+        << "clients: " << static_cast<long>(clientStats.size()) + retiredClients << "\n";
+    auto printCounters = [&out](const ClientInputStats& client) {
+        out << "inputs " << client.inputsReceived << " applied " << client.inputsApplied
+            << " late " << client.lateInputs << " (max " << client.maxLateTicks << " ticks)"
+            << " dropped " << client.droppedInputs << " resyncs " << client.resyncs
+            << " updates " << client.updatesSent << " bytes " << client.bytesSent << "\n"
+            << "  input wait p50/p99/max (us): " << client.waitNs.percentile(0.50) / 1000.0 << " / "
+            << client.waitNs.percentile(0.99) / 1000.0 << " / " << client.waitNs.maximum() / 1000.0 << "\n";
+    };
+    if (retiredClients > 0) {
+        out << "earlier disconnected clients (" << retiredClients << ", combined): ";
+        printCounters(retiredStats);
+    }
+    for (const ClientInputStats& client : clientStats) {
+        out << "client " << client.id << " (snake " << client.snakeIndex
+            << (client.connected ? "" : ", disconnected") << "): ";
+        printCounters(client);
+    }
+}
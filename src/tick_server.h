@@ -0,0 +1,110 @@
+#ifndef TICK_SERVER_H
+#define TICK_SERVER_H
+
+#include "arena.h"
+#include "net_protocol.h"
+#include "tick_profiler.h"
+#include <chrono>
+#include <csignal>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+// 권위 서버: 아레나 시뮬레이션과 틱 루프를 서버만 돌리고 클라이언트는 상태를 복제만 한다 (ncurses 비의존).
+// 접속한 클라이언트는 아직 사람이 맡지 않은 스네이크 중 번호가 가장 작은 것을 맡고 (없으면 관전),
+// 나머지 스네이크는 기본 봇이 조종한다. 연결이 끊기면 그 스네이크는 다시 봇이 맡는다.
+//
+// 입력 처리: 클라이언트는 마지막으로 받은 틱 + 1을 목표 틱으로 적어 보낸다.
+// 서버는 다음 틱을 계산할 때 목표 틱이 그 틱 이하인 입력 중 가장 먼저 온 하나를 적용하고 (Game의 입력 큐처럼
+// 빠른 연속 입력은 다음 틱으로 이어짐), 목표 틱을 이미 계산한 뒤에 도착한 입력은 늦은 입력으로 세어 다음 틱에 적용한다.
+// 틱 사이에는 poll로 소켓을 기다리므로 입력 수신 / 접속 처리가 틱 간격을 늘리지 않는다.
+struct TickServerOptions {
+    ArenaOptions arena;
+    NetAddress address;
+    double tickMs = 0;       // 0이면 아레나 틱 간격 (시간 아이템 반영)
+    long maxTicks = 0;       // 0보다 크면 이 틱 수 뒤 종료
+    int minClients = 0;      // 이 수의 클라이언트가 접속할 때까지 틱을 시작하지 않음
+};
+
+// 클라이언트별 입력 지연 카운터 (연결이 끊겨도 종료 보고용으로 남기되, 끊긴 클라이언트는 최근
+// TickServer::kMaxRetainedDisconnected개만 따로 두고 그보다 오래된 것은 하나의 합계로 접음)
+struct ClientInputStats {
+    int id = 0;
+    int snakeIndex = -1;
+    long inputsReceived = 0;
+    long inputsApplied = 0;
+    long lateInputs = 0;       // 목표 틱이 지난 뒤 적용된 입력
+    long maxLateTicks = 0;
+    long droppedInputs = 0;    // 대기 중인 입력이 너무 많아 버린 입력
+    long resyncs = 0;
+    long updatesSent = 0;
+    long bytesSent = 0;
+    LatencyHistogram waitNs;   // 도착부터 적용(틱 계산)까지 (ns)
+    bool connected = true;
+};
+
+class TickServer
+{
+public:
+    // 클라이언트마다 쌓아 둘 최대 입력 수와 보내지 못한 출력 한도 (넘으면 느린 클라이언트로 보고 연결을 끊음)
+    static const size_t kMaxQueuedInputs = 8;
+    static const size_t kMaxPendingOutputBytes = 8u << 20;
+    // 따로 보관할 끊긴 클라이언트 통계 수 (접속이 끝없이 반복돼도 통계 메모리가 자라지 않음)
+    static const size_t kMaxRetainedDisconnected = 32;
+
+    explicit TickServer(const TickServerOptions& options);
+    ~TickServer();
+    TickServer(const TickServer&) = delete;
+    TickServer& operator=(const TickServer&) = delete;
+
+    // stopFlag가 0이 아니게 되거나 maxTicks에 도달할 때까지 진행
+    void run(const volatile sig_atomic_t* stopFlag);
+    const Arena& getArena() const { return arena; }
+    void printStats(ostream& out) const;
+
+private:
+    using Clock = chrono::steady_clock;
+
+    struct PendingInput {
+        uint32_t sequence;
+        long targetTick;
+        uint8_t direction;
+        Clock::time_point arrival;
+    };
+    struct Client {
+        unique_ptr<NetConnection> connection;
+        deque<PendingInput> inputs;
+        size_t statsIndex;
+        bool hasAck = false;         // 이번 틱에 적용한 입력의 확인 (틱 메시지 뒤에 보냄)
+        vector<uint8_t> ack;
+    };
+
+    TickServerOptions options;
+    Arena arena;
+    int listenFd = -1;
+    vector<Client> clients;
+    vector<ClientInputStats> clientStats;
+    ClientInputStats retiredStats;   // 접힌 끊긴 클라이언트들의 합계
+    long retiredClients = 0;
+    vector<unsigned char> humanControlled; // 스네이크별로 클라이언트가 맡았는지 (아니면 봇)
+    vector<int> actions;
+    vector<uint8_t> tickMessage;     // 매 틱 다시 쓰는 공용 버퍼
+    vector<uint8_t> scratch;
+    vector<uint8_t> frameBody;
+    int nextClientId = 1;
+
+    double tickPeriodMs() const { return options.tickMs > 0 ? options.tickMs : arena.getTickPeriodMs(); }
+    void poll(int timeoutMs);
+    void acceptClients();
+    void addClient(int fd);
+    void readClient(size_t index);
+    void dropClosedClients();
+    void retireDisconnectedStats();
+    void sendKeyframe(Client& client);
+    void runTick(Clock::time_point now);
+};
+
+#endif
@@ -0,0 +1,58 @@
+// 스테이지 컴파일러: 텍스트 스테이지(.stage)들을 하나의 스테이지 팩(.stgp)으로 변환
+//   mapc -o stages.stgp 01_basic.stage 02_spiral.stage ...   (인자 순서 = 스테이지 순서)
+//   mapc --list stages.stgp                                    (팩 내용 확인)
+#include "stage_pack.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+static void printUsage(const char* program)
+{
+    cerr << "Usage: " << program << " -o OUT.stgp STAGE_FILE...\n"
+         << "       " << program << " --list PACK.stgp\n";
+}
+
+static int listPack(const string& path)
+{
+    StagePack pack(path);
+    for (int i = 0; i < pack.size(); ++i) {
+        const StageHeader& header = *pack.stage(i).header;
+        cout << i + 1 << ": " << pack.stageName(i) << "  " << header.height << "x" << header.width
+             << "  missions " << header.snakeLength << " " << header.growthItems << " "
+             << header.poisonItems << " " << header.gateUses
+             << "  delay " << header.tickDelay << "ms"
+             << "  walls " << header.regularWallCount << "+" << header.immuneWallCount
+             << "  gate hints " << header.gateHintCount << "\n";
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    try {
+        if (argc == 3 && strcmp(argv[1], "--list") == 0) {
+            return listPack(argv[2]);
+        }
+        if (argc < 4 || strcmp(argv[1], "-o") != 0) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        string outputPath = argv[2];
+        vector<StageSource> stages;
+        for (int i = 3; i < argc; ++i) {
+            ifstream in(argv[i]);
+            if (!in) throw runtime_error(string("Cannot open stage file: ") + argv[i]);
+            stages.push_back(parseStageText(in, argv[i]));
+        }
+        writeStagePack(outputPath, stages);
+        // 쓴 팩을 다시 열어 검증
+        StagePack pack(outputPath);
+        cout << "Wrote " << pack.size() << " stages to " << outputPath << "\n";
+    } catch (const exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
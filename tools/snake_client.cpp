@@ -0,0 +1,294 @@
+// 아레나 틱 서버(snake_server)의 터미널 클라이언트: 서버가 보낸 키프레임 / 틱 변화분을 Arena 복제본에 적용해
+// 아레나 화면(arena_view.h)으로 그리고, 방향키 입력을 서버로 보낸다. 시뮬레이션은 서버만 진행한다.
+//   snake_client --connect unix:/tmp/snake.sock             (방향키로 플레이)
+//   snake_client --connect tcp:7777 --bot --ticks 1000      (터미널 없이 기본 봇으로 플레이하고 지연 통계 출력)
+// 매 틱 서버의 상태 요약값과 복제본을 비교해 어긋나면 키프레임을 다시 요청한다.
+#include "arena_view.h"
+#include "net_protocol.h"
+#include "tick_profiler.h"
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <poll.h>
+
+using namespace std;
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void handleStopSignal(int)
+{
+    stopRequested = 1;
+}
+
+static void printUsage(const char* program)
+{
+    cerr << "Usage: " << program << " --connect ADDR [options]\n"
+         << "  --connect ADDR      unix:PATH 또는 tcp:[HOST:]PORT\n"
+         << "  --bot               터미널 없이 기본 봇으로 입력 (종료 시 통계 출력)\n"
+         << "  --ticks N           틱 N개를 받으면 종료\n";
+}
+
+// 서버 연결과 Arena 복제본, 입력 왕복 지연 카운터
+class ClientSession
+{
+public:
+    static const int kHandshakeTimeoutMs = 5000;
+
+    explicit ClientSession(const NetAddress& address) : connection(connectTo(address)) {
+        // 환영 메시지로 아레나 옵션을 받아 같은 맵의 복제본을 만들고, 이어지는 키프레임으로 상태를 맞춤
+        vector<uint8_t> body = waitFor(NetProtocol::kWelcome);
+        ByteReader r(body.data(), body.size(), "Server message is truncated");
+        ArenaOptions options;
+        NetProtocol::readWelcome(r, slot, options, tickMicros);
+        mirror.reset(new Arena(options));
+        body = waitFor(NetProtocol::kKeyframe);
+        ByteReader keyframe(body.data(), body.size(), "Server message is truncated");
+        mirror->applyKeyframe(keyframe);
+    }
+
+    Arena& arena() { return *mirror; }
+    int controlledSnake() const { return slot; }
+    int fd() const { return connection.fd(); }
+    bool closed() const { return connection.failed(); }
+    long updates() const { return updatesReceived; }
+
+    // 받은 프레임을 모두 처리하고 틱을 하나 이상 적용했으면 true
+    bool receive() {
+        connection.receive();
+        bool ticked = false;
+        uint8_t type;
+        while (connection.nextFrame(type, body)) {
+            ByteReader r(body.data(), body.size(), "Server message is truncated");
+            if (type == NetProtocol::kTick) {
+                ticked = applyTick(r) || ticked;
+            } else if (type == NetProtocol::kKeyframe) {
+                mirror->applyKeyframe(r);
+                awaitingKeyframe = false;
+                ticked = true;
+            } else if (type == NetProtocol::kInputAck) {
+                applyAck(r);
+            }
+        }
+        return ticked;
+    }
+
+    // 방향 입력을 다음 틱 목표로 보냄 (관전 중이면 무시)
+    void sendInput(int direction) {
+        if (slot < 0 || direction < 1 || direction > 4) return;
+        vector<uint8_t> input;
+        ByteWriter w(input);
+        w.u32(nextSequence);
+        w.u64(static_cast<uint64_t>(mirror->getTickCount() + 1));
+        w.u8(static_cast<uint8_t>(direction));
+        connection.send(NetProtocol::kInput, input);
+        inFlight.push_back({nextSequence, direction, Clock::now()});
+        nextSequence++;
+        inputsSent++;
+    }
+
+    // 기본 봇: 방향을 바꿔야 할 때만 입력을 보냄 (같은 방향이 이미 가는 중이면 다시 보내지 않음)
+    void botInput() {
+        if (slot < 0 || awaitingKeyframe || !mirror->snake(slot).alive) return;
+        int direction = mirror->greedyDirection(slot);
+        if (direction == 0 || direction == mirror->snake(slot).direction) return;
+        if (!inFlight.empty() && inFlight.back().direction == direction) return;
+        sendInput(direction);
+    }
+
+    string statusLine() const {
+        char line[64];
+        snprintf(line, sizeof(line), "Net rtt p50 %.1fms  desync %ld", roundTrip.percentile(0.50) / 1e6, desyncs);
+        return line;
+    }
+
+    void printStats(ostream& out) const {
+        out << "snake: " << slot << " (server tick " << tickMicros / 1000.0 << " ms)\n"
+            << "updates: " << updatesReceived << " (tick " << mirror->getTickCount() << ")\n"
+            << "desyncs: " << desyncs << "\n"
+            << "inputs sent/acked: " << inputsSent << " / " << roundTrip.count() << "\n"
+            << "late inputs: " << lateInputs << " (max " << maxLateTicks << " ticks)\n"
+            << "input rtt p50/p99/max (us): " << roundTrip.percentile(0.50) / 1000.0 << " / "
+            << roundTrip.percentile(0.99) / 1000.0 << " / " << roundTrip.maximum() / 1000.0 << "\n"
+            << "server wait p50/p99/max (us): " << serverWait.percentile(0.50) / 1000.0 << " / "
+            << serverWait.percentile(0.99) / 1000.0 << " / " << serverWait.maximum() / 1000.0 << "\n";
+    }
+
+private:
+    using Clock = chrono::steady_clock;
+
+    struct SentInput {
+        uint32_t sequence;
+        int direction;
+        Clock::time_point sentAt;
+    };
+
+    NetConnection connection;
+    unique_ptr<Arena> mirror;
+    int slot = -1;
+    uint32_t tickMicros = 0;
+    vector<uint8_t> body;
+    deque<SentInput> inFlight;   // 확인을 기다리는 입력 (보낸 순서)
+    uint32_t nextSequence = 1;
+    bool awaitingKeyframe = false;
+    long updatesReceived = 0;
+    long desyncs = 0;
+    long inputsSent = 0;
+    long lateInputs = 0;
+    long maxLateTicks = 0;
+    LatencyHistogram roundTrip;  // 입력을 보내고 확인을 받기까지 (ns)
+    LatencyHistogram serverWait; // 서버가 입력을 받아 적용하기까지 (ns, 서버가 us 단위로 보냄)
+
+    vector<uint8_t> waitFor(uint8_t expected) {
+        Clock::time_point deadline = Clock::now() + chrono::milliseconds(static_cast<int>(kHandshakeTimeoutMs));
+        uint8_t type;
+        vector<uint8_t> frame;
+        while (true) {
+            connection.receive();
+            while (connection.nextFrame(type, frame)) {
+                if (type == expected) return frame;
+            }
+            if (connection.failed()) throw runtime_error("Server closed the connection");
+            int remaining = static_cast<int>(
+                chrono::duration_cast<chrono::milliseconds>(deadline - Clock::now()).count());
+            if (remaining <= 0) throw runtime_error("Timed out waiting for the server");
+            pollfd pfd = {connection.fd(), POLLIN, 0};
+            ::poll(&pfd, 1, remaining);
+        }
+    }
+
+    bool applyTick(ByteReader& r) {
+        updatesReceived++;
+        if (awaitingKeyframe) return false; // 키프레임이 올 때까지 버림
+        uint32_t checksum = r.u32();
+        bool matched;
+        try {
+            mirror->applyTick(r);
+            matched = mirror->stateChecksum() == checksum;
+        } catch (const runtime_error&) {
+            matched = false;
+        }
+        if (!matched) {
+            desyncs++;
+            awaitingKeyframe = true;
+            connection.send(NetProtocol::kResync, vector<uint8_t>());
+        }
+        return matched;
+    }
+
+    void applyAck(ByteReader& r) {
+        uint32_t sequence = r.u32();
+        long target = static_cast<long>(r.u64());
+        long applied = static_cast<long>(r.u64());
+        serverWait.record(static_cast<uint64_t>(r.u32()) * 1000);
+        if (applied > target) {
+            lateInputs++;
+            maxLateTicks = max(maxLateTicks, applied - target);
+        }
+        while (!inFlight.empty() && inFlight.front().sequence != sequence) {
+            inFlight.pop_front(); // 서버가 버린 입력
+        }
+        if (inFlight.empty()) return;
+        roundTrip.record(static_cast<uint64_t>(
+            chrono::duration_cast<chrono::nanoseconds>(Clock::now() - inFlight.front().sentAt).count()));
+        inFlight.pop_front();
+    }
+};
+
+// 봇 모드: 틱을 받을 때마다 기본 봇 방향을 보냄 (접속 중에 이미 받아 둔 프레임이 있을 수 있어 먼저 처리)
+static void runBot(ClientSession& session, long maxUpdates)
+{
+    while (!stopRequested && !session.closed() && (maxUpdates <= 0 || session.updates() < maxUpdates)) {
+        if (session.receive()) session.botInput();
+        pollfd pfd = {session.fd(), POLLIN, 0};
+        ::poll(&pfd, 1, 1000);
+    }
+}
+
+// 화면 모드: 소켓과 키보드를 번갈아 확인하며 틱을 받을 때마다 다시 그림
+static void runScreen(ClientSession& session, long maxUpdates)
+{
+    if (!initscr()) throw runtime_error("Failed to initialize ncurses");
+    raw();
+    noecho();
+    curs_set(0);
+    ArenaScreen screen(session.arena(), session.controlledSnake());
+    screen.begin();
+    screen.draw();
+    try {
+        while (!stopRequested && !session.closed() && (maxUpdates <= 0 || session.updates() < maxUpdates)) {
+            pollfd pfd = {session.fd(), POLLIN, 0};
+            ::poll(&pfd, 1, 10);
+            bool redraw = false;
+            int key;
+            bool quit = false;
+            while ((key = getch()) != ERR) {
+                if (key == 'p' || key == 'P') continue; // 서버가 틱을 진행하므로 일시 정지 없음
+                if (!screen.handleKey(key)) quit = true;
+                redraw = true;
+            }
+            if (quit) break;
+            session.sendInput(screen.takeAction());
+            redraw = session.receive() || redraw;
+            if (redraw) {
+                screen.setStatusLine(session.statusLine());
+                screen.draw();
+            }
+        }
+    } catch (...) {
+        endwin();
+        throw;
+    }
+    endwin();
+}
+
+int main(int argc, char* argv[])
+{
+    NetAddress address;
+    bool hasAddress = false;
+    bool bot = false;
+    long maxUpdates = 0;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            bool hasValue = (i + 1 < argc);
+            if (strcmp(arg, "--connect") == 0 && hasValue) {
+                address = parseNetAddress(argv[++i]);
+                hasAddress = true;
+            } else if (strcmp(arg, "--bot") == 0) {
+                bot = true;
+            } else if (strcmp(arg, "--ticks") == 0 && hasValue) {
+                maxUpdates = atol(argv[++i]);
+            } else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        if (!hasAddress) {
+            printUsage(argv[0]);
+            return 1;
+        }
+
+        struct sigaction action = {};
+        action.sa_handler = handleStopSignal;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGINT, &action, nullptr);
+        sigaction(SIGTERM, &action, nullptr);
+
+        ClientSession session(address);
+        if (bot) {
+            runBot(session, maxUpdates);
+        } else {
+            runScreen(session, maxUpdates);
+        }
+        session.printStats(cout);
+    } catch (const exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
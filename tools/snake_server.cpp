@@ -0,0 +1,93 @@
+// 아레나 틱 서버: 시뮬레이션과 틱 루프를 이 프로세스만 돌리고, 접속한 snake_client들에게 매 틱 상태를 보냄
+//   snake_server --listen unix:/tmp/snake.sock --arena 8
+//   snake_server --listen tcp:7777 --arena 2 --min-clients 2 --ticks 3000
+// 종료(SIGINT / SIGTERM 또는 --ticks 도달) 시 클라이언트별 입력 지연 카운터를 출력한다.
+#include "tick_server.h"
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void handleStopSignal(int)
+{
+    stopRequested = 1;
+}
+
+static void printUsage(const char* program)
+{
+    cerr << "Usage: " << program << " --listen ADDR [options]\n"
+         << "  --listen ADDR       unix:PATH 또는 tcp:[HOST:]PORT (기본 호스트 127.0.0.1)\n"
+         << "  --arena N           스네이크 수 (기본 16, 1~65536, 접속 순서대로 0번부터 사람이 맡고 나머지는 봇)\n"
+         << "  --board HxW         보드 크기 (기본 21x41, 각 변 10~16384)\n"
+         << "  --stage S           내장 스테이지 벽 배치 (1~4)\n"
+         << "  --procedural D      벽 밀도 D%(1~40)의 절차적 맵\n"
+         << "  --seed S            난수 시드\n"
+         << "  --tick-ms MS        고정 틱 간격 (기본: 아레나 속도를 따름)\n"
+         << "  --ticks N           N틱 뒤 종료\n"
+         << "  --min-clients N     N개 클라이언트가 접속할 때까지 대기 후 시작\n";
+}
+
+int main(int argc, char* argv[])
+{
+    TickServerOptions options;
+    bool hasAddress = false;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            bool hasValue = (i + 1 < argc);
+            if (strcmp(arg, "--listen") == 0 && hasValue) {
+                options.address = parseNetAddress(argv[++i]);
+                hasAddress = true;
+            } else if (strcmp(arg, "--arena") == 0 && hasValue) {
+                options.arena.snakeCount = atoi(argv[++i]);
+            } else if (strcmp(arg, "--board") == 0 && hasValue) {
+                if (sscanf(argv[++i], "%dx%d", &options.arena.boardHeight, &options.arena.boardWidth) != 2) {
+                    throw invalid_argument("Board size must look like HxW (e.g. 21x41)");
+                }
+            } else if (strcmp(arg, "--stage") == 0 && hasValue) {
+                options.arena.stage = atoi(argv[++i]);
+            } else if (strcmp(arg, "--procedural") == 0 && hasValue) {
+                options.arena.wallDensity = atoi(argv[++i]);
+            } else if (strcmp(arg, "--seed") == 0 && hasValue) {
+                options.arena.seed = strtoull(argv[++i], nullptr, 0);
+            } else if (strcmp(arg, "--tick-ms") == 0 && hasValue) {
+                options.tickMs = atof(argv[++i]);
+            } else if (strcmp(arg, "--ticks") == 0 && hasValue) {
+                options.maxTicks = atol(argv[++i]);
+            } else if (strcmp(arg, "--min-clients") == 0 && hasValue) {
+                options.minClients = atoi(argv[++i]);
+            } else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        if (!hasAddress) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        // 소켓을 열기 전에 main과 같은 범위로 검사 (잘못된 값은 invalid_argument로 아래에서 출력)
+        Arena::validateOptions(options.arena);
+
+        struct sigaction action = {};
+        action.sa_handler = handleStopSignal;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGINT, &action, nullptr);
+        sigaction(SIGTERM, &action, nullptr);
+
+        TickServer server(options);
+        cout << "Listening on " << options.address.toString() << " (" << server.getArena().size()
+             << " snakes, " << server.getArena().getMap().mapSize.height << "x"
+             << server.getArena().getMap().mapSize.width << ")" << endl;
+        server.run(&stopRequested);
+        server.printStats(cout);
+    } catch (const exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}